@@ -0,0 +1,63 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <memory>
+#include <vector>
+
+// 1024 complex forward transforms per call: a loop over performCfftForward
+// against the batched entry points, for contiguous rows and for interleaved
+// channels (stride = batch size, distance = 1).
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::size_t howMany = 1024;
+    std::printf("%-8s %8s %12s %12s %12s %14s\n", precision, "nfft",
+                "loop us", "batch us", "plan us", "plan chan. us");
+    for (std::size_t nfft = 16; nfft <= 1024; nfft *= 4) {
+        std::vector<C> in(nfft * howMany, C(1, -1));
+        std::vector<C> out(nfft * howMany);
+        std::vector<C> scratch(nfft);
+        auto twiddleFactors = std::make_unique<C[]>(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<T>(
+            nfft, twiddleFactors.get(), nfft);
+        splitradixfft::Plan<T> plan;
+        splitradixfft::createPlan<T>(nfft,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::FORWARD, plan);
+
+        double loop = benchmark::nanosecondsPerCall([&]() {
+            for (std::size_t b = 0; b < howMany; b++) {
+                splitradixfft::performCfftForward<T>(
+                    nfft, twiddleFactors.get(), nfft, in.data() + b * nfft,
+                    nfft, out.data() + b * nfft, nfft);
+            }
+            benchmark::doNotOptimize(out[0]);
+        });
+        double batch = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::performCfftForwardBatch<T>(
+                nfft, twiddleFactors.get(), nfft, howMany, in.data(), 1, nfft,
+                out.data(), 1, nfft, scratch.data(), nfft);
+            benchmark::doNotOptimize(out[0]);
+        });
+        double planned = benchmark::nanosecondsPerCall([&]() {
+            plan.executeBatch(howMany, in.data(), 1, nfft, out.data(), 1,
+                              nfft, scratch.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        double channels = benchmark::nanosecondsPerCall([&]() {
+            plan.executeBatch(howMany, in.data(), howMany, 1, out.data(),
+                              howMany, 1, scratch.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %8zu %12.1f %12.1f %12.1f %14.1f\n", "", nfft,
+                    loop * 1e-3, batch * 1e-3, planned * 1e-3,
+                    channels * 1e-3);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
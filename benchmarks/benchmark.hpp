@@ -0,0 +1,47 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+// Minimal timing helpers shared by the benchmarks. The benchmarks only depend
+// on the standard library so they build wherever the library does.
+namespace benchmark {
+
+// Best-of-rounds average wall time of one call of f in nanoseconds. Each round
+// runs f until at least minSeconds have passed.
+template <typename F>
+double nanosecondsPerCall(F&& f, double minSeconds = 0.05, int rounds = 3)
+{
+    using Clock = std::chrono::steady_clock;
+    f(); // Warm up caches and lazily initialized state.
+    double best{-1};
+    for (int round = 0; round < rounds; round++) {
+        std::size_t calls{0};
+        auto start = Clock::now();
+        double elapsed{0};
+        do {
+            f();
+            calls++;
+            elapsed =
+                std::chrono::duration<double>(Clock::now() - start).count();
+        } while (elapsed < minSeconds);
+        double perCall = elapsed * 1e9 / (double)calls;
+        best = best < 0 ? perCall : std::min(best, perCall);
+    }
+    return best;
+}
+
+// Keep the optimizer from removing the benchmarked work.
+template <typename T>
+inline void doNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace benchmark
@@ -0,0 +1,88 @@
+#include "benchmark.hpp"
+#include "splitradixfft_convolution.hpp"
+#include <algorithm>
+#include <vector>
+
+// FIR filtering of a stream in chunks of 256 values. "by hand" is overlap-save
+// with the functions of splitradixfft.hpp as it is commonly written: every
+// block allocates its buffers, transforms the zero padded filter again and
+// multiplies with std::complex. "convolver" is Convolver, which transforms the
+// filter once. Both use the fft size Convolver selects, the times are per
+// input value.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::size_t length = (std::size_t)1 << 16;
+    const std::size_t chunk = 256;
+    std::printf("%-8s %8s %8s %14s %14s %8s\n", precision, "kernel", "nfft",
+                "by hand ns", "convolver ns", "speedup");
+    for (std::size_t kernelSize = 16; kernelSize <= 8192; kernelSize *= 4) {
+        std::vector<T> kernel(kernelSize, T(1) / (T)kernelSize);
+        std::vector<T> in(length, T(1));
+        std::vector<T> out(length);
+        splitradixfft::Convolver<T> convolver;
+        splitradixfft::createConvolver<T>(kernel.data(), kernelSize,
+                                          convolver);
+        const std::size_t nfft = convolver.fftSize();
+        const std::size_t block = convolver.blockSize();
+        std::vector<C> forwardTwiddles(nfft);
+        std::vector<C> backwardTwiddles(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<T>(
+            nfft, forwardTwiddles.data(), nfft);
+        splitradixfft::populateRfftTwiddleFactorsBackward<T>(
+            nfft, backwardTwiddles.data(), nfft);
+
+        double byHand = benchmark::nanosecondsPerCall([&]() {
+            std::vector<T> window(nfft);
+            for (std::size_t begin = 0; begin + block <= length;
+                 begin += block) {
+                std::copy(window.begin() + block, window.end(),
+                          window.begin());
+                std::copy(in.begin() + begin, in.begin() + begin + block,
+                          window.begin() + kernelSize - 1);
+                std::vector<T> padded(nfft);
+                std::copy(kernel.begin(), kernel.end(), padded.begin());
+                std::vector<C> filter(nfft / 2 + 1);
+                std::vector<C> spectrum(nfft / 2 + 1);
+                splitradixfft::performRfftForward<T>(
+                    nfft, forwardTwiddles.data(), nfft, padded.data(), nfft,
+                    filter.data(), nfft / 2 + 1);
+                splitradixfft::performRfftForward<T>(
+                    nfft, forwardTwiddles.data(), nfft, window.data(), nfft,
+                    spectrum.data(), nfft / 2 + 1);
+                for (std::size_t k = 0; k < nfft / 2 + 1; k++) {
+                    spectrum[k] *= filter[k];
+                }
+                std::vector<C> scratch0(nfft / 2 + 1);
+                std::vector<C> scratch1(nfft / 2 + 1);
+                std::vector<T> result(nfft);
+                splitradixfft::performRfftBackward<T>(
+                    nfft, backwardTwiddles.data(), nfft, spectrum.data(),
+                    nfft / 2 + 1, result.data(), nfft, scratch0.data(),
+                    scratch1.data(), nfft / 2 + 1,
+                    splitradixfft::Normalization::BY_SIZE);
+                std::copy(result.begin() + kernelSize - 1, result.end(),
+                          out.begin() + begin);
+            }
+            benchmark::doNotOptimize(out[0]);
+        });
+        double cached = benchmark::nanosecondsPerCall([&]() {
+            for (std::size_t begin = 0; begin < length; begin += chunk) {
+                convolver.process(in.data() + begin, out.data() + begin,
+                                  chunk);
+            }
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %8zu %8zu %14.2f %14.2f %8.2f\n", "", kernelSize,
+                    nfft, byHand / (double)length, cached / (double)length,
+                    byHand / cached);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "benchmark.hpp"
+#include "splitradixfft_fixed.hpp"
+#include "splitradixfft_plan.hpp"
+#include <vector>
+
+// FixedFft against a plan of the same size for the complex forward transform.
+template <typename T, std::size_t N>
+void runSize()
+{
+    std::vector<std::complex<T>> in(N, std::complex<T>(1, -1));
+    std::vector<std::complex<T>> out(N);
+    splitradixfft::Plan<T> plan;
+    splitradixfft::createPlan<T>(N, splitradixfft::TransformType::COMPLEX,
+                                 splitradixfft::Direction::FORWARD, plan);
+
+    double planned = benchmark::nanosecondsPerCall([&]() {
+        plan.execute(in.data(), out.data());
+        benchmark::doNotOptimize(out[0]);
+    });
+    double fixed = benchmark::nanosecondsPerCall([&]() {
+        splitradixfft::FixedFft<T, N, splitradixfft::Direction::FORWARD>::
+            execute(in.data(), out.data());
+        benchmark::doNotOptimize(out[0]);
+    });
+    std::printf("%-8s %10zu %14.0f %14.0f %8.2f\n", "", N, planned, fixed,
+                planned / fixed);
+}
+
+template <typename T>
+void run(const char* precision)
+{
+    std::printf("%-8s %10s %14s %14s %8s\n", precision, "nfft", "plan ns",
+                "fixed ns", "speedup");
+    runSize<T, 16>();
+    runSize<T, 32>();
+    runSize<T, 64>();
+    runSize<T, 128>();
+    runSize<T, 256>();
+    runSize<T, 512>();
+    runSize<T, 1024>();
+    runSize<T, 4096>();
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -0,0 +1,48 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <cstdint>
+#include <vector>
+
+// Complex forward plans forced to the depth-first recursion and to the
+// four-step algorithm. The size where the ratio crosses 1 is the one to pass
+// as fourStepThreshold on the target machine, it depends on the size of the
+// last level cache.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    std::printf("%-8s %9s %10s %14s %14s %8s\n", precision, "nfft", "MiB",
+                "recursion us", "four-step us", "ratio");
+    for (std::size_t nfft = (std::size_t)1 << 14;
+         nfft <= ((std::size_t)1 << 24); nfft *= 2) {
+        std::vector<C> in(nfft, C(1, -1));
+        std::vector<C> out(nfft);
+        splitradixfft::Plan<T> recursive;
+        splitradixfft::Plan<T> fourStep;
+        splitradixfft::createPlan<T>(
+            nfft, splitradixfft::TransformType::COMPLEX,
+            splitradixfft::Direction::FORWARD, recursive, SIZE_MAX);
+        splitradixfft::createPlan<T>(nfft,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::FORWARD,
+                                     fourStep, 0);
+        double depthFirst = benchmark::nanosecondsPerCall([&]() {
+            recursive.execute(in.data(), out.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        double blocked = benchmark::nanosecondsPerCall([&]() {
+            fourStep.execute(in.data(), out.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %9zu %10.1f %14.1f %14.1f %8.2f\n", "", nfft,
+                    (double)(nfft * sizeof(C)) / (1 << 20), depthFirst * 1e-3,
+                    blocked * 1e-3, depthFirst / blocked);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
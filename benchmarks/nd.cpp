@@ -0,0 +1,120 @@
+#include "benchmark.hpp"
+#include "splitradixfft_nd.hpp"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// Complex forward transforms of 2D and 3D arrays. "strided" runs one batch of
+// contiguous rows and one batch of strided columns per axis through the plan
+// of that axis, "blocked" is PlanND, which moves blocks of columns through
+// tiles, alone and with a pool of all cores. "real" is the real forward PlanND
+// of the same shape.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::vector<std::vector<std::size_t>> shapes = {
+        {512, 512}, {2048, 2048}, {4096, 4096}, {256, 256, 256}};
+    splitradixfft::ThreadPool pool;
+    std::printf("%-8s %16s %12s %12s %8s %12s %12s\n", precision, "shape",
+                "strided us", "blocked us", "speedup", "threads us",
+                "real us");
+    for (const auto& dims : shapes) {
+        const std::size_t rank = dims.size();
+        std::size_t total = 1;
+        for (std::size_t n : dims) {
+            total *= n;
+        }
+        std::vector<C> in(total, C(1, -1));
+        std::vector<C> out(total);
+        std::vector<C> tmp(total);
+        std::vector<T> real(total, T(1));
+        std::vector<splitradixfft::Plan<T>> axes(rank);
+        for (std::size_t a = 0; a < rank; a++) {
+            splitradixfft::createPlan<T>(
+                dims[a], splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD, axes[a]);
+        }
+        splitradixfft::PlanND<T> plan;
+        splitradixfft::PlanND<T> realPlan;
+        if (rank == 2) {
+            splitradixfft::createPlan2D<T>(
+                dims[0], dims[1], splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD, plan);
+            splitradixfft::createPlan2D<T>(
+                dims[0], dims[1], splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::FORWARD, realPlan);
+        } else {
+            splitradixfft::createPlan3D<T>(
+                dims[0], dims[1], dims[2],
+                splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD, plan);
+            splitradixfft::createPlan3D<T>(
+                dims[0], dims[1], dims[2], splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::FORWARD, realPlan);
+        }
+        std::vector<C> scratch(*std::max_element(dims.begin(), dims.end()));
+        std::vector<C> spectrum(realPlan.complexSize());
+
+        // The large arrays take a second or more per call, a single call per
+        // round is enough.
+        const double seconds = 0.05;
+        double strided = benchmark::nanosecondsPerCall(
+            [&]() {
+                const std::size_t last = dims[rank - 1];
+                axes[rank - 1].executeBatch(total / last, in.data(), 1, last,
+                                            out.data(), 1, last,
+                                            scratch.data());
+                C* src = out.data();
+                C* dst = tmp.data();
+                std::size_t inner = last;
+                for (std::size_t a = rank - 1; a-- > 0;) {
+                    const std::size_t n = dims[a];
+                    for (std::size_t o = 0; o < total / (n * inner); o++) {
+                        axes[a].executeBatch(inner, src + o * n * inner, inner,
+                                             1, dst + o * n * inner, inner, 1,
+                                             scratch.data());
+                    }
+                    std::swap(src, dst);
+                    inner *= n;
+                }
+                benchmark::doNotOptimize(src[0]);
+            },
+            seconds, 1);
+        double blocked = benchmark::nanosecondsPerCall(
+            [&]() {
+                plan.execute(in.data(), out.data());
+                benchmark::doNotOptimize(out[0]);
+            },
+            seconds, 1);
+        double threaded = benchmark::nanosecondsPerCall(
+            [&]() {
+                plan.execute(in.data(), out.data(), pool);
+                benchmark::doNotOptimize(out[0]);
+            },
+            seconds, 1);
+        double realForward = benchmark::nanosecondsPerCall(
+            [&]() {
+                realPlan.execute(real.data(), spectrum.data());
+                benchmark::doNotOptimize(spectrum[0]);
+            },
+            seconds, 1);
+        char shape[32];
+        if (rank == 2) {
+            std::snprintf(shape, sizeof(shape), "%zux%zu", dims[0], dims[1]);
+        } else {
+            std::snprintf(shape, sizeof(shape), "%zux%zux%zu", dims[0],
+                          dims[1], dims[2]);
+        }
+        std::printf("%-8s %16s %12.0f %12.0f %8.2f %12.0f %12.0f\n", "", shape,
+                    strided * 1e-3, blocked * 1e-3, strided / blocked,
+                    threaded * 1e-3, realForward * 1e-3);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
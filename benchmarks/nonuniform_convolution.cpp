@@ -0,0 +1,88 @@
+#include "benchmark.hpp"
+#include "splitradixfft_convolution.hpp"
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+// CPU load of convolving with impulse responses of 0.25 to 10 s at 48 kHz in
+// blocks of 32 values: the uniformly partitioned convolver against the
+// non-uniform one, which runs its larger partitions inline or on a pool of
+// all cores. The load is the mean time per block as a share of the block
+// duration, "peak" the longest block of the pooled convolver, which bounds
+// the time the caller waits.
+template <typename T, typename F>
+static void timeBlocks(std::size_t calls, F&& f, double& mean, double& peak)
+{
+    using Clock = std::chrono::steady_clock;
+    f(); // Warm up caches and lazily initialized state.
+    double total = 0;
+    peak = 0;
+    for (std::size_t call = 0; call < calls; call++) {
+        auto start = Clock::now();
+        f();
+        double ns =
+            std::chrono::duration<double, std::nano>(Clock::now() - start)
+                .count();
+        total += ns;
+        peak = std::max(peak, ns);
+    }
+    mean = total / (double)calls;
+}
+
+template <typename T>
+void run(const char* precision)
+{
+    const std::size_t sampleRate = 48000;
+    const std::size_t blockSize = 32;
+    const double blockNs = 1e9 * (double)blockSize / (double)sampleRate;
+    // Two cycles of the largest partitions.
+    const std::size_t calls =
+        4 * splitradixfft::internal::defaultMaximumPartition / blockSize;
+    splitradixfft::ThreadPool pool;
+    std::printf("%-8s %6s %9s %11s %14s %12s %10s\n", precision, "IR s",
+                "segments", "uniform %", "non-uniform %", "pooled %",
+                "peak us");
+    for (double seconds : {0.25, 0.5, 1.0, 2.0, 5.0, 10.0}) {
+        const std::size_t responseSize =
+            (std::size_t)(seconds * (double)sampleRate);
+        std::vector<T> response(responseSize, T(1) / (T)responseSize);
+        const T* responses[] = {response.data()};
+        std::vector<T> block(blockSize, T(1));
+        T* io[] = {block.data()};
+        splitradixfft::PartitionedConvolver<T> uniform;
+        splitradixfft::NonUniformConvolver<T> serial;
+        splitradixfft::NonUniformConvolver<T> pooled;
+        splitradixfft::createPartitionedConvolver<T>(
+            responses, responseSize, 1, blockSize, uniform);
+        splitradixfft::createNonUniformConvolver<T>(
+            response.data(), responseSize, blockSize, serial);
+        splitradixfft::createNonUniformConvolver<T>(
+            response.data(), responseSize, blockSize, pooled, 0, &pool);
+
+        double uniformMean = 0;
+        double inlineMean = 0;
+        double pooledMean = 0;
+        double peak = 0;
+        timeBlocks<T>(
+            calls, [&]() { uniform.process(io, io); }, uniformMean, peak);
+        timeBlocks<T>(
+            calls, [&]() { serial.process(block.data(), block.data()); },
+            inlineMean, peak);
+        timeBlocks<T>(
+            calls, [&]() { pooled.process(block.data(), block.data()); },
+            pooledMean, peak);
+        benchmark::doNotOptimize(block[0]);
+        std::printf("%-8s %6.2f %9zu %11.1f %14.1f %12.1f %10.1f\n", "",
+                    seconds, serial.segments(),
+                    100.0 * uniformMean / blockNs,
+                    100.0 * inlineMean / blockNs,
+                    100.0 * pooledMean / blockNs, peak * 1e-3);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <vector>
+
+// Backward transforms normalized by 1 / nfft: an unnormalized plan followed by
+// a separate scaling loop against a plan created with Normalization::BY_SIZE,
+// which scales in the last combine step (complex) or while deinterleaving
+// (real).
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    std::printf("%-8s %10s %12s %12s %8s %12s %12s %8s\n", precision, "nfft",
+                "cfft loop", "cfft fused", "speedup", "rfft loop",
+                "rfft fused", "speedup");
+    for (std::size_t nfft = 1 << 6; nfft <= (1 << 22); nfft *= 4) {
+        const T scale = T(1) / (T)nfft;
+        std::vector<C> in(nfft, C(1, -1));
+        std::vector<C> out(nfft);
+        std::vector<T> real(nfft);
+        splitradixfft::Plan<T> complexPlan;
+        splitradixfft::Plan<T> complexNormalized;
+        splitradixfft::Plan<T> realPlan;
+        splitradixfft::Plan<T> realNormalized;
+        splitradixfft::createPlan<T>(nfft,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::BACKWARD,
+                                     complexPlan);
+        splitradixfft::createPlan<T>(
+            nfft, splitradixfft::TransformType::COMPLEX,
+            splitradixfft::Direction::BACKWARD,
+            splitradixfft::Normalization::BY_SIZE, complexNormalized);
+        splitradixfft::createPlan<T>(nfft, splitradixfft::TransformType::REAL,
+                                     splitradixfft::Direction::BACKWARD,
+                                     realPlan);
+        splitradixfft::createPlan<T>(
+            nfft, splitradixfft::TransformType::REAL,
+            splitradixfft::Direction::BACKWARD,
+            splitradixfft::Normalization::BY_SIZE, realNormalized);
+
+        double complexLoop = benchmark::nanosecondsPerCall([&]() {
+            complexPlan.execute(in.data(), out.data());
+            for (std::size_t i = 0; i < nfft; i++) {
+                out[i] *= scale;
+            }
+            benchmark::doNotOptimize(out[0]);
+        });
+        double complexFused = benchmark::nanosecondsPerCall([&]() {
+            complexNormalized.execute(in.data(), out.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        double realLoop = benchmark::nanosecondsPerCall([&]() {
+            realPlan.execute(in.data(), real.data());
+            for (std::size_t i = 0; i < nfft; i++) {
+                real[i] *= scale;
+            }
+            benchmark::doNotOptimize(real[0]);
+        });
+        double realFused = benchmark::nanosecondsPerCall([&]() {
+            realNormalized.execute(in.data(), real.data());
+            benchmark::doNotOptimize(real[0]);
+        });
+        std::printf("%-8s %10zu %12.0f %12.0f %8.2f %12.0f %12.0f %8.2f\n", "",
+                    nfft, complexLoop, complexFused,
+                    complexLoop / complexFused, realLoop, realFused,
+                    realLoop / realFused);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "benchmark.hpp"
+#include "splitradixfft_convolution.hpp"
+#include <vector>
+
+// Uniformly partitioned convolution of impulse responses of 2 to 10 s at
+// 48 kHz. "block us" is the time to process one block of every channel, which
+// bounds the latency on top of collecting the block. "load" is that time as a
+// share of the block duration and "Msamples/s" the throughput over all
+// channels.
+template <typename T>
+void run(const char* precision)
+{
+    const std::size_t sampleRate = 48000;
+    std::printf("%-8s %6s %6s %9s %11s %10s %8s %11s\n", precision, "block",
+                "IR s", "channels", "partitions", "block us", "load %",
+                "Msamples/s");
+    for (std::size_t blockSize : {64, 128, 256}) {
+        for (std::size_t seconds : {2, 5, 10}) {
+            for (std::size_t channels : {1, 8}) {
+                const std::size_t responseSize = seconds * sampleRate;
+                std::vector<T> response(responseSize, T(1) / (T)responseSize);
+                std::vector<const T*> responses(channels, response.data());
+                std::vector<std::vector<T>> buffers(
+                    channels, std::vector<T>(blockSize, T(1)));
+                std::vector<T*> io;
+                for (auto& buffer : buffers) {
+                    io.push_back(buffer.data());
+                }
+                splitradixfft::PartitionedConvolver<T> convolver;
+                splitradixfft::createPartitionedConvolver<T>(
+                    responses.data(), responseSize, channels, blockSize,
+                    convolver);
+                double perBlock = benchmark::nanosecondsPerCall([&]() {
+                    convolver.process(io.data(), io.data());
+                    benchmark::doNotOptimize(io[0][0]);
+                });
+                const double blockNs =
+                    1e9 * (double)blockSize / (double)sampleRate;
+                std::printf("%-8s %6zu %6zu %9zu %11zu %10.1f %8.2f %11.2f\n",
+                            "", blockSize, seconds, channels,
+                            convolver.partitions(), perBlock * 1e-3,
+                            100.0 * perBlock / blockNs,
+                            1e3 * (double)(blockSize * channels) / perBlock);
+            }
+        }
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -0,0 +1,49 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <memory>
+#include <vector>
+
+// Leaves reading the input through masked strided gathers (executeSchedule)
+// against one explicit reordering pass followed by contiguous leaves
+// (executePermutedSchedule).
+template <typename T>
+void run(const char* precision)
+{
+    std::printf("%-8s %10s %14s %14s %8s\n", precision, "nfft", "gathered ns",
+                "permuted ns", "speedup");
+    for (std::size_t nfft = 1 << 4; nfft <= (1 << 22); nfft *= 2) {
+        std::vector<std::complex<T>> in(nfft, std::complex<T>(1, -1));
+        std::vector<std::complex<T>> out(nfft);
+        std::vector<std::complex<T>> twiddleFactors(nfft);
+        splitradixfft::internal::populateCfftTwiddles<T>(
+            twiddleFactors.data(), nfft, false);
+        std::vector<splitradixfft::internal::ScheduleStep> schedule(
+            splitradixfft::internal::scheduleLength(nfft));
+        splitradixfft::internal::buildSchedule(schedule.data(), 0, 1, nfft, 0);
+        std::vector<std::uint32_t> permutation(nfft);
+        splitradixfft::internal::buildPermutation(
+            schedule.data(), schedule.size(), nfft - 1, permutation.data());
+
+        double gathered = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::internal::executeSchedule<T, false>(
+                schedule.data(), schedule.size(), in.data(), out.data(),
+                twiddleFactors.data(), nfft - 1);
+            benchmark::doNotOptimize(out[0]);
+        });
+        double permuted = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::internal::executePermutedSchedule<T, false>(
+                schedule.data(), schedule.size(), in.data(), out.data(),
+                twiddleFactors.data(), permutation.data(), nfft);
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %10zu %14.0f %14.0f %8.2f\n", "", nfft, gathered,
+                    permuted, gathered / permuted);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
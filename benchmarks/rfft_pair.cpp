@@ -0,0 +1,51 @@
+#include "benchmark.hpp"
+#include "splitradixfft.hpp"
+#include <vector>
+
+// Two channels of real input: two calls of performRfftForward against one
+// performRfftPairForward, which runs a single full-length complex transform.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    std::printf("%-8s %10s %14s %14s %8s\n", precision, "nfft", "2x rfft ns",
+                "pair ns", "speedup");
+    for (std::size_t nfft = 1 << 4; nfft <= (1 << 20); nfft *= 4) {
+        std::vector<T> a(nfft, T(1));
+        std::vector<T> b(nfft, T(-1));
+        std::vector<C> outA(nfft / 2 + 1);
+        std::vector<C> outB(nfft / 2 + 1);
+        std::vector<C> scratch(nfft);
+        std::vector<C> rfftTwiddles(nfft);
+        std::vector<C> cfftTwiddles(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<T>(
+            nfft, rfftTwiddles.data(), nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<T>(
+            nfft, cfftTwiddles.data(), nfft);
+
+        double separate = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::performRfftForward<T>(
+                nfft, rfftTwiddles.data(), nfft, a.data(), nfft, outA.data(),
+                nfft / 2 + 1);
+            splitradixfft::performRfftForward<T>(
+                nfft, rfftTwiddles.data(), nfft, b.data(), nfft, outB.data(),
+                nfft / 2 + 1);
+            benchmark::doNotOptimize(outB[0]);
+        });
+        double paired = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::performRfftPairForward<T>(
+                nfft, cfftTwiddles.data(), nfft, a.data(), b.data(), nfft,
+                outA.data(), outB.data(), nfft / 2 + 1, scratch.data(), nfft);
+            benchmark::doNotOptimize(outB[0]);
+        });
+        std::printf("%-8s %10zu %14.0f %14.0f %8.2f\n", "", nfft, separate,
+                    paired, separate / paired);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -0,0 +1,43 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <memory>
+#include <vector>
+
+// Recursive transformRecursion against the flattened schedule executed by the
+// plans, for nfft = 2^4 .. 2^22.
+template <typename T>
+void run(const char* precision)
+{
+    std::printf("%-8s %10s %14s %14s %8s\n", precision, "nfft", "recursive ns",
+                "scheduled ns", "speedup");
+    for (std::size_t nfft = 1 << 4; nfft <= (1 << 22); nfft *= 2) {
+        std::vector<std::complex<T>> in(nfft, std::complex<T>(1, -1));
+        std::vector<std::complex<T>> out(nfft);
+        auto twiddleFactors = std::make_unique<std::complex<T>[]>(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<T>(
+            nfft, twiddleFactors.get(), nfft);
+        splitradixfft::Plan<T> plan;
+        splitradixfft::createPlan<T>(nfft,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::FORWARD, plan);
+
+        double recursive = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::internal::cfftForward<T>(
+                in.data(), out.data(), twiddleFactors.get(), nfft);
+            benchmark::doNotOptimize(out[0]);
+        });
+        double scheduled = benchmark::nanosecondsPerCall([&]() {
+            plan.execute(in.data(), out.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %10zu %14.0f %14.0f %8.2f\n", "", nfft, recursive,
+                    scheduled, recursive / scheduled);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
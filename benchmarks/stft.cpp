@@ -0,0 +1,90 @@
+#include "benchmark.hpp"
+#include "splitradixfft_stft.hpp"
+#include <vector>
+
+// STFT analysis followed by overlap-add resynthesis of a stream with a Hann
+// window and a hop of a quarter frame. "separate" is the per-frame loop as it
+// is commonly written with the functions of splitradixfft.hpp: copy and window
+// the frame, transform, transform back, then multiply by the synthesis window
+// and overlap-add in another pass. "fused" is Stft::process, which windows
+// while loading the leaves and overlap-adds while deinterleaving. The times
+// are per input value.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::size_t length = (std::size_t)1 << 16;
+    std::printf("%-8s %8s %8s %14s %14s %8s\n", precision, "nfft", "hop",
+                "separate ns", "fused ns", "speedup");
+    for (std::size_t nfft = 256; nfft <= 4096; nfft *= 2) {
+        const std::size_t hop = nfft / 4;
+        std::vector<T> in(length, T(1));
+        std::vector<T> out(length);
+        splitradixfft::Stft<T> stft;
+        splitradixfft::createStft<T>(nfft, hop, stft);
+
+        std::vector<C> forwardTwiddles(nfft);
+        std::vector<C> backwardTwiddles(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<T>(
+            nfft, forwardTwiddles.data(), nfft);
+        splitradixfft::populateRfftTwiddleFactorsBackward<T>(
+            nfft, backwardTwiddles.data(), nfft);
+        std::vector<T> window(nfft);
+        std::vector<T> synthesis(nfft);
+        for (std::size_t n = 0; n < nfft; n++) {
+            window[n] =
+                T(0.5) - T(0.5) * std::cos(T(2) * T(3.14159265358979) *
+                                           (T)n / (T)nfft);
+        }
+        // Hann squared at a hop of a quarter frame overlap-adds to 1.5.
+        for (std::size_t n = 0; n < nfft; n++) {
+            synthesis[n] = window[n] / T(1.5);
+        }
+        std::vector<T> frame(nfft);
+        std::vector<T> result(nfft);
+        std::vector<T> overlap(nfft);
+        std::vector<C> spectrum(nfft / 2 + 1);
+        std::vector<C> scratch0(nfft / 2 + 1);
+        std::vector<C> scratch1(nfft / 2 + 1);
+
+        double separate = benchmark::nanosecondsPerCall([&]() {
+            for (std::size_t begin = 0; begin + nfft <= length;
+                 begin += hop) {
+                for (std::size_t n = 0; n < nfft; n++) {
+                    frame[n] = window[n] * in[begin + n];
+                }
+                splitradixfft::performRfftForward<T>(
+                    nfft, forwardTwiddles.data(), nfft, frame.data(), nfft,
+                    spectrum.data(), nfft / 2 + 1);
+                splitradixfft::performRfftBackward<T>(
+                    nfft, backwardTwiddles.data(), nfft, spectrum.data(),
+                    nfft / 2 + 1, result.data(), nfft, scratch0.data(),
+                    scratch1.data(), nfft / 2 + 1,
+                    splitradixfft::Normalization::BY_SIZE);
+                for (std::size_t n = 0; n < nfft; n++) {
+                    overlap[n] += synthesis[n] * result[n];
+                }
+                std::copy(overlap.begin(), overlap.begin() + hop,
+                          out.begin() + begin);
+                std::copy(overlap.begin() + hop, overlap.end(),
+                          overlap.begin());
+                std::fill(overlap.end() - hop, overlap.end(), T(0));
+            }
+            benchmark::doNotOptimize(out[0]);
+        });
+        double fused = benchmark::nanosecondsPerCall([&]() {
+            stft.process(in.data(), out.data(), length, [](C*) {});
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %8zu %8zu %14.2f %14.2f %8.2f\n", "", nfft, hop,
+                    separate / (double)length, fused / (double)length,
+                    separate / fused);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
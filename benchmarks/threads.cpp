@@ -0,0 +1,95 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <thread>
+#include <vector>
+
+// Complex forward plans executed on pools of 1 to 64 threads, the speedup is
+// relative to the serial execute. Pools larger than the number of cores only
+// show the cost of oversubscription.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::size_t threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    std::printf("%-8s %9s %12s", precision, "nfft", "serial us");
+    for (std::size_t threads : threadCounts) {
+        std::printf(" %7zu", threads);
+    }
+    std::printf("\n");
+    for (std::size_t nfft = (std::size_t)1 << 14;
+         nfft <= ((std::size_t)1 << 22); nfft *= 4) {
+        std::vector<C> in(nfft, C(1, -1));
+        std::vector<C> out(nfft);
+        splitradixfft::Plan<T> plan;
+        splitradixfft::createPlan<T>(nfft,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::FORWARD, plan);
+        double serial = benchmark::nanosecondsPerCall([&]() {
+            plan.execute(in.data(), out.data());
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %9zu %12.1f", "", nfft, serial * 1e-3);
+        for (std::size_t threads : threadCounts) {
+            splitradixfft::ThreadPool pool(threads);
+            double parallel = benchmark::nanosecondsPerCall([&]() {
+                plan.execute(in.data(), out.data(), pool);
+                benchmark::doNotOptimize(out[0]);
+            });
+            std::printf(" %6.2fx", serial / parallel);
+        }
+        std::printf("\n");
+    }
+}
+
+// Batches of 2^21 values in total: the BatchExecutor on pools of 1 to 64
+// threads against the serial performCfftForwardBatch.
+template <typename T>
+void runBatch(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::size_t total = (std::size_t)1 << 21;
+    const std::size_t threadCounts[] = {1, 2, 4, 8, 16, 32, 64};
+    std::printf("%-8s %9s %7s %12s", precision, "nfft", "howMany",
+                "serial us");
+    for (std::size_t threads : threadCounts) {
+        std::printf(" %7zu", threads);
+    }
+    std::printf("\n");
+    for (std::size_t nfft = 1024; nfft <= 65536; nfft *= 4) {
+        const std::size_t howMany = total / nfft;
+        std::vector<C> in(total, C(1, -1));
+        std::vector<C> out(total);
+        std::vector<C> twiddleFactors(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<T>(
+            nfft, twiddleFactors.data(), nfft);
+        double serial = benchmark::nanosecondsPerCall([&]() {
+            splitradixfft::performCfftForwardBatch<T>(
+                nfft, twiddleFactors.data(), nfft, howMany, in.data(), 1, nfft,
+                out.data(), 1, nfft, nullptr, 0);
+            benchmark::doNotOptimize(out[0]);
+        });
+        std::printf("%-8s %9zu %7zu %12.1f", "", nfft, howMany, serial * 1e-3);
+        for (std::size_t threads : threadCounts) {
+            splitradixfft::ThreadPool pool(threads);
+            splitradixfft::BatchExecutor<T> executor(pool);
+            double parallel = benchmark::nanosecondsPerCall([&]() {
+                executor.cfftForward(nfft, twiddleFactors.data(), nfft,
+                                     howMany, in.data(), 1, nfft, out.data(),
+                                     1, nfft);
+                benchmark::doNotOptimize(out[0]);
+            });
+            std::printf(" %6.2fx", serial / parallel);
+        }
+        std::printf("\n");
+    }
+}
+
+int main()
+{
+    std::printf("hardware threads: %u\n", std::thread::hardware_concurrency());
+    run<float>("float");
+    run<double>("double");
+    runBatch<float>("float");
+    runBatch<double>("double");
+    return 0;
+}
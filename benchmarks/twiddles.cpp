@@ -0,0 +1,39 @@
+#include "benchmark.hpp"
+#include "splitradixfft_plan.hpp"
+#include <memory>
+
+// Twiddle factor generation and plan creation, nfft = 2^10 .. 2^24.
+template <typename T>
+void run(const char* precision)
+{
+    std::printf("%-8s %10s %14s %14s\n", precision, "nfft", "populate us",
+                "createPlan us");
+    for (std::size_t nfft = 1 << 10; nfft <= (1 << 24); nfft *= 4) {
+        auto twiddleFactors = std::make_unique<std::complex<T>[]>(nfft);
+        double populate = benchmark::nanosecondsPerCall(
+            [&]() {
+                splitradixfft::populateCfftTwiddleFactorsForward<T>(
+                    nfft, twiddleFactors.get(), nfft);
+                benchmark::doNotOptimize(twiddleFactors[nfft - 1]);
+            },
+            0.05, 1);
+        double create = benchmark::nanosecondsPerCall(
+            [&]() {
+                splitradixfft::Plan<T> plan;
+                splitradixfft::createPlan<T>(
+                    nfft, splitradixfft::TransformType::COMPLEX,
+                    splitradixfft::Direction::FORWARD, plan);
+                benchmark::doNotOptimize(plan);
+            },
+            0.05, 1);
+        std::printf("%-8s %10zu %14.1f %14.1f\n", "", nfft, populate * 1e-3,
+                    create * 1e-3);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
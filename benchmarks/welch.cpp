@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+#include "splitradixfft_welch.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+// Welch power spectral densities of 8 channels of 2^18 values with a Hann
+// window and segments overlapping by half. "by hand" is the loop as it is
+// commonly written around performRfftForward: copy and window every segment,
+// transform it and add std::norm of every bin. "estimator" is
+// WelchEstimator::psd, "pooled" the same with a pool of all cores. The times
+// are per input value of all channels.
+template <typename T>
+void run(const char* precision)
+{
+    using C = std::complex<T>;
+    const std::size_t length = (std::size_t)1 << 18;
+    const std::size_t channels = 8;
+    std::vector<std::vector<T>> data(channels, std::vector<T>(length));
+    std::vector<const T*> in;
+    for (std::size_t c = 0; c < channels; c++) {
+        for (std::size_t n = 0; n < length; n++) {
+            data[c][n] = (T)std::sin(0.001 * (double)((c + 1) * n));
+        }
+        in.push_back(data[c].data());
+    }
+    splitradixfft::ThreadPool pool;
+    std::printf("%-8s %8s %14s %14s %14s %8s\n", precision, "nfft",
+                "by hand ns", "estimator ns", "pooled ns", "speedup");
+    for (std::size_t nfft = 256; nfft <= 8192; nfft *= 2) {
+        const std::size_t bins = nfft / 2 + 1;
+        std::vector<std::vector<T>> result(channels, std::vector<T>(bins));
+        std::vector<T*> out;
+        for (auto& values : result) {
+            out.push_back(values.data());
+        }
+        splitradixfft::WelchEstimator<T> estimator;
+        splitradixfft::createWelchEstimator<T>(nfft, nfft / 2, channels,
+                                               estimator);
+
+        std::vector<C> twiddles(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<T>(
+            nfft, twiddles.data(), nfft);
+        std::vector<T> window(nfft);
+        for (std::size_t n = 0; n < nfft; n++) {
+            window[n] =
+                T(0.5) - T(0.5) * std::cos(T(2) * T(3.14159265358979) *
+                                           (T)n / (T)nfft);
+        }
+        std::vector<T> segment(nfft);
+        std::vector<C> spectrum(bins);
+
+        double byHand = benchmark::nanosecondsPerCall([&]() {
+            for (std::size_t c = 0; c < channels; c++) {
+                std::fill(result[c].begin(), result[c].end(), T(0));
+                for (std::size_t begin = 0; begin + nfft <= length;
+                     begin += nfft / 2) {
+                    for (std::size_t n = 0; n < nfft; n++) {
+                        segment[n] = window[n] * in[c][begin + n];
+                    }
+                    splitradixfft::performRfftForward<T>(
+                        nfft, twiddles.data(), nfft, segment.data(), nfft,
+                        spectrum.data(), bins);
+                    for (std::size_t k = 0; k < bins; k++) {
+                        result[c][k] += std::norm(spectrum[k]);
+                    }
+                }
+            }
+            benchmark::doNotOptimize(result[0][0]);
+        });
+        double serial = benchmark::nanosecondsPerCall([&]() {
+            estimator.psd(in.data(), length, out.data());
+            benchmark::doNotOptimize(result[0][0]);
+        });
+        double pooled = benchmark::nanosecondsPerCall([&]() {
+            estimator.psd(in.data(), length, out.data(), pool);
+            benchmark::doNotOptimize(result[0][0]);
+        });
+        const double values = (double)(length * channels);
+        std::printf("%-8s %8zu %14.2f %14.2f %14.2f %8.2f\n", "", nfft,
+                    byHand / values, serial / values, pooled / values,
+                    byHand / serial);
+    }
+}
+
+int main()
+{
+    run<float>("float");
+    run<double>("double");
+    return 0;
+}
@@ -29,6 +29,21 @@ build_normal() {
     shell cmake --build .build
 }
 
+# Function to build and run the benchmarks
+run_benchmarks() {
+    echo "Running benchmarks..."
+    mkdir -p .build-bench
+    shell cmake \
+            -B .build-bench \
+            -G Ninja \
+            -DCMAKE_BUILD_TYPE=Release \
+            -DBUILD_BENCHMARKS_SPLIT_RADIX_FFT=ON
+    shell cmake --build .build-bench
+    for benchmark in .build-bench/benchmarks/benchmark_*; do
+        shell ./$benchmark
+    done
+}
+
 # Function to run tests
 run_tests() {
     echo "Running tests..."
@@ -48,7 +63,7 @@ if [ $# -eq 0 ]; then
 fi
 
 # Parse command line options
-while getopts ":tds" opt; do
+while getopts ":tdsb" opt; do
     case ${opt} in
         t )
             build_normal
@@ -60,8 +75,11 @@ while getopts ":tds" opt; do
         s )
             shell
             ;;
+        b )
+            run_benchmarks
+            ;;
         \? )
-            echo "Usage: cmd [-t] for tests, [-d] for docker build, no option for normal build"
+            echo "Usage: cmd [-t] for tests, [-b] for benchmarks, [-d] for docker build, no option for normal build"
             exit 1
             ;;
     esac
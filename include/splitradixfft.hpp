@@ -24,14 +24,23 @@
  * ==============================================================================
  *
  * splitradixfft.hpp
- * Simple library for an fft. By composition of the algorithm, the rfft is by
- * default normalized but the cfft is currently not normalized.
+ * Simple library for an fft. The transforms are unnormalized by default, a
+ * Normalization can be passed to scale the output without an extra pass.
  *
  * ==============================================================================
  */
 
 #pragma once
+#include "splitradixfft_codelets.hpp"
+#include "splitradixfft_simd.hpp"
+#include <algorithm>
+#include <cmath>
 #include <complex>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <thread>
+#include <vector>
 
 namespace splitradixfft {
 /*
@@ -73,154 +82,799 @@ inline C rot135(C input)
                    invSqrt2<T>;
 }
 
+// Smallest real transform. The unscramble step of the real transforms needs
+// nfft / 8 >= 1.
+constexpr std::size_t minimumRfftSize = 8;
+
+// Minimum number of items per thread of parallelFor.
+constexpr std::size_t parallelGrain = (std::size_t)1 << 16;
+
+template <typename Function>
+void parallelFor(std::size_t count, Function function)
+{
+    // Split [0, count) into one contiguous range per hardware thread, as long
+    // as each gets at least parallelGrain items. If a thread cannot be
+    // started its range runs on the calling thread.
+    std::size_t threads{std::max<std::size_t>(
+        1, std::thread::hardware_concurrency())};
+    threads = std::min(threads, count / parallelGrain);
+    if (threads <= 1) {
+        function((std::size_t)0, count);
+        return;
+    }
+    const std::size_t chunk{(count + threads - 1) / threads};
+    std::size_t next{chunk};
+    std::vector<std::thread> workers;
+    try {
+        workers.reserve(threads - 1);
+        for (; next < count; next += chunk) {
+            workers.emplace_back(function, next, std::min(next + chunk, count));
+        }
+    } catch (...) {
+        function(next, count);
+    }
+    function((std::size_t)0, chunk);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+template <typename T>
+void populateUnitRoots(std::complex<T>* out, std::size_t count,
+                       std::size_t first, std::size_t step, std::size_t N,
+                       bool inverseTransform)
+{
+    // out[i] = w^(first + i * step) with w = exp(-+2 pi j / N), step is 1 or 2
+    // and first < step. Only the powers in the first octant are evaluated, in
+    // long double, the others follow exactly by reflection and rotation.
+    // Every value only depends on the reduced fraction k / N, e.g. the powers
+    // w_N^(2i) and w_(N/2)^i are bit-identical.
+    using C = std::complex<T>;
+    using L = long double;
+    const L pi{std::acos((L)-1)};
+    const T sign{inverseTransform ? (T)1 : (T)-1};
+    auto evaluate = [pi, sign, N](std::size_t k) {
+        const L angle{(L)2 * pi * (L)k / (L)N};
+        return C((T)std::cos(angle), sign * (T)std::sin(angle));
+    };
+    if (N < 8) {
+        for (std::size_t i = 0; i < count; i++) {
+            out[i] = evaluate(first + i * step);
+        }
+        return;
+    }
+
+    const std::size_t octant{N / 8};
+    const std::size_t direct{std::min(count, (octant - first) / step + 1)};
+    parallelFor(direct, [out, first, step, &evaluate](std::size_t begin,
+                                                      std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            out[i] = evaluate(first + i * step);
+        }
+    });
+    parallelFor(count - direct, [out, first, step, N, octant, direct,
+                                 sign](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin + direct; i < end + direct; i++) {
+            const std::size_t k{(first + i * step) % N};
+            const std::size_t quadrant{4 * k / N};
+            const std::size_t r{k - quadrant * (N / 4)};
+            C value;
+            if (r <= octant) {
+                value = out[(r - first) / step];
+            } else {
+                // w^r = conj(w^(N/4 - r)) rotated by a quarter turn.
+                const C reflected{out[(N / 4 - r - first) / step]};
+                value = C(sign * reflected.imag(), sign * reflected.real());
+            }
+            for (std::size_t q = 0; q < quadrant; q++) {
+                // Multiply by w^(N/4) = -+j.
+                value = C(-sign * value.imag(), sign * value.real());
+            }
+            out[i] = value;
+        }
+    });
+}
+
 template <typename T>
 void populateCfftTwiddles(std::complex<T>* twiddleFactors, std::size_t nfft,
                           bool inverseTransform)
 {
-    T pi{std::acos((T)-1)};
-    for (std::size_t i = 0; i < nfft; i++) {
-        twiddleFactors[i] =
-            inverseTransform
-                ? std::exp(std::complex<T>(0, (T)i * (T)2 * pi / ((T)nfft)))
-                : std::exp(std::complex<T>(0, -(T)i * (T)2 * pi / ((T)nfft)));
+    populateUnitRoots<T>(twiddleFactors, nfft, 0, 1, nfft, inverseTransform);
+}
+
+template <typename T, bool F, bool S = false>
+inline void combineButterfliesScalar(std::complex<T>* out,
+                                     const std::complex<T>* twiddle,
+                                     std::size_t twiddleStride, std::size_t N,
+                                     std::size_t begin, std::size_t end,
+                                     T scale = T(1))
+{
+    // S scales the outputs by scale. Every output is a sum of u1 or u3 and the
+    // twiddled z1 and z3, so scaling u1, u3 and the twiddle factor is enough.
+    using C = std::complex<T>;
+    C u1, u3, w, z1, z3, zSum, zDiff;
+    for (std::size_t i = begin; i < end; i++) {
+        u1 = out[i];
+        u3 = out[i + N / 4];
+        w = twiddle[i * twiddleStride];
+        if constexpr (S) {
+            u1 *= scale;
+            u3 *= scale;
+            w *= scale;
+        }
+        z1 = out[i + N / 2] * w;
+        z3 = out[i + 3 * N / 4] * std::conj(w);
+        zSum = z1 + z3;
+        zDiff = rot90<C, F>(z1 - z3);
+
+        // Calculate: data[i*S*2] = u1 + z1 + z3
+        out[i] = u1 + zSum;
+
+        // Calculate: data[i*S*2 + N/2] = u1 - z1 - z3
+        out[i + N / 2] = u1 - zSum;
+
+        // Calculate: data[i*S*2 + N/4] = u3 -j*(z1 - z3)
+        out[i + N / 4] = u3 + zDiff;
+
+        // Calculate: data[i*S*2 + 3*N/4] = u3 + j*(z1 - z3)
+        out[i + 3 * N / 4] = u3 - zDiff;
+    }
+}
+
+template <typename T, bool F, bool S = false>
+inline void combineButterfliesVector(std::complex<T>* out,
+                                     const std::complex<T>* twiddle,
+                                     std::size_t twiddleStride, std::size_t N,
+                                     std::size_t i, T scale = T(1))
+{
+    // Same butterfly as the scalar loop for simd::Vec<T>::width consecutive
+    // values of i.
+    using V = simd::Vec<T>;
+    typename V::R u1{V::load(out + i)};
+    typename V::R u3{V::load(out + i + N / 4)};
+    typename V::R w{simd::loadStrided<T>(twiddle + i * twiddleStride,
+                                         twiddleStride)};
+    if constexpr (S) {
+        const typename V::R s{V::broadcast(scale)};
+        u1 = V::scale(u1, s);
+        u3 = V::scale(u3, s);
+        w = V::scale(w, s);
+    }
+    typename V::R z1{V::mul(V::load(out + i + N / 2), w)};
+    typename V::R z3{V::mulConj(V::load(out + i + 3 * N / 4), w)};
+    typename V::R zSum{V::add(z1, z3)};
+    typename V::R zDiff{V::template rot90<F>(V::sub(z1, z3))};
+    V::store(out + i, V::add(u1, zSum));
+    V::store(out + i + N / 2, V::sub(u1, zSum));
+    V::store(out + i + N / 4, V::add(u3, zDiff));
+    V::store(out + i + 3 * N / 4, V::sub(u3, zDiff));
+}
+
+template <typename T, bool F, bool S = false>
+inline void combineButterfliesRange(std::complex<T>* out,
+                                    const std::complex<T>* twiddle,
+                                    std::size_t twiddleStride, std::size_t N,
+                                    std::size_t begin, std::size_t end,
+                                    T scale = T(1))
+{
+    // Butterflies begin to end of combineButterflies. Splitting a level into
+    // ranges that are multiples of 2 * simd::Vec<T>::width gives the same
+    // results as combining it at once.
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        // N / 4 and W are both powers of two, hence either W divides N / 4 or
+        // the level is too small to fill a single register.
+        if (N / 4 >= W) {
+            std::size_t i = begin;
+            for (; i + 2 * W <= end; i += 2 * W) {
+                combineButterfliesVector<T, F, S>(out, twiddle, twiddleStride,
+                                                  N, i, scale);
+                combineButterfliesVector<T, F, S>(out, twiddle, twiddleStride,
+                                                  N, i + W, scale);
+            }
+            if (i < end) {
+                combineButterfliesVector<T, F, S>(out, twiddle, twiddleStride,
+                                                  N, i, scale);
+            }
+            return;
+        }
     }
+    combineButterfliesScalar<T, F, S>(out, twiddle, twiddleStride, N, begin,
+                                      end, scale);
 }
 
 template <typename T, bool F>
-void transformRecursion(const std::complex<T>* in, std::complex<T>* out,
-                        const std::complex<T>* twiddle, std::size_t offset,
-                        std::size_t stride, std::size_t N, std::size_t mask)
+inline void combineButterflies(std::complex<T>* out,
+                               const std::complex<T>* twiddle,
+                               std::size_t twiddleStride, std::size_t N)
+{
+    // Combine the N/2 and the two N/4 sub-transforms stored in out into the
+    // transform of size N. The twiddle factor of butterfly i is
+    // twiddle[i * twiddleStride].
+    combineButterfliesRange<T, F>(out, twiddle, twiddleStride, N, 0, N / 4);
+}
+
+template <typename T, bool F>
+inline void combineButterfliesScaled(std::complex<T>* out,
+                                     const std::complex<T>* twiddle,
+                                     std::size_t twiddleStride, std::size_t N,
+                                     T scale)
+{
+    // combineButterflies with the outputs multiplied by scale. The last
+    // combine step normalizes a transform without another pass over it.
+    combineButterfliesRange<T, F, true>(out, twiddle, twiddleStride, N, 0,
+                                        N / 4, scale);
+}
+
+template <typename T>
+inline void scaleSequence(std::complex<T>* data, std::size_t size, T scale)
+{
+    // Normalization of transforms that are a single leaf, which are still in
+    // the L1 cache.
+    for (std::size_t i = 0; i < size; i++) {
+        data[i] *= scale;
+    }
+}
+
+template <typename T, bool F, typename Load>
+inline void leaf1(std::complex<T>* out, Load load)
+{
+    out[0] = load(0);
+}
+
+template <typename T, bool F, typename Load>
+inline void leaf2(std::complex<T>* out, Load load)
+{
+    using C = std::complex<T>;
+    C y0{load(0)};
+    C y1{load(1)};
+    out[0] = y0 + y1;
+    out[1] = y0 - y1;
+}
+
+template <typename T, bool F, typename Load>
+inline void leaf4(std::complex<T>* out, Load load)
+{
+    using C = std::complex<T>;
+    C y0{load(0)};
+    C y1{load(1)};
+    C y2{load(2)};
+    C y3{load(3)};
+    // Calculate: data[i] += y1 + y2 + y3;
+    out[0] = y0 + y1 + y2 + y3;
+    // Calculate: data[i+N/4] = data[i] - j*y1 -y2 + j*y3;
+    out[1] = y0 + rot90<C, F>(y1) - y2 - rot90<C, F>(y3);
+    // Calculate: data[i+N/2] = data[i] - y1 + y2 - y3;
+    out[2] = y0 - y1 + y2 - y3;
+    // Calculate: data[i+3*N/4] = data[i] + j*y1 - y2 - j*y3;
+    out[3] = y0 - rot90<C, F>(y1) - y2 + rot90<C, F>(y3);
+}
+
+template <typename T, bool F, typename Load>
+inline void leaf8(std::complex<T>* out, Load load)
 {
     using C = std::complex<T>;
+    C y0{load(0)};
+    C y1{load(1)};
+    C y2{load(2)};
+    C y3{load(3)};
+    C y4{load(4)};
+    C y5{load(5)};
+    C y6{load(6)};
+    C y7{load(7)};
+    // Calculate: data[i] += y1 + y2 + y3;
+    out[0] = y0 + y1 + y2 + y3 + y4 + y5 + y6 + y7;
+
+    // data[i+1] = y0 + w*y1 + w^2*y2 + w^3*y3 + w^4*y4 + w^5*y5 + w^6*y6 +
+    // w^7*y7;
+    out[1] = y0 + rot45<T, C, F>(y1) + rot90<C, F>(y2) +
+             rot135<T, C, F>(y3) - y4 - rot45<T, C, F>(y5) -
+             rot90<C, F>(y6) - rot135<T, C, F>(y7);
+
+    // data[i+2] = y0 + w^2*y1 + w^4*y2 + w^6*y3 + y4 + w^2*y5 + w^4*y6 +
+    // w^6*y7;
+    out[2] = y0 + rot90<C, F>(y1) - y2 - rot90<C, F>(y3) + y4 +
+             rot90<C, F>(y5) - y6 - rot90<C, F>(y7);
+
+    // data[i+3] = y0 + w^3*y1 + w^6*y2 + w^9*y3 + w^12*y4 + w^15*y5 +
+    // w^18*y6
+    // + w^21*y7; data[i+3] = y0 + w^3*y1 + w^6*y2 + w^1*y3 + w^4*y4 +
+    // w^7*y5
+    // + w^2*y6 + w^5*y7;
+    out[3] = y0 + rot135<T, C, F>(y1) - rot90<C, F>(y2) +
+             rot45<T, C, F>(y3) - y4 - rot135<T, C, F>(y5) +
+             rot90<C, F>(y6) - rot45<T, C, F>(y7);
+
+    // data[i+4] = y0 + w^4*y1 + w^8*y2 + w^12*y3 + w^16*y4 + w^20*y5 +
+    // w^24*y6 + w^28*y7; data[i+4] = y0 + w^4*y1 + y2 + w^4*y3 + y4 +
+    // w^4*y5
+    // + y6 + w^4*y7;
+    out[4] = y0 - y1 + y2 - y3 + y4 - y5 + y6 - y7;
+
+    // data[i+5] = y0 + w^5*y1 + w^10*y2 + w^15*y3 + w^20*y4 + w^25*y5 +
+    // w^30*y6 + w^35*y7; data[i+5] = y0 + w^5*y1 + w^2*y2 + w^7*y3 + w^4*y4
+    // + w^1*y5 + w^6*y6 + w^3*y7;
+    out[5] = y0 - rot45<T, C, F>(y1) + rot90<C, F>(y2) -
+             rot135<T, C, F>(y3) - y4 + rot45<T, C, F>(y5) -
+             rot90<C, F>(y6) + rot135<T, C, F>(y7);
+
+    // data[i+6] = y0 + w^6*y1 + w^12*y2 + w^18*y3 + w^24*y4 + w^30*y5 +
+    // w^36*y6 + w^42*y7; data[i+6] = y0 + w^6*y1 + w^4*y2 + w^2*y3 + y4 +
+    // w^6*y5 + w^4*y6 + w^2*y7;
+    out[6] = y0 - rot90<C, F>(y1) - y2 + rot90<C, F>(y3) + y4 -
+             rot90<C, F>(y5) - y6 + rot90<C, F>(y7);
+
+    // data[i+7] = y0 + w^7*y1 + w^14*y2 + w^21*y3 + w^28*y4 + w^35*y5 +
+    // w^42*y6 + w^49*y7; data[i+7] = y0 + w^7*y1 + w^6*y2 + w^5*y3 + w^4*y4
+    // + w^3*y5 + w^2*y6 + w^1*y7;
+    out[7] = y0 - rot135<T, C, F>(y1) - rot90<C, F>(y2) -
+             rot45<T, C, F>(y3) - y4 + rot135<T, C, F>(y5) +
+             rot90<C, F>(y6) + rot45<T, C, F>(y7);
+}
+
+// Largest transform computed by a straight-line codelet. A 64-point codelet no
+// longer fits into the register file and was measured slower than two levels
+// of recursion over 32-point leaves.
+constexpr std::size_t maxLeafSize = 32;
+
+template <typename T, bool F, typename Load>
+inline void transformLeaf(std::complex<T>* out, std::size_t N, Load load)
+{
+    // load(k) returns the k-th input value of the leaf. All codelets read
+    // their whole input before writing, hence out may alias the input.
     switch (N) {
-    case 1: {
-        out[0] = in[offset & mask];
+    case 1:
+        leaf1<T, F>(out, load);
         break;
-    }
-    case 2: {
-        C y0{in[(offset)&mask]};
-        C y1{in[(offset + stride) & mask]};
-        out[0] = y0 + y1;
-        out[1] = y0 - y1;
+    case 2:
+        leaf2<T, F>(out, load);
         break;
-    }
-    case 4: {
-        C y0{in[(offset)&mask]};
-        C y1{in[(offset + stride) & mask]};
-        C y2{in[(offset + 2 * stride) & mask]};
-        C y3{in[(offset + 3 * stride) & mask]};
-        // Calculate: data[i] += y1 + y2 + y3;
-        out[0] = y0 + y1 + y2 + y3;
-        // Calculate: data[i+N/4] = data[i] - j*y1 -y2 + j*y3;
-        out[1] = y0 + rot90<C, F>(y1) - y2 - rot90<C, F>(y3);
-        // Calculate: data[i+N/2] = data[i] - y1 + y2 - y3;
-        out[2] = y0 - y1 + y2 - y3;
-        // Calculate: data[i+3*N/4] = data[i] + j*y1 - y2 - j*y3;
-        out[3] = y0 - rot90<C, F>(y1) - y2 + rot90<C, F>(y3);
+    case 4:
+        leaf4<T, F>(out, load);
         break;
-    }
-    case 8: {
-        C y0{in[offset & mask]};
-        C y1{in[(offset + stride) & mask]};
-        C y2{in[(offset + 2 * stride) & mask]};
-        C y3{in[(offset + 3 * stride) & mask]};
-        C y4{in[(offset + 4 * stride) & mask]};
-        C y5{in[(offset + 5 * stride) & mask]};
-        C y6{in[(offset + 6 * stride) & mask]};
-        C y7{in[(offset + 7 * stride) & mask]};
-        // Calculate: data[i] += y1 + y2 + y3;
-        out[0] = y0 + y1 + y2 + y3 + y4 + y5 + y6 + y7;
-
-        // data[i+1] = y0 + w*y1 + w^2*y2 + w^3*y3 + w^4*y4 + w^5*y5 + w^6*y6 +
-        // w^7*y7;
-        out[1] = y0 + rot45<T, C, F>(y1) + rot90<C, F>(y2) +
-                 rot135<T, C, F>(y3) - y4 - rot45<T, C, F>(y5) -
-                 rot90<C, F>(y6) - rot135<T, C, F>(y7);
-
-        // data[i+2] = y0 + w^2*y1 + w^4*y2 + w^6*y3 + y4 + w^2*y5 + w^4*y6 +
-        // w^6*y7;
-        out[2] = y0 + rot90<C, F>(y1) - y2 - rot90<C, F>(y3) + y4 +
-                 rot90<C, F>(y5) - y6 - rot90<C, F>(y7);
-
-        // data[i+3] = y0 + w^3*y1 + w^6*y2 + w^9*y3 + w^12*y4 + w^15*y5 +
-        // w^18*y6
-        // + w^21*y7; data[i+3] = y0 + w^3*y1 + w^6*y2 + w^1*y3 + w^4*y4 +
-        // w^7*y5
-        // + w^2*y6 + w^5*y7;
-        out[3] = y0 + rot135<T, C, F>(y1) - rot90<C, F>(y2) +
-                 rot45<T, C, F>(y3) - y4 - rot135<T, C, F>(y5) +
-                 rot90<C, F>(y6) - rot45<T, C, F>(y7);
-
-        // data[i+4] = y0 + w^4*y1 + w^8*y2 + w^12*y3 + w^16*y4 + w^20*y5 +
-        // w^24*y6 + w^28*y7; data[i+4] = y0 + w^4*y1 + y2 + w^4*y3 + y4 +
-        // w^4*y5
-        // + y6 + w^4*y7;
-        out[4] = y0 - y1 + y2 - y3 + y4 - y5 + y6 - y7;
-
-        // data[i+5] = y0 + w^5*y1 + w^10*y2 + w^15*y3 + w^20*y4 + w^25*y5 +
-        // w^30*y6 + w^35*y7; data[i+5] = y0 + w^5*y1 + w^2*y2 + w^7*y3 + w^4*y4
-        // + w^1*y5 + w^6*y6 + w^3*y7;
-        out[5] = y0 - rot45<T, C, F>(y1) + rot90<C, F>(y2) -
-                 rot135<T, C, F>(y3) - y4 + rot45<T, C, F>(y5) -
-                 rot90<C, F>(y6) + rot135<T, C, F>(y7);
-
-        // data[i+6] = y0 + w^6*y1 + w^12*y2 + w^18*y3 + w^24*y4 + w^30*y5 +
-        // w^36*y6 + w^42*y7; data[i+6] = y0 + w^6*y1 + w^4*y2 + w^2*y3 + y4 +
-        // w^6*y5 + w^4*y6 + w^2*y7;
-        out[6] = y0 - rot90<C, F>(y1) - y2 + rot90<C, F>(y3) + y4 -
-                 rot90<C, F>(y5) - y6 + rot90<C, F>(y7);
-
-        // data[i+7] = y0 + w^7*y1 + w^14*y2 + w^21*y3 + w^28*y4 + w^35*y5 +
-        // w^42*y6 + w^49*y7; data[i+7] = y0 + w^7*y1 + w^6*y2 + w^5*y3 + w^4*y4
-        // + w^3*y5 + w^2*y6 + w^1*y7;
-        out[7] = y0 - rot135<T, C, F>(y1) - rot90<C, F>(y2) -
-                 rot45<T, C, F>(y3) - y4 + rot135<T, C, F>(y5) +
-                 rot90<C, F>(y6) + rot45<T, C, F>(y7);
+    case 8:
+        leaf8<T, F>(out, load);
+        break;
+    case 16:
+        leaf16<T, F>(out, load);
         break;
+    case 32:
+        leaf32<T, F>(out, load);
+        break;
+    }
+}
+
+template <typename T, bool F, typename Load>
+void transformNodes(Load load, std::complex<T>* out,
+                    const std::complex<T>* twiddle, std::size_t offset,
+                    std::size_t stride, std::size_t N, std::size_t mask)
+{
+    // transformRecursion with the input accessed through load(i), e.g. to
+    // read strided or real-valued sequences without copying them first.
+    if (N <= maxLeafSize) {
+        transformLeaf<T, F>(out, N,
+                            [&load, offset, stride, mask](std::size_t k) {
+                                return load((offset + k * stride) & mask);
+                            });
+        return;
+    }
+    transformNodes<T, F>(load, out, twiddle, offset, 2 * stride, N / 2, mask);
+    transformNodes<T, F>(load, out + N / 2, twiddle, offset + stride,
+                         4 * stride, N / 4, mask);
+    transformNodes<T, F>(load, out + 3 * N / 4, twiddle, offset - stride,
+                         4 * stride, N / 4, mask);
+    combineButterflies<T, F>(out, twiddle, stride, N);
+}
+
+template <typename T, bool F>
+void transformRecursion(const std::complex<T>* in, std::complex<T>* out,
+                        const std::complex<T>* twiddle, std::size_t offset,
+                        std::size_t stride, std::size_t N, std::size_t mask)
+{
+    transformNodes<T, F>([in](std::size_t i) { return in[i]; }, out, twiddle,
+                         offset, stride, N, mask);
+}
+
+template <typename T, bool F, typename Load>
+void transformNodesScaled(Load load, std::complex<T>* out,
+                          const std::complex<T>* twiddle, std::size_t offset,
+                          std::size_t stride, std::size_t N, std::size_t mask,
+                          T scale)
+{
+    // transformNodes with the outputs multiplied by scale in the root combine
+    // step.
+    if (N <= maxLeafSize) {
+        transformNodes<T, F>(load, out, twiddle, offset, stride, N, mask);
+        scaleSequence<T>(out, N, scale);
+        return;
+    }
+    transformNodes<T, F>(load, out, twiddle, offset, 2 * stride, N / 2, mask);
+    transformNodes<T, F>(load, out + N / 2, twiddle, offset + stride,
+                         4 * stride, N / 4, mask);
+    transformNodes<T, F>(load, out + 3 * N / 4, twiddle, offset - stride,
+                         4 * stride, N / 4, mask);
+    combineButterfliesScaled<T, F>(out, twiddle, stride, N, scale);
+}
+
+// One node of the flattened recursion tree, see buildSchedule.
+struct ScheduleStep {
+    enum class Kind : unsigned char {
+        LEAF,
+        COMBINE,
+    };
+    Kind kind;
+    std::size_t N;
+    // LEAF: input offset and stride. COMBINE: offset and stride of the
+    // twiddle factors in the table passed to the executor.
+    std::size_t offset;
+    std::size_t stride;
+    // First output index of the node.
+    std::size_t outIndex;
+};
+
+inline std::size_t scheduleLength(std::size_t N)
+{
+    if (N <= maxLeafSize) {
+        return 1;
+    }
+    return scheduleLength(N / 2) + 2 * scheduleLength(N / 4) + 1;
+}
+
+inline std::size_t buildSchedule(ScheduleStep* schedule, std::size_t offset,
+                                 std::size_t stride, std::size_t N,
+                                 std::size_t outIndex)
+{
+    // Record the nodes of transformRecursion in the order they complete, i.e.
+    // the children of a combine step precede it. Returns the number of steps.
+    // schedule has to hold scheduleLength(N) steps.
+    if (N <= maxLeafSize) {
+        schedule[0] = {ScheduleStep::Kind::LEAF, N, offset, stride, outIndex};
+        return 1;
+    }
+    std::size_t length{0};
+    length += buildSchedule(schedule + length, offset, 2 * stride, N / 2,
+                            outIndex);
+    length += buildSchedule(schedule + length, offset + stride, 4 * stride,
+                            N / 4, outIndex + N / 2);
+    length += buildSchedule(schedule + length, offset - stride, 4 * stride,
+                            N / 4, outIndex + 3 * N / 4);
+    schedule[length] = {ScheduleStep::Kind::COMBINE, N, 0, stride, outIndex};
+    return length + 1;
+}
+
+// Plans store the twiddle factors of every combine level in its own block,
+// level N holds w_N^i for i < N/4 at levelTwiddleOffset(N). The combine loops
+// read them with unit stride instead of striding through one nfft table, and
+// all blocks together hold less than nfft/2 values.
+inline std::size_t levelTwiddleOffset(std::size_t N)
+{
+    return N / 4 - maxLeafSize / 2;
+}
+
+inline std::size_t levelTwiddleCount(std::size_t N)
+{
+    return N > maxLeafSize ? levelTwiddleOffset(2 * N) : 0;
+}
+
+inline void useLevelTwiddles(ScheduleStep* schedule, std::size_t length)
+{
+    for (std::size_t s = 0; s < length; s++) {
+        if (schedule[s].kind == ScheduleStep::Kind::COMBINE) {
+            schedule[s].offset = levelTwiddleOffset(schedule[s].N);
+            schedule[s].stride = 1;
+        }
+    }
+}
+
+template <typename T>
+void populateLevelTwiddles(std::complex<T>* levels, std::size_t N,
+                           bool inverseTransform)
+{
+    // Only the top level is evaluated, w_L^i = w_N^(i N / L) of the lower
+    // levels L is bit-identical to the strided entry of the top level block.
+    if (N <= maxLeafSize) {
+        return;
+    }
+    const std::complex<T>* top{levels + levelTwiddleOffset(N)};
+    populateUnitRoots<T>(levels + levelTwiddleOffset(N), N / 4, 0, 1, N,
+                         inverseTransform);
+    for (std::size_t level = 2 * maxLeafSize; level < N; level *= 2) {
+        std::complex<T>* block{levels + levelTwiddleOffset(level)};
+        for (std::size_t i = 0; i < level / 4; i++) {
+            block[i] = top[i * (N / level)];
+        }
+    }
+}
+
+template <typename T, bool F>
+inline void combineStep(const ScheduleStep& step, bool root,
+                        std::complex<T>* node, const std::complex<T>* twiddle,
+                        T scale)
+{
+    // Combine step of a schedule, the root applies the normalization.
+    if (root && scale != T(1)) {
+        combineButterfliesScaled<T, F>(node, twiddle + step.offset,
+                                       step.stride, step.N, scale);
+    } else {
+        combineButterflies<T, F>(node, twiddle + step.offset, step.stride,
+                                 step.N);
+    }
+}
+
+template <typename T, bool F>
+void executeSchedule(const ScheduleStep* schedule, std::size_t length,
+                     const std::complex<T>* in, std::complex<T>* out,
+                     const std::complex<T>* twiddle, std::size_t mask)
+{
+    // Iterative equivalent of transformRecursion, it performs the same
+    // operations in the same order and is therefore bit-compatible.
+    for (std::size_t s = 0; s < length; s++) {
+        const ScheduleStep& step = schedule[s];
+        if (step.kind == ScheduleStep::Kind::LEAF) {
+            // The leaves go through the same load path as the recursion,
+            // FMA contraction could otherwise differ between the two.
+            transformRecursion<T, F>(in, out + step.outIndex, twiddle,
+                                     step.offset, step.stride, step.N, mask);
+        } else {
+            combineButterflies<T, F>(out + step.outIndex,
+                                     twiddle + step.offset, step.stride,
+                                     step.N);
+        }
     }
-    default: {
-        transformRecursion<T, F>(in, out, twiddle, offset, 2 * stride, N / 2,
-                                 mask);
-        transformRecursion<T, F>(in, out + N / 2, twiddle, offset + stride,
-                                 4 * stride, N / 4, mask);
-        transformRecursion<T, F>(in, out + 3 * N / 4, twiddle, offset - stride,
-                                 4 * stride, N / 4, mask);
-        C u1, u3, z1, z3;
-        for (std::size_t i = 0; i < N / 4; i++) {
-            u1 = out[i];
-            u3 = out[i + N / 4];
-            z1 = out[i + N / 2] * twiddle[i * stride];
-            z3 = out[i + 3 * N / 4] * std::conj(twiddle[i * stride]);
-
-            // Calculate: data[i*S*2] = u1 + z1 + z3
-            out[i] = u1 + z1 + z3;
-
-            // Calculate: data[i*S*2 + N/2] = u1 - z1 - z3
-            out[i + N / 2] = u1 - z1 - z3;
-
-            // Calculate: data[i*S*2 + N/4] = u3 -j*(z1 - z3)
-            out[i + N / 4] = u3 + rot90<C, F>(z1 - z3);
-
-            // Calculate: data[i*S*2 + 3*N/4] = u3 + j*(z1 - z3)
-            out[i + 3 * N / 4] = u3 - rot90<C, F>(z1 - z3);
+}
+
+template <typename T, bool F>
+void executePermutedSteps(const ScheduleStep* schedule, std::size_t length,
+                          std::complex<T>* data,
+                          const std::complex<T>* twiddle, T scale = T(1))
+{
+    // Run the schedule on data that already holds the permuted input. The
+    // schedule has a combine step, the last one multiplies by scale.
+    for (std::size_t s = 0; s < length; s++) {
+        const ScheduleStep& step = schedule[s];
+        std::complex<T>* node{data + step.outIndex};
+        if (step.kind == ScheduleStep::Kind::LEAF) {
+            transformLeaf<T, F>(node, step.N,
+                                [node](std::size_t k) { return node[k]; });
+        } else {
+            combineStep<T, F>(step, s + 1 == length, node, twiddle, scale);
+        }
+    }
+}
+
+// Complex transform size from which plans and FixedFft reorder the input before
+// running the leaves, see executePermutedSchedule. The reordering pass was
+// measured to be faster than the masked gathers for every size that has a
+// combine step.
+constexpr std::size_t permutedScheduleThreshold = 2 * maxLeafSize;
+
+inline void buildPermutation(const ScheduleStep* schedule, std::size_t length,
+                             std::size_t mask, std::uint32_t* permutation)
+{
+    // Resolve the masked input offsets of all leaves. After the gather
+    // out[j] = in[permutation[j]] every leaf finds its input in natural order
+    // in the output range it is going to overwrite.
+    for (std::size_t s = 0; s < length; s++) {
+        const ScheduleStep& step = schedule[s];
+        if (step.kind != ScheduleStep::Kind::LEAF) {
+            continue;
+        }
+        for (std::size_t k = 0; k < step.N; k++) {
+            permutation[step.outIndex + k] =
+                (std::uint32_t)((step.offset + k * step.stride) & mask);
+        }
+    }
+}
+
+template <typename T>
+void permuteGather(const std::complex<T>* in, std::complex<T>* out,
+                   const std::uint32_t* permutation, std::size_t size,
+                   std::size_t inStride = 1)
+{
+    // The writes stream, the reads are scattered over the whole input. Fetch
+    // the sources a few iterations ahead to keep several misses in flight.
+    constexpr std::size_t prefetchDistance = 16;
+    std::size_t j = 0;
+#if defined(__GNUC__) || defined(__clang__)
+    for (; j + prefetchDistance < size; j++) {
+        __builtin_prefetch(in + permutation[j + prefetchDistance] * inStride);
+        out[j] = in[permutation[j] * inStride];
+    }
+#endif
+    for (; j < size; j++) {
+        out[j] = in[permutation[j] * inStride];
+    }
+}
+
+template <typename T, typename Permutation>
+void rotateCycles(std::complex<T>* data, Permutation permutation,
+                  const std::uint32_t* cycleLeaders, std::size_t cycleCount)
+{
+    // data[j] = data[permutation(j)] for all j at once. Every cycle of the
+    // permutation is rotated once starting from its leader, fixed points are
+    // not listed.
+    for (std::size_t c = 0; c < cycleCount; c++) {
+        const std::uint32_t leader{cycleLeaders[c]};
+        std::complex<T> first{data[leader]};
+        std::uint32_t current{leader};
+        for (std::uint32_t next = permutation(current); next != leader;
+             next = permutation(current)) {
+            data[current] = data[next];
+            current = next;
+        }
+        data[current] = first;
+    }
+}
+
+template <typename T>
+void permuteInPlace(std::complex<T>* data, const std::uint32_t* permutation,
+                    const std::uint32_t* cycleLeaders, std::size_t cycleCount)
+{
+    // In-place equivalent of permuteGather.
+    rotateCycles<T>(
+        data, [permutation](std::uint32_t j) { return permutation[j]; },
+        cycleLeaders, cycleCount);
+}
+
+template <typename Permutation>
+std::vector<std::uint32_t> findCycleLeaders(Permutation permutation,
+                                            std::size_t size)
+{
+    // Leaders of the non-trivial cycles of the permutation as consumed by
+    // rotateCycles. Throws std::bad_alloc.
+    std::vector<std::uint32_t> leaders;
+    std::vector<bool> visited(size, false);
+    for (std::size_t start = 0; start < size; start++) {
+        if (visited[start] || permutation((std::uint32_t)start) == start) {
+            continue;
         }
+        leaders.push_back((std::uint32_t)start);
+        for (std::size_t j = start; !visited[j];
+             j = permutation((std::uint32_t)j)) {
+            visited[j] = true;
+        }
+    }
+    return leaders;
+}
+
+inline std::vector<std::uint32_t>
+buildPermutationCycles(const std::uint32_t* permutation, std::size_t size)
+{
+    return findCycleLeaders(
+        [permutation](std::uint32_t j) { return permutation[j]; }, size);
+}
+
+// Every leaf of a transform with a combine step has 16 or 32 values, so the
+// permutation is linear within aligned blocks of this many values: entry
+// outIndex + k of a leaf is (offset + k * stride) & mask.
+constexpr std::size_t permutationBlock = maxLeafSize / 2;
+
+inline void buildPermutationBlocks(std::size_t offset, std::size_t stride,
+                                   std::size_t N, std::size_t outIndex,
+                                   std::size_t mask, std::uint32_t* bases,
+                                   std::uint32_t* strides)
+{
+    // Compressed form of buildPermutation for the nodes of buildSchedule, two
+    // values per block of permutationBlock entries:
+    // permutation[j] = (bases[b] + (j % permutationBlock) * strides[b]) & mask
+    // with b = j / permutationBlock.
+    if (N <= maxLeafSize) {
+        for (std::size_t k = 0; k < N; k += permutationBlock) {
+            const std::size_t b = (outIndex + k) / permutationBlock;
+            bases[b] = (std::uint32_t)((offset + k * stride) & mask);
+            strides[b] = (std::uint32_t)stride;
+        }
+        return;
+    }
+    buildPermutationBlocks(offset, 2 * stride, N / 2, outIndex, mask, bases,
+                           strides);
+    buildPermutationBlocks(offset + stride, 4 * stride, N / 4,
+                           outIndex + N / 2, mask, bases, strides);
+    buildPermutationBlocks(offset - stride, 4 * stride, N / 4,
+                           outIndex + 3 * N / 4, mask, bases, strides);
+}
+
+template <typename T, bool F>
+void transformPermutedNodes(std::complex<T>* data,
+                            const std::complex<T>* twiddle, std::size_t stride,
+                            std::size_t N)
+{
+    // executePermutedSteps for the schedule of buildSchedule, walking the
+    // tree instead of a stored schedule.
+    if (N <= maxLeafSize) {
+        transformLeaf<T, F>(data, N,
+                            [data](std::size_t k) { return data[k]; });
+        return;
+    }
+    transformPermutedNodes<T, F>(data, twiddle, 2 * stride, N / 2);
+    transformPermutedNodes<T, F>(data + N / 2, twiddle, 4 * stride, N / 4);
+    transformPermutedNodes<T, F>(data + 3 * N / 4, twiddle, 4 * stride, N / 4);
+    combineButterflies<T, F>(data, twiddle, stride, N);
+}
+
+template <typename T, bool F>
+void transformPermutedNodesScaled(std::complex<T>* data,
+                                  const std::complex<T>* twiddle,
+                                  std::size_t N, T scale)
+{
+    // transformPermutedNodes of the whole transform with the outputs
+    // multiplied by scale in the root combine step.
+    if (N <= maxLeafSize) {
+        transformPermutedNodes<T, F>(data, twiddle, 1, N);
+        scaleSequence<T>(data, N, scale);
+        return;
+    }
+    transformPermutedNodes<T, F>(data, twiddle, 2, N / 2);
+    transformPermutedNodes<T, F>(data + N / 2, twiddle, 4, N / 4);
+    transformPermutedNodes<T, F>(data + 3 * N / 4, twiddle, 4, N / 4);
+    combineButterfliesScaled<T, F>(data, twiddle, 1, N, scale);
+}
+
+template <typename T, bool F>
+void cfftInPlace(std::complex<T>* data, const std::complex<T>* twiddle,
+                 std::size_t nfft, T scale = T(1))
+{
+    // Transform of data in place with the full twiddle table of the free
+    // functions. The input is reordered by rotating the cycles of the leaf
+    // permutation, which is only stored in its compressed form, then the
+    // permuted schedule runs in place. Throws std::bad_alloc.
+    if (nfft > maxLeafSize) {
+        std::vector<std::uint32_t> bases(nfft / permutationBlock);
+        std::vector<std::uint32_t> strides(nfft / permutationBlock);
+        const std::size_t mask = nfft - 1;
+        buildPermutationBlocks(0, 1, nfft, 0, mask, bases.data(),
+                               strides.data());
+        auto permutation = [&bases, &strides, mask](std::uint32_t j) {
+            const std::size_t b = j / permutationBlock;
+            return (std::uint32_t)((bases[b] + (j % permutationBlock) *
+                                                   (std::size_t)strides[b]) &
+                                   mask);
+        };
+        std::vector<std::uint32_t> leaders =
+            findCycleLeaders(permutation, nfft);
+        rotateCycles<T>(data, permutation, leaders.data(), leaders.size());
     }
+    if (scale == T(1)) {
+        transformPermutedNodes<T, F>(data, twiddle, 1, nfft);
+    } else {
+        transformPermutedNodesScaled<T, F>(data, twiddle, nfft, scale);
     }
 }
 
+template <typename T, bool F>
+void executePermutedSchedule(const ScheduleStep* schedule, std::size_t length,
+                             const std::complex<T>* in, std::complex<T>* out,
+                             const std::complex<T>* twiddle,
+                             const std::uint32_t* permutation,
+                             std::size_t size, std::size_t inStride = 1,
+                             T scale = T(1))
+{
+    // Same operations as executeSchedule, but the leaves read the reordered
+    // input with unit stride from out. in and out may not alias.
+    permuteGather<T>(in, out, permutation, size, inStride);
+    executePermutedSteps<T, F>(schedule, length, out, twiddle, scale);
+}
+
 template <typename T, bool F = false>
 void cfftForward(const std::complex<T>* in, std::complex<T>* out,
-                 const std::complex<T>* twiddle, std::size_t nfft)
+                 const std::complex<T>* twiddle, std::size_t nfft,
+                 T scale = T(1))
 {
-    transformRecursion<T, F>(in, out, twiddle, (std::size_t)0, (std::size_t)1,
-                             nfft, nfft - 1);
+    if (scale == T(1)) {
+        transformRecursion<T, F>(in, out, twiddle, (std::size_t)0,
+                                 (std::size_t)1, nfft, nfft - 1);
+        return;
+    }
+    transformNodesScaled<T, F>([in](std::size_t i) { return in[i]; }, out,
+                               twiddle, 0, 1, nfft, nfft - 1, scale);
 }
 
 template <typename T, bool F = true>
 void cfftInverse(const std::complex<T>* in, std::complex<T>* out,
-                 const std::complex<T>* twiddle, std::size_t nfft)
+                 const std::complex<T>* twiddle, std::size_t nfft,
+                 T scale = T(1))
 {
-    transformRecursion<T, F>(in, out, twiddle, 0, 1, nfft, nfft - 1);
+    cfftForward<T, F>(in, out, twiddle, nfft, scale);
 }
 
 template <typename T>
@@ -231,22 +885,22 @@ void populateRfftTwiddles(std::complex<T>* twiddleFactors,
     // should only contain the even numbered entries of the twiddle factors
     // corresponding to a FFT of nfft/2. The second half should be the
     // corresponding odd entries.
-    T pi{std::acos((T)-1)};
-    for (std::size_t idx = 0; idx < nfft / 2; idx++) {
-        twiddleFactors[idx] =
-            inverseTransform ? std::exp(std::complex<T>(0, (T)(2 * idx) * (T)2 *
-                                                               pi / ((T)nfft)))
-                             : std::exp(std::complex<T>(
-                                   0, -(T)(2 * idx) * (T)2 * pi / ((T)nfft)));
-    }
-    for (std::size_t idx = nfft / 2; idx < nfft; idx++) {
-        twiddleFactors[idx] =
-            inverseTransform
-                ? std::exp(std::complex<T>(0, (T)(2 * idx + 1) * (T)2 * pi /
-                                                  ((T)nfft)))
-                : std::exp(std::complex<T>(0, -(T)(2 * idx + 1) * (T)2 * pi /
-                                                  ((T)nfft)));
-    }
+    populateUnitRoots<T>(twiddleFactors, nfft / 2, 0, 2, nfft,
+                         inverseTransform);
+    populateUnitRoots<T>(twiddleFactors + nfft / 2, nfft / 2, 1, 2, nfft,
+                         inverseTransform);
+}
+
+template <typename T>
+void populateRfftUnscrambleTwiddles(std::complex<T>* evenTwiddles,
+                                    std::complex<T>* oddTwiddles,
+                                    const std::size_t nfft,
+                                    bool inverseTransform)
+{
+    // The nfft/4 entries of both halves of populateRfftTwiddles that the
+    // unscramble and scramble steps read.
+    populateUnitRoots<T>(evenTwiddles, nfft / 4, 0, 2, nfft, inverseTransform);
+    populateUnitRoots<T>(oddTwiddles, nfft / 4, 1, 2, nfft, inverseTransform);
 }
 
 template <typename T>
@@ -272,64 +926,118 @@ void deinterleaveSequence(const std::complex<T>* in, T* out,
 }
 
 template <typename T>
-void rfftForward(std::complex<T>* in, std::complex<T>* out,
-                 const std::complex<T>* twiddleFactors, const std::size_t nfft)
+void deinterleaveSequence(const std::complex<T>* in, T* out,
+                          const std::size_t nfft, const T scale)
 {
-    using C = std::complex<T>;
-    // Perform the fft on two real sequences (encoded using the real and
-    // imaginary values of the input array) simultaneously.
-    cfftForward<T>(in, out, twiddleFactors, nfft / 2);
+    // deinterleaveSequence with the outputs multiplied by scale.
+    for (std::size_t idx = 0; idx < nfft / 2; idx++) {
+        out[2 * idx] = scale * in[idx].real();
+        out[2 * idx + 1] = scale * in[idx].imag();
+    }
+}
 
+template <typename T>
+void rfftForwardUnscramble(std::complex<T>* out,
+                           const std::complex<T>* evenTwiddles,
+                           const std::complex<T>* oddTwiddles,
+                           const std::size_t nfft, const T scale = T(1))
+{
+    // evenTwiddles[i] = w^(2i) and oddTwiddles[i] = w^(2i+1) for i < nfft/4.
+    // The half-spectrum is multiplied by scale, which is folded into the
+    // factors of one half.
+    using C = std::complex<T>;
     // Unscramble the intermediate spectrum into the symmetric half-spectrum
     // Tmp variables
     C xEven, xOdd, xEvenInv, xOddInv;
     C j{0, 1};
+    const T half{T(0.5) * scale};
     // Handle the i=0 and Nyquist case seperately
-    out[0] = std::conj(out[0]) + j * std::conj(out[0]);
+    out[0] = scale * (std::conj(out[0]) + j * std::conj(out[0]));
     out[nfft / 2].real(out[0].imag());
     out[nfft / 2].imag(0);
     out[0].imag(0);
 
     for (unsigned int idx = 1; idx < nfft / 4; ++idx) {
-        xEven = T(0.5) * (out[idx] + std::conj(out[nfft / 2 - idx]));
-        xOdd = -T(0.5) * j * (out[idx] - std::conj(out[nfft / 2 - idx]));
-        xEvenInv = T(0.5) * (out[nfft / 2 - idx] + std::conj(out[idx]));
-        xOddInv = -T(0.5) * j * (out[nfft / 2 - idx] - std::conj(out[idx]));
+        xEven = half * (out[idx] + std::conj(out[nfft / 2 - idx]));
+        xOdd = -half * j * (out[idx] - std::conj(out[nfft / 2 - idx]));
+        xEvenInv = half * (out[nfft / 2 - idx] + std::conj(out[idx]));
+        xOddInv = -half * j * (out[nfft / 2 - idx] - std::conj(out[idx]));
         // Even / Odd entry lookup of the twiddle factors. This is done to reuse
         // the twiddle factors for the cfft of size nfft/2.
         if (idx % 2 == 0) {
-            out[idx] = xEven + xOdd * twiddleFactors[idx / 2];
+            out[idx] = xEven + xOdd * evenTwiddles[idx / 2];
             out[nfft / 2 - idx] =
-                xEvenInv + xOddInv * twiddleFactors[nfft / 4 - (idx / 2)];
+                xEvenInv + xOddInv * evenTwiddles[nfft / 4 - (idx / 2)];
         } else {
-            out[idx] = xEven + xOdd * twiddleFactors[nfft / 2 + idx / 2];
+            out[idx] = xEven + xOdd * oddTwiddles[idx / 2];
             out[nfft / 2 - idx] =
                 xEvenInv +
-                xOddInv * twiddleFactors[nfft / 2 + nfft / 4 - 1 - (idx / 2)];
+                xOddInv * oddTwiddles[nfft / 4 - 1 - (idx / 2)];
         }
     }
-    xEven = T(0.5) * (out[nfft / 4] + std::conj(out[nfft / 4]));
-    xOdd = -T(0.5) * j * (out[nfft / 4] - std::conj(out[nfft / 4]));
-    out[nfft / 4] = xEven + xOdd * twiddleFactors[nfft / 8];
+    xEven = half * (out[nfft / 4] + std::conj(out[nfft / 4]));
+    xOdd = -half * j * (out[nfft / 4] - std::conj(out[nfft / 4]));
+    out[nfft / 4] = xEven + xOdd * evenTwiddles[nfft / 8];
+}
+
+template <typename T>
+void rfftForwardUnscramble(std::complex<T>* out,
+                           const std::complex<T>* twiddleFactors,
+                           const std::size_t nfft, const T scale = T(1))
+{
+    rfftForwardUnscramble<T>(out, twiddleFactors, twiddleFactors + nfft / 2,
+                             nfft, scale);
+}
+
+template <typename T>
+const std::complex<T>* complexView(const T* in)
+{
+    // std::complex<T> has the layout of T[2], so the nfft real values are
+    // already the interleaved sequence of nfft/2 complex values the
+    // half-length transform expects.
+    return reinterpret_cast<const std::complex<T>*>(in);
+}
+
+template <typename T>
+void rfftForward(const std::complex<T>* in, std::complex<T>* out,
+                 const std::complex<T>* twiddleFactors, const std::size_t nfft,
+                 const T scale = T(1))
+{
+    // Perform the fft on two real sequences (encoded using the real and
+    // imaginary values of the input array) simultaneously.
+    cfftForward<T>(in, out, twiddleFactors, nfft / 2);
+    rfftForwardUnscramble<T>(out, twiddleFactors, nfft, scale);
 }
 
 template <typename T>
 void rfftForward(const T* inputRealSequence,
-                 std::complex<T>* complexInterleavedScratch,
+                 std::complex<T>* outputHalfSpectrum,
+                 const std::complex<T>* twiddleFactors, const std::size_t nfft,
+                 const T scale = T(1))
+{
+    // The leaves read the real input through the complex view, there is no
+    // interleaved copy.
+    rfftForward<T>(complexView<T>(inputRealSequence), outputHalfSpectrum,
+                   twiddleFactors, nfft, scale);
+}
+
+template <typename T>
+void rfftForward(const T* inputRealSequence, std::complex<T>*,
                  std::complex<T>* outputHalfSpectrum,
                  const std::complex<T>* twiddleFactors, const std::size_t nfft)
 {
-    interleaveSequence<T>(inputRealSequence, complexInterleavedScratch, nfft);
-    rfftForward<T>(complexInterleavedScratch, outputHalfSpectrum,
-                   twiddleFactors, nfft);
+    // The interleaved scratch is no longer used.
+    rfftForward<T>(inputRealSequence, outputHalfSpectrum, twiddleFactors,
+                   nfft);
 }
 
 template <typename T>
-void rfftInverse(const std::complex<T>* in, std::complex<T>* scratch,
-                 std::complex<T>* out, const std::complex<T>* twiddleFactors,
-                 std::size_t nfft)
+void rfftInverseScramble(const std::complex<T>* in, std::complex<T>* scratch,
+                         const std::complex<T>* evenTwiddles,
+                         const std::complex<T>* oddTwiddles, std::size_t nfft)
 {
-    // Note that this function will overwrite the input!
+    // Fold the half-spectrum into the spectrum of the half-length complex
+    // sequence. scratch may alias in.
     using C = std::complex<T>;
     // Tmp variables
     C xEven, xOdd, xEvenInv, xOddInv;
@@ -351,111 +1059,793 @@ void rfftInverse(const std::complex<T>* in, std::complex<T>* scratch,
         // Even / Odd entry lookup of the twiddle factors. This is done to reuse
         // the twiddle factors for the cfft of size nfft/2.
         if (idx % 2 == 0) {
-            scratch[idx] = xEven + xOdd * twiddleFactors[idx / 2];
+            scratch[idx] = xEven + xOdd * evenTwiddles[idx / 2];
             scratch[nfft / 2 - idx] =
-                xEvenInv + xOddInv * twiddleFactors[nfft / 4 - (idx / 2)];
+                xEvenInv + xOddInv * evenTwiddles[nfft / 4 - (idx / 2)];
         } else {
-            scratch[idx] = xEven + xOdd * twiddleFactors[nfft / 2 + idx / 2];
+            scratch[idx] = xEven + xOdd * oddTwiddles[idx / 2];
             scratch[nfft / 2 - idx] =
                 xEvenInv +
-                xOddInv * twiddleFactors[nfft / 2 + nfft / 4 - 1 - (idx / 2)];
+                xOddInv * oddTwiddles[nfft / 4 - 1 - (idx / 2)];
         }
     }
-    xEven = T(0.5) * (in[nfft / 4] + std::conj(in[nfft / 4]));
-    xOdd = T(0.5) * j * (in[nfft / 4] - std::conj(in[nfft / 4]));
-    scratch[nfft / 4] = xEven + xOdd * twiddleFactors[nfft / 8];
+    xEven = T(0.5) * (in[nfft / 4] + std::conj(in[nfft / 4]));
+    xOdd = T(0.5) * j * (in[nfft / 4] - std::conj(in[nfft / 4]));
+    scratch[nfft / 4] = xEven + xOdd * evenTwiddles[nfft / 8];
+}
+
+template <typename T>
+void rfftInverseScramble(const std::complex<T>* in, std::complex<T>* scratch,
+                         const std::complex<T>* twiddleFactors,
+                         std::size_t nfft)
+{
+    rfftInverseScramble<T>(in, scratch, twiddleFactors,
+                           twiddleFactors + nfft / 2, nfft);
+}
+
+template <typename T>
+void rfftInverse(const std::complex<T>* in, std::complex<T>* scratch,
+                 std::complex<T>* out, const std::complex<T>* twiddleFactors,
+                 std::size_t nfft)
+{
+    // Note that this function will overwrite the input!
+    rfftInverseScramble<T>(in, scratch, twiddleFactors, nfft);
+
+    // Perform a complex valued FFT of the half-length complex sequence
+    cfftInverse(scratch, out, twiddleFactors, nfft / 2);
+}
+
+template <typename T>
+void rfftInverse(const std::complex<T>* inputHalfSpectrum,
+                 std::complex<T>* complexInterleavedScratchInput,
+                 std::complex<T>* complexInterleavedScratchOutput,
+                 T* outputRealSequence, const std::complex<T>* twiddleFactors,
+                 const std::size_t nfft, const T scale = T(1))
+{
+    // Note that the inputHalfSpectrum will be overwritten! The factor 2 of
+    // the folded spectrum and scale are applied while deinterleaving.
+    rfftInverse<T>(inputHalfSpectrum, complexInterleavedScratchInput,
+                   complexInterleavedScratchOutput, twiddleFactors, nfft);
+    deinterleaveSequence<T>(complexInterleavedScratchOutput, outputRealSequence,
+                            nfft, (T)2 * scale);
+}
+
+template <typename T>
+void periodicHann(T* out, std::size_t size)
+{
+    // 0.5 - 0.5 * cos(2 pi n / size), the periodic form whose shifts by
+    // size / 2 and size / 4 sum to a constant.
+    using L = long double;
+    const L pi{std::acos((L)-1)};
+    for (std::size_t n = 0; n < size; n++) {
+        out[n] = (T)((L)0.5 - (L)0.5 * std::cos((L)2 * pi * (L)n / (L)size));
+    }
+}
+
+template <typename T>
+void rfftForwardWindowed(const T* in, const T* window, std::complex<T>* out,
+                         const std::complex<T>* twiddleFactors,
+                         const std::size_t nfft)
+{
+    // rfftForward of in[i] * window[i]. The leaves of the half-length
+    // transform multiply the pairs of values while loading them, the
+    // windowed sequence is never stored.
+    using C = std::complex<T>;
+    transformNodes<T, false>(
+        [in, window](std::size_t i) {
+            return C(in[2 * i] * window[2 * i],
+                     in[2 * i + 1] * window[2 * i + 1]);
+        },
+        out, twiddleFactors, 0, 1, nfft / 2, nfft / 2 - 1);
+    rfftForwardUnscramble<T>(out, twiddleFactors, nfft);
+}
+
+template <typename T>
+void rfftForwardZeroPadded(const T* in, const std::size_t size,
+                           std::complex<T>* out,
+                           const std::complex<T>* twiddleFactors,
+                           const std::size_t nfft)
+{
+    // rfftForward of the size <= nfft values of in followed by zeros. The
+    // leaves load zeros past the end, the padded sequence is never stored.
+    using C = std::complex<T>;
+    transformNodes<T, false>(
+        [in, size](std::size_t i) {
+            return C(2 * i < size ? in[2 * i] : T(0),
+                     2 * i + 1 < size ? in[2 * i + 1] : T(0));
+        },
+        out, twiddleFactors, 0, 1, nfft / 2, nfft / 2 - 1);
+    rfftForwardUnscramble<T>(out, twiddleFactors, nfft);
+}
+
+template <typename T>
+void deinterleaveOverlapAdd(const std::complex<T>* in, T* out,
+                            const T* window, const std::size_t nfft)
+{
+    // out[i] += window[i] * x[i] for the deinterleaved sequence x. The
+    // window carries the factor 2 of the folded spectrum and any
+    // normalization.
+    for (std::size_t idx = 0; idx < nfft / 2; idx++) {
+        out[2 * idx] += window[2 * idx] * in[idx].real();
+        out[2 * idx + 1] += window[2 * idx + 1] * in[idx].imag();
+    }
+}
+
+template <typename T>
+void rfftInverseOverlapAdd(const std::complex<T>* in, std::complex<T>* scratch0,
+                           std::complex<T>* scratch1, T* out, const T* window,
+                           const std::complex<T>* twiddleFactors,
+                           const std::size_t nfft)
+{
+    // rfftInverse whose output is multiplied by window and added to out.
+    // The input is left untouched.
+    rfftInverseScramble<T>(in, scratch0, twiddleFactors, nfft);
+    cfftInverse<T>(scratch0, scratch1, twiddleFactors, nfft / 2);
+    deinterleaveOverlapAdd<T>(scratch1, out, window, nfft);
+}
+
+template <typename T>
+void rfftPairSplit(const std::complex<T>* spectrum, std::complex<T>* outA,
+                   std::complex<T>* outB, const std::size_t nfft,
+                   const T scale)
+{
+    // Split the spectrum Z of z = a + j b into the half-spectra
+    // A[k] = (Z[k] + conj(Z[N - k])) / 2 and B[k] = (Z[k] - conj(Z[N - k])) / 2j
+    // of the two real sequences, multiplied by scale.
+    using C = std::complex<T>;
+    const T half{T(0.5) * scale};
+    for (std::size_t k = 0; k <= nfft / 2; k++) {
+        const C zk{spectrum[k]};
+        const C zc{std::conj(spectrum[(nfft - k) & (nfft - 1)])};
+        outA[k] = half * (zk + zc);
+        const C d{half * (zk - zc)};
+        outB[k] = C(d.imag(), -d.real());
+    }
+}
+
+template <typename T>
+void rfftPairForward(const T* inA, const T* inB, std::complex<T>* outA,
+                     std::complex<T>* outB, std::complex<T>* scratch,
+                     const std::complex<T>* twiddleFactors,
+                     const std::size_t nfft, const T scale)
+{
+    // One complex transform of a + j b, the leaves pack the two sequences
+    // while loading them.
+    using C = std::complex<T>;
+    transformNodes<T, false>(
+        [inA, inB](std::size_t i) { return C(inA[i], inB[i]); }, scratch,
+        twiddleFactors, 0, 1, nfft, nfft - 1);
+    rfftPairSplit<T>(scratch, outA, outB, nfft, scale);
+}
+
+template <typename T>
+void rfftPairInverse(const std::complex<T>* inA, const std::complex<T>* inB,
+                     T* outA, T* outB, std::complex<T>* scratch,
+                     const std::complex<T>* twiddleFactors,
+                     const std::size_t nfft, const T scale)
+{
+    // The inverse transform of Z = A + j B is a + j b. The leaves merge the
+    // half-spectra while loading them, the upper half of Z follows from
+    // Z[N - k] = conj(A[k]) + j conj(B[k]).
+    using C = std::complex<T>;
+    transformNodes<T, true>(
+        [inA, inB, nfft](std::size_t i) {
+            if (i <= nfft / 2) {
+                return C(inA[i].real() - inB[i].imag(),
+                         inA[i].imag() + inB[i].real());
+            }
+            const std::size_t k{nfft - i};
+            return C(inA[k].real() + inB[k].imag(),
+                     inB[k].real() - inA[k].imag());
+        },
+        scratch, twiddleFactors, 0, 1, nfft, nfft - 1);
+    for (std::size_t i = 0; i < nfft; i++) {
+        outA[i] = scale * scratch[i].real();
+        outB[i] = scale * scratch[i].imag();
+    }
+}
+
+template <typename T>
+void scatterSequence(const std::complex<T>* in, std::complex<T>* out,
+                     std::size_t outStride, std::size_t size)
+{
+    for (std::size_t idx = 0; idx < size; idx++) {
+        out[idx * outStride] = in[idx];
+    }
+}
+
+template <typename T, bool F>
+void cfftBatch(const std::complex<T>* twiddleFactors, std::size_t nfft,
+               std::size_t howMany, const std::complex<T>* in,
+               std::size_t inStride, std::size_t inDistance,
+               std::complex<T>* out, std::size_t outStride,
+               std::size_t outDistance, std::complex<T>* scratch,
+               T scale = T(1))
+{
+    // The leaves read the strided input directly, a strided output is
+    // computed in scratch and scattered.
+    for (std::size_t b = 0; b < howMany; b++) {
+        const std::complex<T>* src{in + b * inDistance};
+        std::complex<T>* dst{out + b * outDistance};
+        std::complex<T>* result{outStride == 1 ? dst : scratch};
+        auto load = [src, inStride](std::size_t i) {
+            return src[i * inStride];
+        };
+        if (scale == T(1)) {
+            transformNodes<T, F>(load, result, twiddleFactors, 0, 1, nfft,
+                                 nfft - 1);
+        } else {
+            transformNodesScaled<T, F>(load, result, twiddleFactors, 0, 1,
+                                       nfft, nfft - 1, scale);
+        }
+        if (outStride != 1) {
+            scatterSequence<T>(result, dst, outStride, nfft);
+        }
+    }
+}
+
+template <typename T>
+void rfftForwardBatch(const std::complex<T>* twiddleFactors, std::size_t nfft,
+                      std::size_t howMany, const T* in, std::size_t inStride,
+                      std::size_t inDistance, std::complex<T>* out,
+                      std::size_t outStride, std::size_t outDistance,
+                      std::complex<T>* scratch, T scale = T(1))
+{
+    // The interleaving of the real input is folded into the leaves.
+    for (std::size_t b = 0; b < howMany; b++) {
+        const T* src{in + b * inDistance};
+        std::complex<T>* dst{out + b * outDistance};
+        std::complex<T>* result{outStride == 1 ? dst : scratch};
+        if (inStride == 1) {
+            cfftForward<T>(complexView<T>(src), result, twiddleFactors,
+                           nfft / 2);
+        } else {
+            transformNodes<T, false>(
+                [src, inStride](std::size_t i) {
+                    return std::complex<T>(src[2 * i * inStride],
+                                           src[(2 * i + 1) * inStride]);
+                },
+                result, twiddleFactors, 0, 1, nfft / 2, nfft / 2 - 1);
+        }
+        rfftForwardUnscramble<T>(result, twiddleFactors, nfft, scale);
+        if (outStride != 1) {
+            scatterSequence<T>(result, dst, outStride, nfft / 2 + 1);
+        }
+    }
+}
+
+template <typename T>
+void rfftBackwardBatch(const std::complex<T>* twiddleFactors, std::size_t nfft,
+                       std::size_t howMany, const std::complex<T>* in,
+                       std::size_t inStride, std::size_t inDistance, T* out,
+                       std::size_t outStride, std::size_t outDistance,
+                       std::complex<T>* scratch0, std::complex<T>* scratch1,
+                       T scale = T(1))
+{
+    // The factor 2 of the folded spectrum and scale are applied while
+    // deinterleaving.
+    const T factor = (T)2 * scale;
+    for (std::size_t b = 0; b < howMany; b++) {
+        const std::complex<T>* src{in + b * inDistance};
+        T* dst{out + b * outDistance};
+        if (inStride != 1) {
+            for (std::size_t idx = 0; idx < nfft / 2 + 1; idx++) {
+                scratch0[idx] = src[idx * inStride];
+            }
+            src = scratch0;
+        }
+        rfftInverseScramble<T>(src, scratch0, twiddleFactors, nfft);
+        cfftInverse<T>(scratch0, scratch1, twiddleFactors, nfft / 2);
+        for (std::size_t idx = 0; idx < nfft / 2; idx++) {
+            dst[2 * idx * outStride] = factor * scratch1[idx].real();
+            dst[(2 * idx + 1) * outStride] = factor * scratch1[idx].imag();
+        }
+    }
+}
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ * We split the library in an internal part and an external part in order to
+ * separate the implementation from the interface.
+ *
+ * ==============================================================================
+ */
+
+inline bool isRadix2(const std::size_t N) {
+    return  (N > 0) && ((N & (N - 1)) == 0);
+}
+
+enum class FFTSTATUS {
+    OK = 0,
+    INVALID_SIZE = -1,
+    NULL_POINTER = -2,
+    ALLOCATION_FAILED = -3,
+};
+
+enum class TransformType {
+    COMPLEX = 0,
+    REAL = 1,
+};
+
+enum class Direction {
+    FORWARD = 0,
+    BACKWARD = 1,
+};
+
+// Factor the output of a transform is multiplied by. The size is nfft for both
+// the complex and the real transforms, CUSTOM uses the scale passed along.
+enum class Normalization {
+    NONE = 0,
+    BY_SIZE = 1,
+    BY_SQRT_SIZE = 2,
+    CUSTOM = 3,
+};
+
+namespace internal {
+template <typename T>
+T normalizationScale(const Normalization normalization, const std::size_t nfft,
+                     const T customScale)
+{
+    switch (normalization) {
+    case Normalization::BY_SIZE:
+        return T(1) / (T)nfft;
+    case Normalization::BY_SQRT_SIZE:
+        return (T)(1.0L / std::sqrt((long double)nfft));
+    case Normalization::CUSTOM:
+        return customScale;
+    default:
+        return T(1);
+    }
+}
+} // namespace internal
+
+template <typename T>
+FFTSTATUS
+populateCfftTwiddleFactorsForward(const std::size_t nfft,
+                                  std::complex<T>* twiddleFactors,
+                                  const std::size_t twiddleFactorSize) noexcept
+{
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::populateCfftTwiddles<T>(twiddleFactors, nfft, false);
+
+    return FFTSTATUS::OK;
+}
+
+template <typename T>
+FFTSTATUS
+populateCfftTwiddleFactorsBackward(const std::size_t nfft,
+                                   std::complex<T>* twiddleFactors,
+                                   const std::size_t twiddleFactorSize) noexcept
+{
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::populateCfftTwiddles<T>(twiddleFactors, nfft, true);
+
+    return FFTSTATUS::OK;
+}
+
+template <typename T>
+FFTSTATUS
+populateRfftTwiddleFactorsForward(const std::size_t nfft,
+                                  std::complex<T>* twiddleFactors,
+                                  const std::size_t twiddleFactorSize) noexcept
+{
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactorSize != nfft) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::populateRfftTwiddles<T>(twiddleFactors, nfft, false);
+
+    return FFTSTATUS::OK;
+}
+
+template <typename T>
+FFTSTATUS
+populateRfftTwiddleFactorsBackward(const std::size_t nfft,
+                                   std::complex<T>* twiddleFactors,
+                                   const std::size_t twiddleFactorSize) noexcept
+{
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactorSize != nfft) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::populateRfftTwiddles<T>(twiddleFactors, nfft, true);
+
+    return FFTSTATUS::OK;
+}
+
+// Complex transforms with the output multiplied by the normalization factor.
+// The factor is applied by the last combine step, there is no separate
+// scaling pass. Without a normalization the transforms are unnormalized.
+template <typename T>
+FFTSTATUS performCfftForward(const std::size_t nfft,
+                             const std::complex<T>* twiddleFactors,
+                             const std::size_t twiddleFactorSize,
+                             const std::complex<T>* in,
+                             const std::size_t inSize, std::complex<T>* out,
+                             const std::size_t outSize,
+                             const Normalization normalization =
+                                 Normalization::NONE,
+                             const T customScale = T(1))
+{
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != inSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != outSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (in == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::cfftForward<T>(
+        in, out, twiddleFactors, nfft,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
+
+    return FFTSTATUS::OK;
+}
+
+template <typename T>
+FFTSTATUS performCfftBackward(const std::size_t nfft,
+                              const std::complex<T>* twiddleFactors,
+                              const std::size_t twiddleFactorSize,
+                              const std::complex<T>* in,
+                              const std::size_t inSize, std::complex<T>* out,
+                              const std::size_t outSize,
+                              const Normalization normalization =
+                                  Normalization::NONE,
+                              const T customScale = T(1))
+{
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != inSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != outSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (in == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::cfftInverse<T>(
+        in, out, twiddleFactors, nfft,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
+
+    return FFTSTATUS::OK;
+}
+
+// In-place complex transforms of the nfft values in data, with the twiddle
+// factors of performCfftForward / performCfftBackward. The results match the
+// out-of-place functions up to rounding, the leaves are inlined separately.
+// Instead of a second buffer the reordering of the input needs less than one
+// byte of bookkeeping per value.
+template <typename T>
+FFTSTATUS performCfftForwardInPlace(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, std::complex<T>* data,
+    const std::size_t dataSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
+{
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != dataSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    // The permutation is handled with 32 bit indices.
+    if (nfft - 1 > std::numeric_limits<std::uint32_t>::max()) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (data == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    try {
+        internal::cfftInPlace<T, false>(
+            data, twiddleFactors, nfft,
+            internal::normalizationScale<T>(normalization, nfft,
+                                            customScale));
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+
+    return FFTSTATUS::OK;
+}
+
+template <typename T>
+FFTSTATUS performCfftBackwardInPlace(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, std::complex<T>* data,
+    const std::size_t dataSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
+{
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != dataSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    // The permutation is handled with 32 bit indices.
+    if (nfft - 1 > std::numeric_limits<std::uint32_t>::max()) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
 
-    // Perform a complex valued FFT of the half-length complex sequence
-    cfftInverse(scratch, out, twiddleFactors, nfft / 2);
-}
+    if (twiddleFactors == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
 
-template <typename T>
-void rfftInverse(const std::complex<T>* inputHalfSpectrum,
-                 std::complex<T>* complexInterleavedScratchInput,
-                 std::complex<T>* complexInterleavedScratchOutput,
-                 T* outputRealSequence, const std::complex<T>* twiddleFactors,
-                 const std::size_t nfft)
-{
-    // Note that the inputHalfSpectrum will be overwritten!
-    rfftInverse<T>(inputHalfSpectrum, complexInterleavedScratchInput,
-                   complexInterleavedScratchOutput, twiddleFactors, nfft);
-    deinterleaveSequence<T>(complexInterleavedScratchOutput, outputRealSequence,
-                            nfft);
-    for (size_t idx = 0; idx < nfft; idx++) {
-        outputRealSequence[idx] *= (T)(2);
+    if (data == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
     }
-}
-} // namespace internal
 
-/*
- * ==============================================================================
- *
- * Public API
- * We split the library in an internal part and an external part in order to
- * separate the implementation from the interface.
- *
- * ==============================================================================
- */
+    try {
+        internal::cfftInPlace<T, true>(
+            data, twiddleFactors, nfft,
+            internal::normalizationScale<T>(normalization, nfft,
+                                            customScale));
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
 
-inline bool isRadix2(const std::size_t N) {
-    return  (N > 0) && ((N & (N - 1)) == 0);
+    return FFTSTATUS::OK;
 }
 
-enum class FFTSTATUS {
-    OK = 0,
-    INVALID_SIZE = -1,
-    NULL_POINTER = -2,
-};
-
+// Forward real transform without scratch space, which it does not need: the
+// leaves of the half-length complex transform read the real input as
+// interleaved complex values. The normalization is applied while unscrambling
+// the half-spectrum.
 template <typename T>
-FFTSTATUS
-populateCfftTwiddleFactorsForward(const std::size_t nfft,
-                                  std::complex<T>* twiddleFactors,
-                                  const std::size_t twiddleFactorSize) noexcept
+FFTSTATUS performRfftForward(const std::size_t nfft,
+                             const std::complex<T>* twiddleFactors,
+                             const std::size_t twiddleFactorSize, const T* in,
+                             const std::size_t inSize, std::complex<T>* out,
+                             const std::size_t outSize,
+                             const Normalization normalization =
+                                 Normalization::NONE,
+                             const T customScale = T(1))
 {
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
     if (nfft != twiddleFactorSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
+    if (nfft != inSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (outSize != (nfft / 2 + 1)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft < internal::minimumRfftSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
     if (twiddleFactors == nullptr) {
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::populateCfftTwiddles<T>(twiddleFactors, nfft, false);
+    if (in == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::rfftForward<T>(
+        in, out, twiddleFactors, nfft,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
+// Deprecated, use the overload without scratch above. Kept for existing
+// callers, scratch and scratchSize are ignored.
+template <typename T>
+FFTSTATUS performRfftForward(const std::size_t nfft,
+                             std::complex<T>* twiddleFactors,
+                             const std::size_t twiddleFactorSize, const T* in,
+                             const std::size_t inSize, std::complex<T>* out,
+                             const std::size_t outSize,
+                             std::complex<T>* scratch, std::size_t scratchSize)
+{
+    (void)scratch;
+    (void)scratchSize;
+    return performRfftForward<T>(
+        nfft, static_cast<const std::complex<T>*>(twiddleFactors),
+        twiddleFactorSize, in, inSize, out, outSize);
+}
+
+// The normalization is applied while deinterleaving the real output, together
+// with the factor 2 of the folded half-spectrum.
 template <typename T>
 FFTSTATUS
-populateCfftTwiddleFactorsBackward(const std::size_t nfft,
-                                   std::complex<T>* twiddleFactors,
-                                   const std::size_t twiddleFactorSize) noexcept
+performRfftBackward(const std::size_t nfft, std::complex<T>* twiddleFactors,
+                    const std::size_t twiddleFactorSize,
+                    const std::complex<T>* in, const std::size_t inSize, T* out,
+                    const std::size_t outSize, std::complex<T>* scratch0,
+                    std::complex<T>* scratch1, std::size_t scratchSize,
+                    const Normalization normalization = Normalization::NONE,
+                    const T customScale = T(1))
 {
+    if (!isRadix2(nfft) || nfft < internal::minimumRfftSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
     if (nfft != twiddleFactorSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
+    if ((nfft / 2 + 1) != inSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != outSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (scratchSize != (nfft / 2 + 1)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
     if (twiddleFactors == nullptr) {
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::populateCfftTwiddles<T>(twiddleFactors, nfft, true);
+    if (in == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (scratch0 == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (scratch1 == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::rfftInverse<T>(
+        in, scratch0, scratch1, out, twiddleFactors, nfft,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
 template <typename T>
-FFTSTATUS
-populateRfftTwiddleFactorsForward(const std::size_t nfft,
-                                  std::complex<T>* twiddleFactors,
-                                  const std::size_t twiddleFactorSize) noexcept
+FFTSTATUS performRfftBackwardWithInputAsScratch(
+    const std::size_t nfft, std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, std::complex<T>* in,
+    const std::size_t inSize, T* out, const std::size_t outSize,
+    std::complex<T>* scratch, std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
+{
+    FFTSTATUS status;
+    status = performRfftBackward<T>(nfft, twiddleFactors, twiddleFactorSize, in,
+                                    inSize, out, outSize, in, scratch,
+                                    scratchSize, normalization, customScale);
+
+    return status;
+}
+
+// Two real sequences of nfft values transformed at once: one complex transform
+// of inA + j inB with the twiddle factors of performCfftForward, followed by a
+// split into the two half-spectra of nfft / 2 + 1 values. The split step
+// applies the normalization. scratch holds nfft values.
+template <typename T>
+FFTSTATUS performRfftPairForward(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, const T* inA, const T* inB,
+    const std::size_t inSize, std::complex<T>* outA, std::complex<T>* outB,
+    const std::size_t outSize, std::complex<T>* scratch,
+    const std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
 {
     if (!isRadix2(nfft)) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (twiddleFactorSize != nfft) {
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != inSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (outSize != (nfft / 2 + 1)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (scratchSize != nfft) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -463,22 +1853,63 @@ populateRfftTwiddleFactorsForward(const std::size_t nfft,
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::populateRfftTwiddles<T>(twiddleFactors, nfft, false);
+    if (inA == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (inB == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (outA == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (outB == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (scratch == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::rfftPairForward<T>(
+        inA, inB, outA, outB, scratch, twiddleFactors, nfft,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
+// Inverse of performRfftPairForward with the twiddle factors of
+// performCfftBackward, unnormalized like performRfftBackward. The half-spectra
+// are not modified, scratch holds nfft values.
 template <typename T>
-FFTSTATUS
-populateRfftTwiddleFactorsBackward(const std::size_t nfft,
-                                   std::complex<T>* twiddleFactors,
-                                   const std::size_t twiddleFactorSize) noexcept
+FFTSTATUS performRfftPairBackward(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, const std::complex<T>* inA,
+    const std::complex<T>* inB, const std::size_t inSize, T* outA, T* outB,
+    const std::size_t outSize, std::complex<T>* scratch,
+    const std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
 {
     if (!isRadix2(nfft)) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (twiddleFactorSize != nfft) {
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (inSize != (nfft / 2 + 1)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != outSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (scratchSize != nfft) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -486,27 +1917,62 @@ populateRfftTwiddleFactorsBackward(const std::size_t nfft,
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::populateRfftTwiddles<T>(twiddleFactors, nfft, true);
+    if (inA == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (inB == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (outA == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (outB == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    if (scratch == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::rfftPairInverse<T>(
+        inA, inB, outA, outB, scratch, twiddleFactors, nfft,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
+// Batched transforms of howMany sequences sharing one twiddle table. Value i of
+// sequence b is read from in[b * inDistance + i * inStride] and written to
+// out[b * outDistance + i * outStride]. The arguments are validated once for
+// the whole batch. scratch of nfft values is only used, and only required,
+// when outStride != 1. in and out may not overlap.
 template <typename T>
-FFTSTATUS performCfftForward(const std::size_t nfft,
-                             std::complex<T>* twiddleFactors,
-                             const std::size_t twiddleFactorSize,
-                             std::complex<T>* in, const std::size_t inSize,
-                             std::complex<T>* out, const std::size_t outSize)
+FFTSTATUS performCfftForwardBatch(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, const std::size_t howMany,
+    const std::complex<T>* in, const std::size_t inStride,
+    const std::size_t inDistance, std::complex<T>* out,
+    const std::size_t outStride, const std::size_t outDistance,
+    std::complex<T>* scratch, const std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
 {
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
     if (nfft != twiddleFactorSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (nfft != inSize) {
+    if (inStride == 0 || outStride == 0) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (nfft != outSize) {
+    if (outStride != 1 && scratchSize != nfft) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -522,27 +1988,42 @@ FFTSTATUS performCfftForward(const std::size_t nfft,
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::cfftForward<T>(in, out, twiddleFactors, nfft);
+    if (outStride != 1 && scratch == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::cfftBatch<T, false>(
+        twiddleFactors, nfft, howMany, in, inStride, inDistance, out,
+        outStride, outDistance, scratch,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
 template <typename T>
-FFTSTATUS performCfftBackward(const std::size_t nfft,
-                              std::complex<T>* twiddleFactors,
-                              const std::size_t twiddleFactorSize,
-                              std::complex<T>* in, const std::size_t inSize,
-                              std::complex<T>* out, const std::size_t outSize)
+FFTSTATUS performCfftBackwardBatch(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, const std::size_t howMany,
+    const std::complex<T>* in, const std::size_t inStride,
+    const std::size_t inDistance, std::complex<T>* out,
+    const std::size_t outStride, const std::size_t outDistance,
+    std::complex<T>* scratch, const std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
 {
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
     if (nfft != twiddleFactorSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (nfft != inSize) {
+    if (inStride == 0 || outStride == 0) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (nfft != outSize) {
+    if (outStride != 1 && scratchSize != nfft) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -558,20 +2039,35 @@ FFTSTATUS performCfftBackward(const std::size_t nfft,
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::cfftInverse<T>(in, out, twiddleFactors, nfft);
+    if (outStride != 1 && scratch == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::cfftBatch<T, true>(
+        twiddleFactors, nfft, howMany, in, inStride, inDistance, out,
+        outStride, outDistance, scratch,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
+// Batched real forward transforms, the layout arguments are the ones of
+// performCfftForwardBatch with the input counted in real values and the
+// output in complex values. Every sequence has nfft real inputs and
+// nfft / 2 + 1 outputs, nfft has to be at least 8. scratch of nfft / 2 + 1
+// values is only used, and only required, when outStride != 1.
 template <typename T>
-FFTSTATUS performRfftForward(const std::size_t nfft,
-                             std::complex<T>* twiddleFactors,
-                             const std::size_t twiddleFactorSize, const T* in,
-                             const std::size_t inSize, std::complex<T>* out,
-                             const std::size_t outSize,
-                             std::complex<T>* scratch, std::size_t scratchSize)
+FFTSTATUS performRfftForwardBatch(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, const std::size_t howMany,
+    const T* in, const std::size_t inStride, const std::size_t inDistance,
+    std::complex<T>* out, const std::size_t outStride,
+    const std::size_t outDistance, std::complex<T>* scratch,
+    const std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
 {
-    if (!isRadix2(nfft)) {
+    if (!isRadix2(nfft) || nfft < internal::minimumRfftSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -579,15 +2075,11 @@ FFTSTATUS performRfftForward(const std::size_t nfft,
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (nfft != inSize) {
-        return FFTSTATUS::INVALID_SIZE;
-    }
-
-    if (outSize != (nfft / 2 + 1)) {
+    if (inStride == 0 || outStride == 0) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (scratchSize != (nfft / 2 + 1)) {
+    if (outStride != 1 && scratchSize != (nfft / 2 + 1)) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -603,32 +2095,41 @@ FFTSTATUS performRfftForward(const std::size_t nfft,
         return FFTSTATUS::NULL_POINTER;
     }
 
-    if (scratch == nullptr) {
+    if (outStride != 1 && scratch == nullptr) {
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::rfftForward<T>(in, scratch, out, twiddleFactors, nfft);
+    internal::rfftForwardBatch<T>(
+        twiddleFactors, nfft, howMany, in, inStride, inDistance, out,
+        outStride, outDistance, scratch,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
 
+// Batched real backward transforms of nfft / 2 + 1 complex inputs into nfft
+// real outputs per sequence, normalized like performRfftBackward. The
+// input is not modified. Both scratch spaces hold nfft / 2 + 1 values.
 template <typename T>
-FFTSTATUS
-performRfftBackward(const std::size_t nfft, std::complex<T>* twiddleFactors,
-                    const std::size_t twiddleFactorSize,
-                    const std::complex<T>* in, const std::size_t inSize, T* out,
-                    const std::size_t outSize, std::complex<T>* scratch0,
-                    std::complex<T>* scratch1, std::size_t scratchSize)
+FFTSTATUS performRfftBackwardBatch(
+    const std::size_t nfft, const std::complex<T>* twiddleFactors,
+    const std::size_t twiddleFactorSize, const std::size_t howMany,
+    const std::complex<T>* in, const std::size_t inStride,
+    const std::size_t inDistance, T* out, const std::size_t outStride,
+    const std::size_t outDistance, std::complex<T>* scratch0,
+    std::complex<T>* scratch1, const std::size_t scratchSize,
+    const Normalization normalization = Normalization::NONE,
+    const T customScale = T(1))
 {
-    if (nfft != twiddleFactorSize) {
+    if (!isRadix2(nfft) || nfft < internal::minimumRfftSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if ((nfft / 2 + 1) != inSize) {
+    if (nfft != twiddleFactorSize) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
-    if (nfft != outSize) {
+    if (inStride == 0 || outStride == 0) {
         return FFTSTATUS::INVALID_SIZE;
     }
 
@@ -656,23 +2157,11 @@ performRfftBackward(const std::size_t nfft, std::complex<T>* twiddleFactors,
         return FFTSTATUS::NULL_POINTER;
     }
 
-    internal::rfftInverse<T>(in, scratch0, scratch1, out, twiddleFactors, nfft);
+    internal::rfftBackwardBatch<T>(
+        twiddleFactors, nfft, howMany, in, inStride, inDistance, out,
+        outStride, outDistance, scratch0, scratch1,
+        internal::normalizationScale<T>(normalization, nfft, customScale));
 
     return FFTSTATUS::OK;
 }
-
-template <typename T>
-FFTSTATUS performRfftBackwardWithInputAsScratch(
-    const std::size_t nfft, std::complex<T>* twiddleFactors,
-    const std::size_t twiddleFactorSize, std::complex<T>* in,
-    const std::size_t inSize, T* out, const std::size_t outSize,
-    std::complex<T>* scratch, std::size_t scratchSize)
-{
-    FFTSTATUS status;
-    status =
-        performRfftBackward<T>(nfft, twiddleFactors, twiddleFactorSize, in,
-                               inSize, out, outSize, in, scratch, scratchSize);
-
-    return status;
-}
 } // namespace splitradixfft
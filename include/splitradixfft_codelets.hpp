@@ -0,0 +1,1551 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_codelets.hpp
+ * Generated by tools/generate_codelets.cpp, do not edit. Regenerate with
+ * cmake --build <build dir> --target codelets
+ *
+ * Straight-line conjugate-pair split-radix leaves. load(k) returns the k-th
+ * input value, all inputs are read before the first output is written.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include <complex>
+
+namespace splitradixfft {
+namespace internal {
+
+// 144 additions, 24 multiplications
+template <typename T, typename Load>
+inline void leaf16Forward(std::complex<T>* out, Load load)
+{
+    using C = std::complex<T>;
+    constexpr T k0{T(0.707106781186547524382L)};
+    constexpr T k1{T(0.382683432365089771723L)};
+    constexpr T k2{T(0.923879532511286756101L)};
+    const C x0{load(0)};
+    const C x1{load(1)};
+    const C x2{load(2)};
+    const C x3{load(3)};
+    const C x4{load(4)};
+    const C x5{load(5)};
+    const C x6{load(6)};
+    const C x7{load(7)};
+    const C x8{load(8)};
+    const C x9{load(9)};
+    const C x10{load(10)};
+    const C x11{load(11)};
+    const C x12{load(12)};
+    const C x13{load(13)};
+    const C x14{load(14)};
+    const C x15{load(15)};
+    const T t0{x0.real() + x8.real()};
+    const T t1{x4.real() + x12.real()};
+    const T t2{t0 + t1};
+    const T t3{x2.real() + x10.real()};
+    const T t4{x6.real() + x14.real()};
+    const T t5{t3 + t4};
+    const T t6{t2 + t5};
+    const T t7{x1.real() + x9.real()};
+    const T t8{x5.real() + x13.real()};
+    const T t9{t7 + t8};
+    const T t10{x7.real() + x15.real()};
+    const T t11{x3.real() + x11.real()};
+    const T t12{t10 + t11};
+    const T t13{t9 + t12};
+    const T t14{t6 + t13};
+    const T t15{x0.imag() + x8.imag()};
+    const T t16{x4.imag() + x12.imag()};
+    const T t17{t15 + t16};
+    const T t18{x2.imag() + x10.imag()};
+    const T t19{x6.imag() + x14.imag()};
+    const T t20{t18 + t19};
+    const T t21{t17 + t20};
+    const T t22{x1.imag() + x9.imag()};
+    const T t23{x5.imag() + x13.imag()};
+    const T t24{t22 + t23};
+    const T t25{x7.imag() + x15.imag()};
+    const T t26{x3.imag() + x11.imag()};
+    const T t27{t25 + t26};
+    const T t28{t24 + t27};
+    const T t29{t21 + t28};
+    const T t30{x0.real() - x8.real()};
+    const T t31{x4.imag() - x12.imag()};
+    const T t32{t30 + t31};
+    const T t33{x2.real() - x10.real()};
+    const T t34{x2.imag() - x10.imag()};
+    const T t35{t33 + t34};
+    const T t36{k0 * t35};
+    const T t37{x14.real() - x6.real()};
+    const T t38{x14.imag() - x6.imag()};
+    const T t39{t37 - t38};
+    const T t40{k0 * t39};
+    const T t41{t36 + t40};
+    const T t42{t32 + t41};
+    const T t43{x1.imag() - x9.imag()};
+    const T t44{x5.real() - x13.real()};
+    const T t45{t43 - t44};
+    const T t46{k1 * t45};
+    const T t47{x1.real() - x9.real()};
+    const T t48{x5.imag() - x13.imag()};
+    const T t49{t47 + t48};
+    const T t50{k2 * t49};
+    const T t51{t46 + t50};
+    const T t52{x15.real() - x7.real()};
+    const T t53{x3.imag() - x11.imag()};
+    const T t54{t52 + t53};
+    const T t55{k2 * t54};
+    const T t56{x15.imag() - x7.imag()};
+    const T t57{x3.real() - x11.real()};
+    const T t58{t56 - t57};
+    const T t59{k1 * t58};
+    const T t60{t55 - t59};
+    const T t61{t51 + t60};
+    const T t62{t42 + t61};
+    const T t63{x0.imag() - x8.imag()};
+    const T t64{x4.real() - x12.real()};
+    const T t65{t63 - t64};
+    const T t66{t34 - t33};
+    const T t67{k0 * t66};
+    const T t68{t37 + t38};
+    const T t69{k0 * t68};
+    const T t70{t67 + t69};
+    const T t71{t65 + t70};
+    const T t72{k2 * t45};
+    const T t73{k1 * t49};
+    const T t74{t72 - t73};
+    const T t75{k2 * t58};
+    const T t76{k1 * t54};
+    const T t77{t75 + t76};
+    const T t78{t74 + t77};
+    const T t79{t71 + t78};
+    const T t80{t0 - t1};
+    const T t81{t18 - t19};
+    const T t82{t80 + t81};
+    const T t83{t7 - t8};
+    const T t84{t22 - t23};
+    const T t85{t83 + t84};
+    const T t86{k0 * t85};
+    const T t87{t10 - t11};
+    const T t88{t25 - t26};
+    const T t89{t87 - t88};
+    const T t90{k0 * t89};
+    const T t91{t86 + t90};
+    const T t92{t82 + t91};
+    const T t93{t15 - t16};
+    const T t94{t3 - t4};
+    const T t95{t93 - t94};
+    const T t96{t84 - t83};
+    const T t97{k0 * t96};
+    const T t98{t87 + t88};
+    const T t99{k0 * t98};
+    const T t100{t97 + t99};
+    const T t101{t95 + t100};
+    const T t102{t30 - t31};
+    const T t103{t67 - t69};
+    const T t104{t102 + t103};
+    const T t105{t43 + t44};
+    const T t106{k2 * t105};
+    const T t107{t47 - t48};
+    const T t108{k1 * t107};
+    const T t109{t106 + t108};
+    const T t110{t52 - t53};
+    const T t111{k1 * t110};
+    const T t112{t56 + t57};
+    const T t113{k2 * t112};
+    const T t114{t111 - t113};
+    const T t115{t109 + t114};
+    const T t116{t104 + t115};
+    const T t117{t63 + t64};
+    const T t118{t36 - t40};
+    const T t119{t117 - t118};
+    const T t120{k1 * t105};
+    const T t121{k2 * t107};
+    const T t122{t120 - t121};
+    const T t123{k1 * t112};
+    const T t124{k2 * t110};
+    const T t125{t123 + t124};
+    const T t126{t122 + t125};
+    const T t127{t119 + t126};
+    const T t128{t2 - t5};
+    const T t129{t24 - t27};
+    const T t130{t128 + t129};
+    const T t131{t17 - t20};
+    const T t132{t9 - t12};
+    const T t133{t131 - t132};
+    const T t134{t32 - t41};
+    const T t135{t74 - t77};
+    const T t136{t134 + t135};
+    const T t137{t65 - t70};
+    const T t138{t51 - t60};
+    const T t139{t137 - t138};
+    const T t140{t80 - t81};
+    const T t141{t97 - t99};
+    const T t142{t140 + t141};
+    const T t143{t93 + t94};
+    const T t144{t86 - t90};
+    const T t145{t143 - t144};
+    const T t146{t102 - t103};
+    const T t147{t122 - t125};
+    const T t148{t146 + t147};
+    const T t149{t117 + t118};
+    const T t150{t109 - t114};
+    const T t151{t149 - t150};
+    const T t152{t6 - t13};
+    const T t153{t21 - t28};
+    const T t154{t42 - t61};
+    const T t155{t71 - t78};
+    const T t156{t82 - t91};
+    const T t157{t95 - t100};
+    const T t158{t104 - t115};
+    const T t159{t119 - t126};
+    const T t160{t128 - t129};
+    const T t161{t131 + t132};
+    const T t162{t134 - t135};
+    const T t163{t137 + t138};
+    const T t164{t140 - t141};
+    const T t165{t143 + t144};
+    const T t166{t146 - t147};
+    const T t167{t149 + t150};
+    out[0] = C(t14, t29);
+    out[1] = C(t62, t79);
+    out[2] = C(t92, t101);
+    out[3] = C(t116, t127);
+    out[4] = C(t130, t133);
+    out[5] = C(t136, t139);
+    out[6] = C(t142, t145);
+    out[7] = C(t148, t151);
+    out[8] = C(t152, t153);
+    out[9] = C(t154, t155);
+    out[10] = C(t156, t157);
+    out[11] = C(t158, t159);
+    out[12] = C(t160, t161);
+    out[13] = C(t162, t163);
+    out[14] = C(t164, t165);
+    out[15] = C(t166, t167);
+}
+
+// 144 additions, 24 multiplications
+template <typename T, typename Load>
+inline void leaf16Backward(std::complex<T>* out, Load load)
+{
+    using C = std::complex<T>;
+    constexpr T k0{T(0.707106781186547524382L)};
+    constexpr T k1{T(0.923879532511286756101L)};
+    constexpr T k2{T(0.382683432365089771723L)};
+    const C x0{load(0)};
+    const C x1{load(1)};
+    const C x2{load(2)};
+    const C x3{load(3)};
+    const C x4{load(4)};
+    const C x5{load(5)};
+    const C x6{load(6)};
+    const C x7{load(7)};
+    const C x8{load(8)};
+    const C x9{load(9)};
+    const C x10{load(10)};
+    const C x11{load(11)};
+    const C x12{load(12)};
+    const C x13{load(13)};
+    const C x14{load(14)};
+    const C x15{load(15)};
+    const T t0{x0.real() + x8.real()};
+    const T t1{x4.real() + x12.real()};
+    const T t2{t0 + t1};
+    const T t3{x2.real() + x10.real()};
+    const T t4{x6.real() + x14.real()};
+    const T t5{t3 + t4};
+    const T t6{t2 + t5};
+    const T t7{x1.real() + x9.real()};
+    const T t8{x5.real() + x13.real()};
+    const T t9{t7 + t8};
+    const T t10{x7.real() + x15.real()};
+    const T t11{x3.real() + x11.real()};
+    const T t12{t10 + t11};
+    const T t13{t9 + t12};
+    const T t14{t6 + t13};
+    const T t15{x0.imag() + x8.imag()};
+    const T t16{x4.imag() + x12.imag()};
+    const T t17{t15 + t16};
+    const T t18{x2.imag() + x10.imag()};
+    const T t19{x6.imag() + x14.imag()};
+    const T t20{t18 + t19};
+    const T t21{t17 + t20};
+    const T t22{x1.imag() + x9.imag()};
+    const T t23{x5.imag() + x13.imag()};
+    const T t24{t22 + t23};
+    const T t25{x7.imag() + x15.imag()};
+    const T t26{x3.imag() + x11.imag()};
+    const T t27{t25 + t26};
+    const T t28{t24 + t27};
+    const T t29{t21 + t28};
+    const T t30{x0.real() - x8.real()};
+    const T t31{x4.imag() - x12.imag()};
+    const T t32{t30 - t31};
+    const T t33{x2.real() - x10.real()};
+    const T t34{x2.imag() - x10.imag()};
+    const T t35{t33 - t34};
+    const T t36{k0 * t35};
+    const T t37{x14.real() - x6.real()};
+    const T t38{x14.imag() - x6.imag()};
+    const T t39{t37 + t38};
+    const T t40{k0 * t39};
+    const T t41{t36 + t40};
+    const T t42{t32 + t41};
+    const T t43{x1.real() - x9.real()};
+    const T t44{x5.imag() - x13.imag()};
+    const T t45{t43 - t44};
+    const T t46{k1 * t45};
+    const T t47{x1.imag() - x9.imag()};
+    const T t48{x5.real() - x13.real()};
+    const T t49{t47 + t48};
+    const T t50{k2 * t49};
+    const T t51{t46 - t50};
+    const T t52{x15.imag() - x7.imag()};
+    const T t53{x3.real() - x11.real()};
+    const T t54{t52 + t53};
+    const T t55{k2 * t54};
+    const T t56{x15.real() - x7.real()};
+    const T t57{x3.imag() - x11.imag()};
+    const T t58{t56 - t57};
+    const T t59{k1 * t58};
+    const T t60{t55 + t59};
+    const T t61{t51 + t60};
+    const T t62{t42 + t61};
+    const T t63{x0.imag() - x8.imag()};
+    const T t64{x4.real() - x12.real()};
+    const T t65{t63 + t64};
+    const T t66{t33 + t34};
+    const T t67{k0 * t66};
+    const T t68{t38 - t37};
+    const T t69{k0 * t68};
+    const T t70{t67 + t69};
+    const T t71{t65 + t70};
+    const T t72{k1 * t49};
+    const T t73{k2 * t45};
+    const T t74{t72 + t73};
+    const T t75{k1 * t54};
+    const T t76{k2 * t58};
+    const T t77{t75 - t76};
+    const T t78{t74 + t77};
+    const T t79{t71 + t78};
+    const T t80{t0 - t1};
+    const T t81{t18 - t19};
+    const T t82{t80 - t81};
+    const T t83{t7 - t8};
+    const T t84{t22 - t23};
+    const T t85{t83 - t84};
+    const T t86{k0 * t85};
+    const T t87{t10 - t11};
+    const T t88{t25 - t26};
+    const T t89{t87 + t88};
+    const T t90{k0 * t89};
+    const T t91{t86 + t90};
+    const T t92{t82 + t91};
+    const T t93{t15 - t16};
+    const T t94{t3 - t4};
+    const T t95{t93 + t94};
+    const T t96{t83 + t84};
+    const T t97{k0 * t96};
+    const T t98{t88 - t87};
+    const T t99{k0 * t98};
+    const T t100{t97 + t99};
+    const T t101{t95 + t100};
+    const T t102{t30 + t31};
+    const T t103{t67 - t69};
+    const T t104{t102 - t103};
+    const T t105{t43 + t44};
+    const T t106{k2 * t105};
+    const T t107{t47 - t48};
+    const T t108{k1 * t107};
+    const T t109{t106 - t108};
+    const T t110{t52 - t53};
+    const T t111{k1 * t110};
+    const T t112{t56 + t57};
+    const T t113{k2 * t112};
+    const T t114{t111 + t113};
+    const T t115{t109 + t114};
+    const T t116{t104 + t115};
+    const T t117{t63 - t64};
+    const T t118{t36 - t40};
+    const T t119{t117 + t118};
+    const T t120{k2 * t107};
+    const T t121{k1 * t105};
+    const T t122{t120 + t121};
+    const T t123{k2 * t110};
+    const T t124{k1 * t112};
+    const T t125{t123 - t124};
+    const T t126{t122 + t125};
+    const T t127{t119 + t126};
+    const T t128{t2 - t5};
+    const T t129{t24 - t27};
+    const T t130{t128 - t129};
+    const T t131{t17 - t20};
+    const T t132{t9 - t12};
+    const T t133{t131 + t132};
+    const T t134{t32 - t41};
+    const T t135{t74 - t77};
+    const T t136{t134 - t135};
+    const T t137{t65 - t70};
+    const T t138{t51 - t60};
+    const T t139{t137 + t138};
+    const T t140{t80 + t81};
+    const T t141{t97 - t99};
+    const T t142{t140 - t141};
+    const T t143{t93 - t94};
+    const T t144{t86 - t90};
+    const T t145{t143 + t144};
+    const T t146{t102 + t103};
+    const T t147{t122 - t125};
+    const T t148{t146 - t147};
+    const T t149{t117 - t118};
+    const T t150{t109 - t114};
+    const T t151{t149 + t150};
+    const T t152{t6 - t13};
+    const T t153{t21 - t28};
+    const T t154{t42 - t61};
+    const T t155{t71 - t78};
+    const T t156{t82 - t91};
+    const T t157{t95 - t100};
+    const T t158{t104 - t115};
+    const T t159{t119 - t126};
+    const T t160{t128 + t129};
+    const T t161{t131 - t132};
+    const T t162{t134 + t135};
+    const T t163{t137 - t138};
+    const T t164{t140 + t141};
+    const T t165{t143 - t144};
+    const T t166{t146 + t147};
+    const T t167{t149 - t150};
+    out[0] = C(t14, t29);
+    out[1] = C(t62, t79);
+    out[2] = C(t92, t101);
+    out[3] = C(t116, t127);
+    out[4] = C(t130, t133);
+    out[5] = C(t136, t139);
+    out[6] = C(t142, t145);
+    out[7] = C(t148, t151);
+    out[8] = C(t152, t153);
+    out[9] = C(t154, t155);
+    out[10] = C(t156, t157);
+    out[11] = C(t158, t159);
+    out[12] = C(t160, t161);
+    out[13] = C(t162, t163);
+    out[14] = C(t164, t165);
+    out[15] = C(t166, t167);
+}
+
+template <typename T, bool F, typename Load>
+inline void leaf16(std::complex<T>* out, Load load)
+{
+    if constexpr (F) {
+        leaf16Backward<T>(out, load);
+    } else {
+        leaf16Forward<T>(out, load);
+    }
+}
+
+// 372 additions, 84 multiplications
+template <typename T, typename Load>
+inline void leaf32Forward(std::complex<T>* out, Load load)
+{
+    using C = std::complex<T>;
+    constexpr T k0{T(0.707106781186547524382L)};
+    constexpr T k1{T(0.382683432365089771723L)};
+    constexpr T k2{T(0.923879532511286756101L)};
+    constexpr T k3{T(0.195090322016128267857L)};
+    constexpr T k4{T(0.980785280403230449119L)};
+    constexpr T k5{T(0.555570233019602224757L)};
+    constexpr T k6{T(0.831469612302545237081L)};
+    const C x0{load(0)};
+    const C x1{load(1)};
+    const C x2{load(2)};
+    const C x3{load(3)};
+    const C x4{load(4)};
+    const C x5{load(5)};
+    const C x6{load(6)};
+    const C x7{load(7)};
+    const C x8{load(8)};
+    const C x9{load(9)};
+    const C x10{load(10)};
+    const C x11{load(11)};
+    const C x12{load(12)};
+    const C x13{load(13)};
+    const C x14{load(14)};
+    const C x15{load(15)};
+    const C x16{load(16)};
+    const C x17{load(17)};
+    const C x18{load(18)};
+    const C x19{load(19)};
+    const C x20{load(20)};
+    const C x21{load(21)};
+    const C x22{load(22)};
+    const C x23{load(23)};
+    const C x24{load(24)};
+    const C x25{load(25)};
+    const C x26{load(26)};
+    const C x27{load(27)};
+    const C x28{load(28)};
+    const C x29{load(29)};
+    const C x30{load(30)};
+    const C x31{load(31)};
+    const T t0{x0.real() + x16.real()};
+    const T t1{x8.real() + x24.real()};
+    const T t2{t0 + t1};
+    const T t3{x4.real() + x20.real()};
+    const T t4{x12.real() + x28.real()};
+    const T t5{t3 + t4};
+    const T t6{t2 + t5};
+    const T t7{x2.real() + x18.real()};
+    const T t8{x10.real() + x26.real()};
+    const T t9{t7 + t8};
+    const T t10{x14.real() + x30.real()};
+    const T t11{x6.real() + x22.real()};
+    const T t12{t10 + t11};
+    const T t13{t9 + t12};
+    const T t14{t6 + t13};
+    const T t15{x1.real() + x17.real()};
+    const T t16{x9.real() + x25.real()};
+    const T t17{t15 + t16};
+    const T t18{x5.real() + x21.real()};
+    const T t19{x13.real() + x29.real()};
+    const T t20{t18 + t19};
+    const T t21{t17 + t20};
+    const T t22{x15.real() + x31.real()};
+    const T t23{x7.real() + x23.real()};
+    const T t24{t22 + t23};
+    const T t25{x3.real() + x19.real()};
+    const T t26{x11.real() + x27.real()};
+    const T t27{t25 + t26};
+    const T t28{t24 + t27};
+    const T t29{t21 + t28};
+    const T t30{t14 + t29};
+    const T t31{x0.imag() + x16.imag()};
+    const T t32{x8.imag() + x24.imag()};
+    const T t33{t31 + t32};
+    const T t34{x4.imag() + x20.imag()};
+    const T t35{x12.imag() + x28.imag()};
+    const T t36{t34 + t35};
+    const T t37{t33 + t36};
+    const T t38{x2.imag() + x18.imag()};
+    const T t39{x10.imag() + x26.imag()};
+    const T t40{t38 + t39};
+    const T t41{x14.imag() + x30.imag()};
+    const T t42{x6.imag() + x22.imag()};
+    const T t43{t41 + t42};
+    const T t44{t40 + t43};
+    const T t45{t37 + t44};
+    const T t46{x1.imag() + x17.imag()};
+    const T t47{x9.imag() + x25.imag()};
+    const T t48{t46 + t47};
+    const T t49{x5.imag() + x21.imag()};
+    const T t50{x13.imag() + x29.imag()};
+    const T t51{t49 + t50};
+    const T t52{t48 + t51};
+    const T t53{x15.imag() + x31.imag()};
+    const T t54{x7.imag() + x23.imag()};
+    const T t55{t53 + t54};
+    const T t56{x3.imag() + x19.imag()};
+    const T t57{x11.imag() + x27.imag()};
+    const T t58{t56 + t57};
+    const T t59{t55 + t58};
+    const T t60{t52 + t59};
+    const T t61{t45 + t60};
+    const T t62{x0.real() - x16.real()};
+    const T t63{x8.imag() - x24.imag()};
+    const T t64{t62 + t63};
+    const T t65{x4.real() - x20.real()};
+    const T t66{x4.imag() - x20.imag()};
+    const T t67{t65 + t66};
+    const T t68{k0 * t67};
+    const T t69{x28.real() - x12.real()};
+    const T t70{x28.imag() - x12.imag()};
+    const T t71{t69 - t70};
+    const T t72{k0 * t71};
+    const T t73{t68 + t72};
+    const T t74{t64 + t73};
+    const T t75{x2.imag() - x18.imag()};
+    const T t76{x10.real() - x26.real()};
+    const T t77{t75 - t76};
+    const T t78{k1 * t77};
+    const T t79{x2.real() - x18.real()};
+    const T t80{x10.imag() - x26.imag()};
+    const T t81{t79 + t80};
+    const T t82{k2 * t81};
+    const T t83{t78 + t82};
+    const T t84{x30.real() - x14.real()};
+    const T t85{x6.imag() - x22.imag()};
+    const T t86{t84 + t85};
+    const T t87{k2 * t86};
+    const T t88{x30.imag() - x14.imag()};
+    const T t89{x6.real() - x22.real()};
+    const T t90{t88 - t89};
+    const T t91{k1 * t90};
+    const T t92{t87 - t91};
+    const T t93{t83 + t92};
+    const T t94{t74 + t93};
+    const T t95{x1.imag() - x17.imag()};
+    const T t96{x9.real() - x25.real()};
+    const T t97{t95 - t96};
+    const T t98{x5.imag() - x21.imag()};
+    const T t99{x5.real() - x21.real()};
+    const T t100{t98 - t99};
+    const T t101{k0 * t100};
+    const T t102{x29.real() - x13.real()};
+    const T t103{x29.imag() - x13.imag()};
+    const T t104{t102 + t103};
+    const T t105{k0 * t104};
+    const T t106{t101 + t105};
+    const T t107{t97 + t106};
+    const T t108{k3 * t107};
+    const T t109{x1.real() - x17.real()};
+    const T t110{x9.imag() - x25.imag()};
+    const T t111{t109 + t110};
+    const T t112{t99 + t98};
+    const T t113{k0 * t112};
+    const T t114{t102 - t103};
+    const T t115{k0 * t114};
+    const T t116{t113 + t115};
+    const T t117{t111 + t116};
+    const T t118{k4 * t117};
+    const T t119{t108 + t118};
+    const T t120{x31.real() - x15.real()};
+    const T t121{x7.imag() - x23.imag()};
+    const T t122{t120 + t121};
+    const T t123{x3.real() - x19.real()};
+    const T t124{x3.imag() - x19.imag()};
+    const T t125{t123 + t124};
+    const T t126{k0 * t125};
+    const T t127{x27.real() - x11.real()};
+    const T t128{x27.imag() - x11.imag()};
+    const T t129{t127 - t128};
+    const T t130{k0 * t129};
+    const T t131{t126 + t130};
+    const T t132{t122 + t131};
+    const T t133{k4 * t132};
+    const T t134{x31.imag() - x15.imag()};
+    const T t135{x7.real() - x23.real()};
+    const T t136{t134 - t135};
+    const T t137{t124 - t123};
+    const T t138{k0 * t137};
+    const T t139{t127 + t128};
+    const T t140{k0 * t139};
+    const T t141{t138 + t140};
+    const T t142{t136 + t141};
+    const T t143{k3 * t142};
+    const T t144{t133 - t143};
+    const T t145{t119 + t144};
+    const T t146{t94 + t145};
+    const T t147{x0.imag() - x16.imag()};
+    const T t148{x8.real() - x24.real()};
+    const T t149{t147 - t148};
+    const T t150{t66 - t65};
+    const T t151{k0 * t150};
+    const T t152{t69 + t70};
+    const T t153{k0 * t152};
+    const T t154{t151 + t153};
+    const T t155{t149 + t154};
+    const T t156{k2 * t77};
+    const T t157{k1 * t81};
+    const T t158{t156 - t157};
+    const T t159{k2 * t90};
+    const T t160{k1 * t86};
+    const T t161{t159 + t160};
+    const T t162{t158 + t161};
+    const T t163{t155 + t162};
+    const T t164{k4 * t107};
+    const T t165{k3 * t117};
+    const T t166{t164 - t165};
+    const T t167{k4 * t142};
+    const T t168{k3 * t132};
+    const T t169{t167 + t168};
+    const T t170{t166 + t169};
+    const T t171{t163 + t170};
+    const T t172{t0 - t1};
+    const T t173{t34 - t35};
+    const T t174{t172 + t173};
+    const T t175{t7 - t8};
+    const T t176{t38 - t39};
+    const T t177{t175 + t176};
+    const T t178{k0 * t177};
+    const T t179{t10 - t11};
+    const T t180{t41 - t42};
+    const T t181{t179 - t180};
+    const T t182{k0 * t181};
+    const T t183{t178 + t182};
+    const T t184{t174 + t183};
+    const T t185{t46 - t47};
+    const T t186{t18 - t19};
+    const T t187{t185 - t186};
+    const T t188{k1 * t187};
+    const T t189{t15 - t16};
+    const T t190{t49 - t50};
+    const T t191{t189 + t190};
+    const T t192{k2 * t191};
+    const T t193{t188 + t192};
+    const T t194{t22 - t23};
+    const T t195{t56 - t57};
+    const T t196{t194 + t195};
+    const T t197{k2 * t196};
+    const T t198{t53 - t54};
+    const T t199{t25 - t26};
+    const T t200{t198 - t199};
+    const T t201{k1 * t200};
+    const T t202{t197 - t201};
+    const T t203{t193 + t202};
+    const T t204{t184 + t203};
+    const T t205{t31 - t32};
+    const T t206{t3 - t4};
+    const T t207{t205 - t206};
+    const T t208{t176 - t175};
+    const T t209{k0 * t208};
+    const T t210{t179 + t180};
+    const T t211{k0 * t210};
+    const T t212{t209 + t211};
+    const T t213{t207 + t212};
+    const T t214{k2 * t187};
+    const T t215{k1 * t191};
+    const T t216{t214 - t215};
+    const T t217{k2 * t200};
+    const T t218{k1 * t196};
+    const T t219{t217 + t218};
+    const T t220{t216 + t219};
+    const T t221{t213 + t220};
+    const T t222{t62 - t63};
+    const T t223{t151 - t153};
+    const T t224{t222 + t223};
+    const T t225{t75 + t76};
+    const T t226{k2 * t225};
+    const T t227{t79 - t80};
+    const T t228{k1 * t227};
+    const T t229{t226 + t228};
+    const T t230{t84 - t85};
+    const T t231{k1 * t230};
+    const T t232{t88 + t89};
+    const T t233{k2 * t232};
+    const T t234{t231 - t233};
+    const T t235{t229 + t234};
+    const T t236{t224 + t235};
+    const T t237{t95 + t96};
+    const T t238{t113 - t115};
+    const T t239{t237 - t238};
+    const T t240{k5 * t239};
+    const T t241{t109 - t110};
+    const T t242{t101 - t105};
+    const T t243{t241 + t242};
+    const T t244{k6 * t243};
+    const T t245{t240 + t244};
+    const T t246{t120 - t121};
+    const T t247{t138 - t140};
+    const T t248{t246 + t247};
+    const T t249{k6 * t248};
+    const T t250{t134 + t135};
+    const T t251{t126 - t130};
+    const T t252{t250 - t251};
+    const T t253{k5 * t252};
+    const T t254{t249 - t253};
+    const T t255{t245 + t254};
+    const T t256{t236 + t255};
+    const T t257{t147 + t148};
+    const T t258{t68 - t72};
+    const T t259{t257 - t258};
+    const T t260{k1 * t225};
+    const T t261{k2 * t227};
+    const T t262{t260 - t261};
+    const T t263{k1 * t232};
+    const T t264{k2 * t230};
+    const T t265{t263 + t264};
+    const T t266{t262 + t265};
+    const T t267{t259 + t266};
+    const T t268{k6 * t239};
+    const T t269{k5 * t243};
+    const T t270{t268 - t269};
+    const T t271{k6 * t252};
+    const T t272{k5 * t248};
+    const T t273{t271 + t272};
+    const T t274{t270 + t273};
+    const T t275{t267 + t274};
+    const T t276{t2 - t5};
+    const T t277{t40 - t43};
+    const T t278{t276 + t277};
+    const T t279{t17 - t20};
+    const T t280{t48 - t51};
+    const T t281{t279 + t280};
+    const T t282{k0 * t281};
+    const T t283{t24 - t27};
+    const T t284{t55 - t58};
+    const T t285{t283 - t284};
+    const T t286{k0 * t285};
+    const T t287{t282 + t286};
+    const T t288{t278 + t287};
+    const T t289{t33 - t36};
+    const T t290{t9 - t12};
+    const T t291{t289 - t290};
+    const T t292{t280 - t279};
+    const T t293{k0 * t292};
+    const T t294{t283 + t284};
+    const T t295{k0 * t294};
+    const T t296{t293 + t295};
+    const T t297{t291 + t296};
+    const T t298{t64 - t73};
+    const T t299{t158 - t161};
+    const T t300{t298 + t299};
+    const T t301{t97 - t106};
+    const T t302{k6 * t301};
+    const T t303{t111 - t116};
+    const T t304{k5 * t303};
+    const T t305{t302 + t304};
+    const T t306{t122 - t131};
+    const T t307{k5 * t306};
+    const T t308{t136 - t141};
+    const T t309{k6 * t308};
+    const T t310{t307 - t309};
+    const T t311{t305 + t310};
+    const T t312{t300 + t311};
+    const T t313{t149 - t154};
+    const T t314{t83 - t92};
+    const T t315{t313 - t314};
+    const T t316{k5 * t301};
+    const T t317{k6 * t303};
+    const T t318{t316 - t317};
+    const T t319{k5 * t308};
+    const T t320{k6 * t306};
+    const T t321{t319 + t320};
+    const T t322{t318 + t321};
+    const T t323{t315 + t322};
+    const T t324{t172 - t173};
+    const T t325{t209 - t211};
+    const T t326{t324 + t325};
+    const T t327{t185 + t186};
+    const T t328{k2 * t327};
+    const T t329{t189 - t190};
+    const T t330{k1 * t329};
+    const T t331{t328 + t330};
+    const T t332{t194 - t195};
+    const T t333{k1 * t332};
+    const T t334{t198 + t199};
+    const T t335{k2 * t334};
+    const T t336{t333 - t335};
+    const T t337{t331 + t336};
+    const T t338{t326 + t337};
+    const T t339{t205 + t206};
+    const T t340{t178 - t182};
+    const T t341{t339 - t340};
+    const T t342{k1 * t327};
+    const T t343{k2 * t329};
+    const T t344{t342 - t343};
+    const T t345{k1 * t334};
+    const T t346{k2 * t332};
+    const T t347{t345 + t346};
+    const T t348{t344 + t347};
+    const T t349{t341 + t348};
+    const T t350{t222 - t223};
+    const T t351{t262 - t265};
+    const T t352{t350 + t351};
+    const T t353{t237 + t238};
+    const T t354{k4 * t353};
+    const T t355{t241 - t242};
+    const T t356{k3 * t355};
+    const T t357{t354 + t356};
+    const T t358{t246 - t247};
+    const T t359{k3 * t358};
+    const T t360{t250 + t251};
+    const T t361{k4 * t360};
+    const T t362{t359 - t361};
+    const T t363{t357 + t362};
+    const T t364{t352 + t363};
+    const T t365{t257 + t258};
+    const T t366{t229 - t234};
+    const T t367{t365 - t366};
+    const T t368{k3 * t353};
+    const T t369{k4 * t355};
+    const T t370{t368 - t369};
+    const T t371{k3 * t360};
+    const T t372{k4 * t358};
+    const T t373{t371 + t372};
+    const T t374{t370 + t373};
+    const T t375{t367 + t374};
+    const T t376{t6 - t13};
+    const T t377{t52 - t59};
+    const T t378{t376 + t377};
+    const T t379{t37 - t44};
+    const T t380{t21 - t28};
+    const T t381{t379 - t380};
+    const T t382{t74 - t93};
+    const T t383{t166 - t169};
+    const T t384{t382 + t383};
+    const T t385{t155 - t162};
+    const T t386{t119 - t144};
+    const T t387{t385 - t386};
+    const T t388{t174 - t183};
+    const T t389{t216 - t219};
+    const T t390{t388 + t389};
+    const T t391{t207 - t212};
+    const T t392{t193 - t202};
+    const T t393{t391 - t392};
+    const T t394{t224 - t235};
+    const T t395{t270 - t273};
+    const T t396{t394 + t395};
+    const T t397{t259 - t266};
+    const T t398{t245 - t254};
+    const T t399{t397 - t398};
+    const T t400{t276 - t277};
+    const T t401{t293 - t295};
+    const T t402{t400 + t401};
+    const T t403{t289 + t290};
+    const T t404{t282 - t286};
+    const T t405{t403 - t404};
+    const T t406{t298 - t299};
+    const T t407{t318 - t321};
+    const T t408{t406 + t407};
+    const T t409{t313 + t314};
+    const T t410{t305 - t310};
+    const T t411{t409 - t410};
+    const T t412{t324 - t325};
+    const T t413{t344 - t347};
+    const T t414{t412 + t413};
+    const T t415{t339 + t340};
+    const T t416{t331 - t336};
+    const T t417{t415 - t416};
+    const T t418{t350 - t351};
+    const T t419{t370 - t373};
+    const T t420{t418 + t419};
+    const T t421{t365 + t366};
+    const T t422{t357 - t362};
+    const T t423{t421 - t422};
+    const T t424{t14 - t29};
+    const T t425{t45 - t60};
+    const T t426{t94 - t145};
+    const T t427{t163 - t170};
+    const T t428{t184 - t203};
+    const T t429{t213 - t220};
+    const T t430{t236 - t255};
+    const T t431{t267 - t274};
+    const T t432{t278 - t287};
+    const T t433{t291 - t296};
+    const T t434{t300 - t311};
+    const T t435{t315 - t322};
+    const T t436{t326 - t337};
+    const T t437{t341 - t348};
+    const T t438{t352 - t363};
+    const T t439{t367 - t374};
+    const T t440{t376 - t377};
+    const T t441{t379 + t380};
+    const T t442{t382 - t383};
+    const T t443{t385 + t386};
+    const T t444{t388 - t389};
+    const T t445{t391 + t392};
+    const T t446{t394 - t395};
+    const T t447{t397 + t398};
+    const T t448{t400 - t401};
+    const T t449{t403 + t404};
+    const T t450{t406 - t407};
+    const T t451{t409 + t410};
+    const T t452{t412 - t413};
+    const T t453{t415 + t416};
+    const T t454{t418 - t419};
+    const T t455{t421 + t422};
+    out[0] = C(t30, t61);
+    out[1] = C(t146, t171);
+    out[2] = C(t204, t221);
+    out[3] = C(t256, t275);
+    out[4] = C(t288, t297);
+    out[5] = C(t312, t323);
+    out[6] = C(t338, t349);
+    out[7] = C(t364, t375);
+    out[8] = C(t378, t381);
+    out[9] = C(t384, t387);
+    out[10] = C(t390, t393);
+    out[11] = C(t396, t399);
+    out[12] = C(t402, t405);
+    out[13] = C(t408, t411);
+    out[14] = C(t414, t417);
+    out[15] = C(t420, t423);
+    out[16] = C(t424, t425);
+    out[17] = C(t426, t427);
+    out[18] = C(t428, t429);
+    out[19] = C(t430, t431);
+    out[20] = C(t432, t433);
+    out[21] = C(t434, t435);
+    out[22] = C(t436, t437);
+    out[23] = C(t438, t439);
+    out[24] = C(t440, t441);
+    out[25] = C(t442, t443);
+    out[26] = C(t444, t445);
+    out[27] = C(t446, t447);
+    out[28] = C(t448, t449);
+    out[29] = C(t450, t451);
+    out[30] = C(t452, t453);
+    out[31] = C(t454, t455);
+}
+
+// 372 additions, 84 multiplications
+template <typename T, typename Load>
+inline void leaf32Backward(std::complex<T>* out, Load load)
+{
+    using C = std::complex<T>;
+    constexpr T k0{T(0.707106781186547524382L)};
+    constexpr T k1{T(0.923879532511286756101L)};
+    constexpr T k2{T(0.382683432365089771723L)};
+    constexpr T k3{T(0.980785280403230449119L)};
+    constexpr T k4{T(0.195090322016128267857L)};
+    constexpr T k5{T(0.831469612302545237081L)};
+    constexpr T k6{T(0.555570233019602224757L)};
+    const C x0{load(0)};
+    const C x1{load(1)};
+    const C x2{load(2)};
+    const C x3{load(3)};
+    const C x4{load(4)};
+    const C x5{load(5)};
+    const C x6{load(6)};
+    const C x7{load(7)};
+    const C x8{load(8)};
+    const C x9{load(9)};
+    const C x10{load(10)};
+    const C x11{load(11)};
+    const C x12{load(12)};
+    const C x13{load(13)};
+    const C x14{load(14)};
+    const C x15{load(15)};
+    const C x16{load(16)};
+    const C x17{load(17)};
+    const C x18{load(18)};
+    const C x19{load(19)};
+    const C x20{load(20)};
+    const C x21{load(21)};
+    const C x22{load(22)};
+    const C x23{load(23)};
+    const C x24{load(24)};
+    const C x25{load(25)};
+    const C x26{load(26)};
+    const C x27{load(27)};
+    const C x28{load(28)};
+    const C x29{load(29)};
+    const C x30{load(30)};
+    const C x31{load(31)};
+    const T t0{x0.real() + x16.real()};
+    const T t1{x8.real() + x24.real()};
+    const T t2{t0 + t1};
+    const T t3{x4.real() + x20.real()};
+    const T t4{x12.real() + x28.real()};
+    const T t5{t3 + t4};
+    const T t6{t2 + t5};
+    const T t7{x2.real() + x18.real()};
+    const T t8{x10.real() + x26.real()};
+    const T t9{t7 + t8};
+    const T t10{x14.real() + x30.real()};
+    const T t11{x6.real() + x22.real()};
+    const T t12{t10 + t11};
+    const T t13{t9 + t12};
+    const T t14{t6 + t13};
+    const T t15{x1.real() + x17.real()};
+    const T t16{x9.real() + x25.real()};
+    const T t17{t15 + t16};
+    const T t18{x5.real() + x21.real()};
+    const T t19{x13.real() + x29.real()};
+    const T t20{t18 + t19};
+    const T t21{t17 + t20};
+    const T t22{x15.real() + x31.real()};
+    const T t23{x7.real() + x23.real()};
+    const T t24{t22 + t23};
+    const T t25{x3.real() + x19.real()};
+    const T t26{x11.real() + x27.real()};
+    const T t27{t25 + t26};
+    const T t28{t24 + t27};
+    const T t29{t21 + t28};
+    const T t30{t14 + t29};
+    const T t31{x0.imag() + x16.imag()};
+    const T t32{x8.imag() + x24.imag()};
+    const T t33{t31 + t32};
+    const T t34{x4.imag() + x20.imag()};
+    const T t35{x12.imag() + x28.imag()};
+    const T t36{t34 + t35};
+    const T t37{t33 + t36};
+    const T t38{x2.imag() + x18.imag()};
+    const T t39{x10.imag() + x26.imag()};
+    const T t40{t38 + t39};
+    const T t41{x14.imag() + x30.imag()};
+    const T t42{x6.imag() + x22.imag()};
+    const T t43{t41 + t42};
+    const T t44{t40 + t43};
+    const T t45{t37 + t44};
+    const T t46{x1.imag() + x17.imag()};
+    const T t47{x9.imag() + x25.imag()};
+    const T t48{t46 + t47};
+    const T t49{x5.imag() + x21.imag()};
+    const T t50{x13.imag() + x29.imag()};
+    const T t51{t49 + t50};
+    const T t52{t48 + t51};
+    const T t53{x15.imag() + x31.imag()};
+    const T t54{x7.imag() + x23.imag()};
+    const T t55{t53 + t54};
+    const T t56{x3.imag() + x19.imag()};
+    const T t57{x11.imag() + x27.imag()};
+    const T t58{t56 + t57};
+    const T t59{t55 + t58};
+    const T t60{t52 + t59};
+    const T t61{t45 + t60};
+    const T t62{x0.real() - x16.real()};
+    const T t63{x8.imag() - x24.imag()};
+    const T t64{t62 - t63};
+    const T t65{x4.real() - x20.real()};
+    const T t66{x4.imag() - x20.imag()};
+    const T t67{t65 - t66};
+    const T t68{k0 * t67};
+    const T t69{x28.real() - x12.real()};
+    const T t70{x28.imag() - x12.imag()};
+    const T t71{t69 + t70};
+    const T t72{k0 * t71};
+    const T t73{t68 + t72};
+    const T t74{t64 + t73};
+    const T t75{x2.real() - x18.real()};
+    const T t76{x10.imag() - x26.imag()};
+    const T t77{t75 - t76};
+    const T t78{k1 * t77};
+    const T t79{x2.imag() - x18.imag()};
+    const T t80{x10.real() - x26.real()};
+    const T t81{t79 + t80};
+    const T t82{k2 * t81};
+    const T t83{t78 - t82};
+    const T t84{x30.imag() - x14.imag()};
+    const T t85{x6.real() - x22.real()};
+    const T t86{t84 + t85};
+    const T t87{k2 * t86};
+    const T t88{x30.real() - x14.real()};
+    const T t89{x6.imag() - x22.imag()};
+    const T t90{t88 - t89};
+    const T t91{k1 * t90};
+    const T t92{t87 + t91};
+    const T t93{t83 + t92};
+    const T t94{t74 + t93};
+    const T t95{x1.real() - x17.real()};
+    const T t96{x9.imag() - x25.imag()};
+    const T t97{t95 - t96};
+    const T t98{x5.real() - x21.real()};
+    const T t99{x5.imag() - x21.imag()};
+    const T t100{t98 - t99};
+    const T t101{k0 * t100};
+    const T t102{x29.real() - x13.real()};
+    const T t103{x29.imag() - x13.imag()};
+    const T t104{t102 + t103};
+    const T t105{k0 * t104};
+    const T t106{t101 + t105};
+    const T t107{t97 + t106};
+    const T t108{k3 * t107};
+    const T t109{x1.imag() - x17.imag()};
+    const T t110{x9.real() - x25.real()};
+    const T t111{t109 + t110};
+    const T t112{t98 + t99};
+    const T t113{k0 * t112};
+    const T t114{t103 - t102};
+    const T t115{k0 * t114};
+    const T t116{t113 + t115};
+    const T t117{t111 + t116};
+    const T t118{k4 * t117};
+    const T t119{t108 - t118};
+    const T t120{x31.imag() - x15.imag()};
+    const T t121{x7.real() - x23.real()};
+    const T t122{t120 + t121};
+    const T t123{x3.real() - x19.real()};
+    const T t124{x3.imag() - x19.imag()};
+    const T t125{t123 + t124};
+    const T t126{k0 * t125};
+    const T t127{x27.imag() - x11.imag()};
+    const T t128{x27.real() - x11.real()};
+    const T t129{t127 - t128};
+    const T t130{k0 * t129};
+    const T t131{t126 + t130};
+    const T t132{t122 + t131};
+    const T t133{k4 * t132};
+    const T t134{x31.real() - x15.real()};
+    const T t135{x7.imag() - x23.imag()};
+    const T t136{t134 - t135};
+    const T t137{t123 - t124};
+    const T t138{k0 * t137};
+    const T t139{t128 + t127};
+    const T t140{k0 * t139};
+    const T t141{t138 + t140};
+    const T t142{t136 + t141};
+    const T t143{k3 * t142};
+    const T t144{t133 + t143};
+    const T t145{t119 + t144};
+    const T t146{t94 + t145};
+    const T t147{x0.imag() - x16.imag()};
+    const T t148{x8.real() - x24.real()};
+    const T t149{t147 + t148};
+    const T t150{t65 + t66};
+    const T t151{k0 * t150};
+    const T t152{t70 - t69};
+    const T t153{k0 * t152};
+    const T t154{t151 + t153};
+    const T t155{t149 + t154};
+    const T t156{k1 * t81};
+    const T t157{k2 * t77};
+    const T t158{t156 + t157};
+    const T t159{k1 * t86};
+    const T t160{k2 * t90};
+    const T t161{t159 - t160};
+    const T t162{t158 + t161};
+    const T t163{t155 + t162};
+    const T t164{k3 * t117};
+    const T t165{k4 * t107};
+    const T t166{t164 + t165};
+    const T t167{k3 * t132};
+    const T t168{k4 * t142};
+    const T t169{t167 - t168};
+    const T t170{t166 + t169};
+    const T t171{t163 + t170};
+    const T t172{t0 - t1};
+    const T t173{t34 - t35};
+    const T t174{t172 - t173};
+    const T t175{t7 - t8};
+    const T t176{t38 - t39};
+    const T t177{t175 - t176};
+    const T t178{k0 * t177};
+    const T t179{t10 - t11};
+    const T t180{t41 - t42};
+    const T t181{t179 + t180};
+    const T t182{k0 * t181};
+    const T t183{t178 + t182};
+    const T t184{t174 + t183};
+    const T t185{t15 - t16};
+    const T t186{t49 - t50};
+    const T t187{t185 - t186};
+    const T t188{k1 * t187};
+    const T t189{t46 - t47};
+    const T t190{t18 - t19};
+    const T t191{t189 + t190};
+    const T t192{k2 * t191};
+    const T t193{t188 - t192};
+    const T t194{t53 - t54};
+    const T t195{t25 - t26};
+    const T t196{t194 + t195};
+    const T t197{k2 * t196};
+    const T t198{t22 - t23};
+    const T t199{t56 - t57};
+    const T t200{t198 - t199};
+    const T t201{k1 * t200};
+    const T t202{t197 + t201};
+    const T t203{t193 + t202};
+    const T t204{t184 + t203};
+    const T t205{t31 - t32};
+    const T t206{t3 - t4};
+    const T t207{t205 + t206};
+    const T t208{t175 + t176};
+    const T t209{k0 * t208};
+    const T t210{t180 - t179};
+    const T t211{k0 * t210};
+    const T t212{t209 + t211};
+    const T t213{t207 + t212};
+    const T t214{k1 * t191};
+    const T t215{k2 * t187};
+    const T t216{t214 + t215};
+    const T t217{k1 * t196};
+    const T t218{k2 * t200};
+    const T t219{t217 - t218};
+    const T t220{t216 + t219};
+    const T t221{t213 + t220};
+    const T t222{t62 + t63};
+    const T t223{t151 - t153};
+    const T t224{t222 - t223};
+    const T t225{t75 + t76};
+    const T t226{k2 * t225};
+    const T t227{t79 - t80};
+    const T t228{k1 * t227};
+    const T t229{t226 - t228};
+    const T t230{t84 - t85};
+    const T t231{k1 * t230};
+    const T t232{t88 + t89};
+    const T t233{k2 * t232};
+    const T t234{t231 + t233};
+    const T t235{t229 + t234};
+    const T t236{t224 + t235};
+    const T t237{t95 + t96};
+    const T t238{t113 - t115};
+    const T t239{t237 - t238};
+    const T t240{k5 * t239};
+    const T t241{t109 - t110};
+    const T t242{t101 - t105};
+    const T t243{t241 + t242};
+    const T t244{k6 * t243};
+    const T t245{t240 - t244};
+    const T t246{t120 - t121};
+    const T t247{t138 - t140};
+    const T t248{t246 + t247};
+    const T t249{k6 * t248};
+    const T t250{t134 + t135};
+    const T t251{t126 - t130};
+    const T t252{t250 - t251};
+    const T t253{k5 * t252};
+    const T t254{t249 + t253};
+    const T t255{t245 + t254};
+    const T t256{t236 + t255};
+    const T t257{t147 - t148};
+    const T t258{t68 - t72};
+    const T t259{t257 + t258};
+    const T t260{k2 * t227};
+    const T t261{k1 * t225};
+    const T t262{t260 + t261};
+    const T t263{k2 * t230};
+    const T t264{k1 * t232};
+    const T t265{t263 - t264};
+    const T t266{t262 + t265};
+    const T t267{t259 + t266};
+    const T t268{k5 * t243};
+    const T t269{k6 * t239};
+    const T t270{t268 + t269};
+    const T t271{k5 * t248};
+    const T t272{k6 * t252};
+    const T t273{t271 - t272};
+    const T t274{t270 + t273};
+    const T t275{t267 + t274};
+    const T t276{t2 - t5};
+    const T t277{t40 - t43};
+    const T t278{t276 - t277};
+    const T t279{t17 - t20};
+    const T t280{t48 - t51};
+    const T t281{t279 - t280};
+    const T t282{k0 * t281};
+    const T t283{t24 - t27};
+    const T t284{t55 - t58};
+    const T t285{t283 + t284};
+    const T t286{k0 * t285};
+    const T t287{t282 + t286};
+    const T t288{t278 + t287};
+    const T t289{t33 - t36};
+    const T t290{t9 - t12};
+    const T t291{t289 + t290};
+    const T t292{t279 + t280};
+    const T t293{k0 * t292};
+    const T t294{t284 - t283};
+    const T t295{k0 * t294};
+    const T t296{t293 + t295};
+    const T t297{t291 + t296};
+    const T t298{t64 - t73};
+    const T t299{t158 - t161};
+    const T t300{t298 - t299};
+    const T t301{t97 - t106};
+    const T t302{k6 * t301};
+    const T t303{t111 - t116};
+    const T t304{k5 * t303};
+    const T t305{t302 - t304};
+    const T t306{t122 - t131};
+    const T t307{k5 * t306};
+    const T t308{t136 - t141};
+    const T t309{k6 * t308};
+    const T t310{t307 + t309};
+    const T t311{t305 + t310};
+    const T t312{t300 + t311};
+    const T t313{t149 - t154};
+    const T t314{t83 - t92};
+    const T t315{t313 + t314};
+    const T t316{k6 * t303};
+    const T t317{k5 * t301};
+    const T t318{t316 + t317};
+    const T t319{k6 * t306};
+    const T t320{k5 * t308};
+    const T t321{t319 - t320};
+    const T t322{t318 + t321};
+    const T t323{t315 + t322};
+    const T t324{t172 + t173};
+    const T t325{t209 - t211};
+    const T t326{t324 - t325};
+    const T t327{t185 + t186};
+    const T t328{k2 * t327};
+    const T t329{t189 - t190};
+    const T t330{k1 * t329};
+    const T t331{t328 - t330};
+    const T t332{t194 - t195};
+    const T t333{k1 * t332};
+    const T t334{t198 + t199};
+    const T t335{k2 * t334};
+    const T t336{t333 + t335};
+    const T t337{t331 + t336};
+    const T t338{t326 + t337};
+    const T t339{t205 - t206};
+    const T t340{t178 - t182};
+    const T t341{t339 + t340};
+    const T t342{k2 * t329};
+    const T t343{k1 * t327};
+    const T t344{t342 + t343};
+    const T t345{k2 * t332};
+    const T t346{k1 * t334};
+    const T t347{t345 - t346};
+    const T t348{t344 + t347};
+    const T t349{t341 + t348};
+    const T t350{t222 + t223};
+    const T t351{t262 - t265};
+    const T t352{t350 - t351};
+    const T t353{t237 + t238};
+    const T t354{k4 * t353};
+    const T t355{t241 - t242};
+    const T t356{k3 * t355};
+    const T t357{t354 - t356};
+    const T t358{t246 - t247};
+    const T t359{k3 * t358};
+    const T t360{t250 + t251};
+    const T t361{k4 * t360};
+    const T t362{t359 + t361};
+    const T t363{t357 + t362};
+    const T t364{t352 + t363};
+    const T t365{t257 - t258};
+    const T t366{t229 - t234};
+    const T t367{t365 + t366};
+    const T t368{k4 * t355};
+    const T t369{k3 * t353};
+    const T t370{t368 + t369};
+    const T t371{k4 * t358};
+    const T t372{k3 * t360};
+    const T t373{t371 - t372};
+    const T t374{t370 + t373};
+    const T t375{t367 + t374};
+    const T t376{t6 - t13};
+    const T t377{t52 - t59};
+    const T t378{t376 - t377};
+    const T t379{t37 - t44};
+    const T t380{t21 - t28};
+    const T t381{t379 + t380};
+    const T t382{t74 - t93};
+    const T t383{t166 - t169};
+    const T t384{t382 - t383};
+    const T t385{t155 - t162};
+    const T t386{t119 - t144};
+    const T t387{t385 + t386};
+    const T t388{t174 - t183};
+    const T t389{t216 - t219};
+    const T t390{t388 - t389};
+    const T t391{t207 - t212};
+    const T t392{t193 - t202};
+    const T t393{t391 + t392};
+    const T t394{t224 - t235};
+    const T t395{t270 - t273};
+    const T t396{t394 - t395};
+    const T t397{t259 - t266};
+    const T t398{t245 - t254};
+    const T t399{t397 + t398};
+    const T t400{t276 + t277};
+    const T t401{t293 - t295};
+    const T t402{t400 - t401};
+    const T t403{t289 - t290};
+    const T t404{t282 - t286};
+    const T t405{t403 + t404};
+    const T t406{t298 + t299};
+    const T t407{t318 - t321};
+    const T t408{t406 - t407};
+    const T t409{t313 - t314};
+    const T t410{t305 - t310};
+    const T t411{t409 + t410};
+    const T t412{t324 + t325};
+    const T t413{t344 - t347};
+    const T t414{t412 - t413};
+    const T t415{t339 - t340};
+    const T t416{t331 - t336};
+    const T t417{t415 + t416};
+    const T t418{t350 + t351};
+    const T t419{t370 - t373};
+    const T t420{t418 - t419};
+    const T t421{t365 - t366};
+    const T t422{t357 - t362};
+    const T t423{t421 + t422};
+    const T t424{t14 - t29};
+    const T t425{t45 - t60};
+    const T t426{t94 - t145};
+    const T t427{t163 - t170};
+    const T t428{t184 - t203};
+    const T t429{t213 - t220};
+    const T t430{t236 - t255};
+    const T t431{t267 - t274};
+    const T t432{t278 - t287};
+    const T t433{t291 - t296};
+    const T t434{t300 - t311};
+    const T t435{t315 - t322};
+    const T t436{t326 - t337};
+    const T t437{t341 - t348};
+    const T t438{t352 - t363};
+    const T t439{t367 - t374};
+    const T t440{t376 + t377};
+    const T t441{t379 - t380};
+    const T t442{t382 + t383};
+    const T t443{t385 - t386};
+    const T t444{t388 + t389};
+    const T t445{t391 - t392};
+    const T t446{t394 + t395};
+    const T t447{t397 - t398};
+    const T t448{t400 + t401};
+    const T t449{t403 - t404};
+    const T t450{t406 + t407};
+    const T t451{t409 - t410};
+    const T t452{t412 + t413};
+    const T t453{t415 - t416};
+    const T t454{t418 + t419};
+    const T t455{t421 - t422};
+    out[0] = C(t30, t61);
+    out[1] = C(t146, t171);
+    out[2] = C(t204, t221);
+    out[3] = C(t256, t275);
+    out[4] = C(t288, t297);
+    out[5] = C(t312, t323);
+    out[6] = C(t338, t349);
+    out[7] = C(t364, t375);
+    out[8] = C(t378, t381);
+    out[9] = C(t384, t387);
+    out[10] = C(t390, t393);
+    out[11] = C(t396, t399);
+    out[12] = C(t402, t405);
+    out[13] = C(t408, t411);
+    out[14] = C(t414, t417);
+    out[15] = C(t420, t423);
+    out[16] = C(t424, t425);
+    out[17] = C(t426, t427);
+    out[18] = C(t428, t429);
+    out[19] = C(t430, t431);
+    out[20] = C(t432, t433);
+    out[21] = C(t434, t435);
+    out[22] = C(t436, t437);
+    out[23] = C(t438, t439);
+    out[24] = C(t440, t441);
+    out[25] = C(t442, t443);
+    out[26] = C(t444, t445);
+    out[27] = C(t446, t447);
+    out[28] = C(t448, t449);
+    out[29] = C(t450, t451);
+    out[30] = C(t452, t453);
+    out[31] = C(t454, t455);
+}
+
+template <typename T, bool F, typename Load>
+inline void leaf32(std::complex<T>* out, Load load)
+{
+    if constexpr (F) {
+        leaf32Backward<T>(out, load);
+    } else {
+        leaf32Forward<T>(out, load);
+    }
+}
+
+} // namespace internal
+} // namespace splitradixfft
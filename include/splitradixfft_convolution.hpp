@@ -0,0 +1,791 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_convolution.hpp
+ * Streaming FIR filters that convolve with the cached half-spectrum of the
+ * filter. Every block of input costs one real forward transform, one pointwise
+ * multiply and one real backward transform, all buffers are allocated when
+ * the convolver is created. Long impulse responses are split into partitions
+ * of the block size to keep the latency at one block.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft_plan.hpp"
+#include "splitradixfft_spectral.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace splitradixfft {
+
+// OVERLAP_SAVE transforms the last fftSize() input values and keeps the
+// outputs that did not wrap around. OVERLAP_ADD transforms the zero padded
+// block and adds the tail of the previous block. Both produce the same
+// output up to rounding.
+enum class ConvolutionMethod {
+    OVERLAP_SAVE = 0,
+    OVERLAP_ADD = 1,
+};
+
+template <typename T>
+class Convolver;
+
+template <typename T>
+class PartitionedConvolver;
+
+template <typename T>
+class NonUniformConvolver;
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+inline std::size_t convolutionFftSize(std::size_t kernelSize) noexcept
+{
+    // The size that minimizes the cost per output value, modelled as
+    // N * (log2(N) + 1) for the two transforms and the multiply over the
+    // N - kernelSize + 1 outputs of a block.
+    std::size_t best = 0;
+    double bestCost = 0;
+    std::size_t log2 = 3;
+    for (std::size_t nfft = minimumRfftSize;
+         nfft <= ((std::size_t)1 << 30); nfft *= 2, log2++) {
+        if (nfft < kernelSize) {
+            continue;
+        }
+        const double cost = (double)nfft * (double)(log2 + 1) /
+                            (double)(nfft - kernelSize + 1);
+        if (best != 0 && cost >= bestCost) {
+            break;
+        }
+        best = nfft;
+        bestCost = cost;
+    }
+    return best;
+}
+
+template <typename T>
+FFTSTATUS buildConvolver(const T* kernel, const std::size_t kernelSize,
+                         const ConvolutionMethod method,
+                         const std::size_t fftSize,
+                         Convolver<T>& convolver) noexcept;
+
+template <typename T>
+FFTSTATUS buildPartitionedConvolver(const T* const* responses,
+                                    const std::size_t responseSize,
+                                    const std::size_t channels,
+                                    const std::size_t blockSize,
+                                    PartitionedConvolver<T>& convolver) noexcept;
+
+template <typename T>
+FFTSTATUS buildNonUniformConvolver(const T* response,
+                                   const std::size_t responseSize,
+                                   const std::size_t blockSize,
+                                   const std::size_t maximumBlockSize,
+                                   ThreadPool* pool,
+                                   NonUniformConvolver<T>& convolver) noexcept;
+
+// Largest partitions of the non-uniform convolver if the caller does not
+// choose, larger ones save little and delay the background transforms.
+constexpr std::size_t defaultMaximumPartition = 8192;
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+template <typename T>
+class Convolver {
+public:
+    using C = std::complex<T>;
+
+    Convolver() = default;
+    Convolver(const Convolver&) = delete;
+    Convolver& operator=(const Convolver&) = delete;
+    Convolver(Convolver&&) noexcept = default;
+    Convolver& operator=(Convolver&&) noexcept = default;
+
+    std::size_t kernelSize() const noexcept { return kernelSize_; }
+    std::size_t fftSize() const noexcept { return forward_.size(); }
+    ConvolutionMethod method() const noexcept { return method_; }
+
+    // Number of input values transformed at once, fftSize() - kernelSize() +
+    // 1. The output lags the input by one block: out[n] is the convolution
+    // evaluated at input value n - latency().
+    std::size_t blockSize() const noexcept { return blockSize_; }
+    std::size_t latency() const noexcept { return blockSize_; }
+
+    // Filters count values of any size, in and out may be the same array.
+    // Full blocks are transformed as soon as they are complete, nothing is
+    // allocated.
+    void process(const T* in, T* out, std::size_t count) noexcept
+    {
+        // The history occupies the first kernelSize() - 1 values of the
+        // window for overlap-save, which are also the wrapped outputs.
+        // Overlap-add pads the block with zeros.
+        T* block = window_.data() + outputOffset();
+        const T* output = result_.data() + outputOffset();
+        while (count > 0) {
+            const std::size_t n = std::min(count, blockSize_ - filled_);
+            for (std::size_t i = 0; i < n; i++) {
+                const T value{in[i]};
+                out[i] = output[filled_ + i];
+                block[filled_ + i] = value;
+            }
+            filled_ += n;
+            in += n;
+            out += n;
+            count -= n;
+            if (filled_ == blockSize_) {
+                transformBlock();
+                filled_ = 0;
+            }
+        }
+    }
+
+    // Clears the input history and the pending output, the filter is kept.
+    void reset() noexcept
+    {
+        std::fill(window_.data(), window_.data() + window_.size(), T(0));
+        std::fill(result_.data(), result_.data() + result_.size(), T(0));
+        std::fill(tail_.data(), tail_.data() + tail_.size(), T(0));
+        filled_ = 0;
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildConvolver(const U* kernel,
+                                              const std::size_t kernelSize,
+                                              const ConvolutionMethod method,
+                                              const std::size_t fftSize,
+                                              Convolver<U>& convolver) noexcept;
+
+    std::size_t outputOffset() const noexcept
+    {
+        return method_ == ConvolutionMethod::OVERLAP_SAVE ? kernelSize_ - 1
+                                                          : 0;
+    }
+
+    void transformBlock() noexcept
+    {
+        const std::size_t nfft = fftSize();
+        forward_.execute(window_.data(), spectrum_.data());
+        internal::multiplySpectrum<T>(spectrum_.data(), spectrum_.data(),
+                                      kernelSpectrum_.data(), nfft / 2 + 1);
+        backward_.execute(spectrum_.data(), result_.data());
+        T* result = result_.data();
+        if (method_ == ConvolutionMethod::OVERLAP_SAVE) {
+            // The last kernelSize() - 1 inputs are the history of the next
+            // block.
+            std::copy(window_.data() + blockSize_, window_.data() + nfft,
+                      window_.data());
+        } else {
+            // tail_ holds the nfft - blockSize() values that overlap the
+            // following blocks, they may span several blocks for short ones.
+            T* tail = tail_.data();
+            const std::size_t overlap = nfft - blockSize_;
+            const std::size_t added = std::min(blockSize_, overlap);
+            for (std::size_t i = 0; i < added; i++) {
+                result[i] += tail[i];
+            }
+            for (std::size_t j = 0; j < overlap; j++) {
+                tail[j] = result[blockSize_ + j] +
+                          (j + blockSize_ < overlap ? tail[j + blockSize_]
+                                                    : T(0));
+            }
+        }
+    }
+
+    std::size_t kernelSize_{0};
+    std::size_t blockSize_{0};
+    // Input values of the current block.
+    std::size_t filled_{0};
+    ConvolutionMethod method_{ConvolutionMethod::OVERLAP_SAVE};
+    Plan<T> forward_;
+    // Normalized by 1 / fftSize() so the kernel spectrum is used as is.
+    Plan<T> backward_;
+    internal::AlignedBuffer<C> kernelSpectrum_;
+    internal::AlignedBuffer<C> spectrum_;
+    // fftSize() values each, the block being filled and the previous result.
+    internal::AlignedBuffer<T> window_;
+    internal::AlignedBuffer<T> result_;
+    internal::AlignedBuffer<T> tail_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildConvolver(const T* kernel, const std::size_t kernelSize,
+                         const ConvolutionMethod method,
+                         const std::size_t fftSize,
+                         Convolver<T>& convolver) noexcept
+{
+    if (kernelSize == 0) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (kernel == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    const std::size_t nfft =
+        fftSize == 0 ? convolutionFftSize(kernelSize) : fftSize;
+    if (nfft < kernelSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    Convolver<T> created;
+    created.kernelSize_ = kernelSize;
+    created.blockSize_ = nfft - kernelSize + 1;
+    created.method_ = method;
+    FFTSTATUS status =
+        createPlan<T>(nfft, TransformType::REAL, Direction::FORWARD,
+                      created.forward_);
+    if (status == FFTSTATUS::OK) {
+        status = createPlan<T>(nfft, TransformType::REAL, Direction::BACKWARD,
+                               Normalization::BY_SIZE, created.backward_);
+    }
+    if (status != FFTSTATUS::OK) {
+        return status;
+    }
+    try {
+        created.kernelSpectrum_ = AlignedBuffer<std::complex<T>>(nfft / 2 + 1);
+        created.spectrum_ = AlignedBuffer<std::complex<T>>(nfft / 2 + 1);
+        created.window_ = AlignedBuffer<T>(nfft);
+        created.result_ = AlignedBuffer<T>(nfft);
+        if (method == ConvolutionMethod::OVERLAP_ADD) {
+            created.tail_ = AlignedBuffer<T>(nfft - created.blockSize_);
+        }
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+    // The window is zero again before the first block.
+    std::copy(kernel, kernel + kernelSize, created.window_.data());
+    created.forward_.execute(created.window_.data(),
+                             created.kernelSpectrum_.data());
+    created.reset();
+
+    convolver = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Convolver for the FIR filter of kernelSize values. fftSize 0 selects the
+// power of two with the lowest cost per output value, otherwise it has to be
+// a power of two of at least max(8, kernelSize) values.
+template <typename T>
+FFTSTATUS
+createConvolver(const T* kernel, const std::size_t kernelSize,
+                const ConvolutionMethod method, Convolver<T>& convolver,
+                const std::size_t fftSize = 0) noexcept
+{
+    return internal::buildConvolver<T>(kernel, kernelSize, method, fftSize,
+                                       convolver);
+}
+
+template <typename T>
+FFTSTATUS createConvolver(const T* kernel, const std::size_t kernelSize,
+                          Convolver<T>& convolver) noexcept
+{
+    return createConvolver<T>(kernel, kernelSize,
+                              ConvolutionMethod::OVERLAP_SAVE, convolver);
+}
+
+// Convolution with long impulse responses at the latency of one block, the
+// uniformly partitioned overlap-save scheme. Every response is split into
+// partitions of blockSize() values whose spectra of 2 * blockSize() points
+// are computed once. The spectra of the past input blocks are kept in a
+// frequency-domain delay line, so a block costs one forward transform, one
+// complex multiply-accumulate per partition and one backward transform per
+// channel, independent of the position in the stream.
+template <typename T>
+class PartitionedConvolver {
+public:
+    using C = std::complex<T>;
+
+    PartitionedConvolver() = default;
+    PartitionedConvolver(const PartitionedConvolver&) = delete;
+    PartitionedConvolver& operator=(const PartitionedConvolver&) = delete;
+    PartitionedConvolver(PartitionedConvolver&&) noexcept = default;
+    PartitionedConvolver& operator=(PartitionedConvolver&&) noexcept = default;
+
+    std::size_t blockSize() const noexcept { return blockSize_; }
+    std::size_t channels() const noexcept { return channels_; }
+    std::size_t partitions() const noexcept { return partitions_; }
+    std::size_t responseSize() const noexcept { return responseSize_; }
+
+    // Filters one block of blockSize() values per channel, in[c] and out[c]
+    // may be the same array. out[c][n] is the convolution evaluated at
+    // in[c][n], the latency is that of collecting the block.
+    void process(const T* const* in, T* const* out) noexcept
+    {
+        for (std::size_t c = 0; c < channels_; c++) {
+            processChannel(c, in[c], out[c]);
+        }
+        advance();
+    }
+
+    // Same as above with the channels spread over the threads of pool. The
+    // results are identical to the serial execution.
+    void process(const T* const* in, T* const* out, ThreadPool& pool) noexcept
+    {
+        internal::parallelChunks(pool, channels_, 1,
+                                 [&](std::size_t begin, std::size_t end) {
+                                     for (std::size_t c = begin; c < end;
+                                          c++) {
+                                         processChannel(c, in[c], out[c]);
+                                     }
+                                 });
+        advance();
+    }
+
+    // Clears the input history of every channel, the responses are kept.
+    void reset() noexcept
+    {
+        std::fill(windows_.data(), windows_.data() + windows_.size(), T(0));
+        std::fill(delayLine_.data(), delayLine_.data() + delayLine_.size(),
+                  C(0));
+        head_ = 0;
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildPartitionedConvolver(
+        const U* const* responses, const std::size_t responseSize,
+        const std::size_t channels, const std::size_t blockSize,
+        PartitionedConvolver<U>& convolver) noexcept;
+
+    void processChannel(std::size_t c, const T* in, T* out) noexcept
+    {
+        // Every channel owns its slices of the buffers, the channels can run
+        // concurrently.
+        const std::size_t block = blockSize_;
+        const std::size_t bins = block + 1;
+        T* window = windows_.data() + c * 2 * block;
+        T* result = results_.data() + c * 2 * block;
+        C* line = delayLine_.data() + c * partitions_ * bins;
+        const C* response = spectra_.data() + c * partitions_ * bins;
+        C* acc = accumulators_.data() + c * bins;
+
+        std::copy(window + block, window + 2 * block, window);
+        std::copy(in, in + block, window + block);
+        forward_.execute(window, line + head_ * bins);
+
+        // Partition p meets the input of p blocks ago, the delay line is
+        // written backwards so those are the slots from head_ on.
+        std::fill(acc, acc + bins, C(0));
+        std::size_t p = 0;
+        for (std::size_t slot = head_; slot < partitions_; slot++, p++) {
+            internal::multiplyAccumulateSpectrum<T>(
+                acc, line + slot * bins, response + p * bins, bins);
+        }
+        for (std::size_t slot = 0; slot < head_; slot++, p++) {
+            internal::multiplyAccumulateSpectrum<T>(
+                acc, line + slot * bins, response + p * bins, bins);
+        }
+        backward_.execute(acc, result,
+                          scratch_.data() + c * backward_.scratchSize());
+        std::copy(result + block, result + 2 * block, out);
+    }
+
+    void advance() noexcept
+    {
+        head_ = head_ == 0 ? partitions_ - 1 : head_ - 1;
+    }
+
+    std::size_t blockSize_{0};
+    std::size_t channels_{0};
+    std::size_t partitions_{0};
+    std::size_t responseSize_{0};
+    // Slot of the delay line that receives the next input spectrum.
+    std::size_t head_{0};
+    Plan<T> forward_;
+    // Normalized by 1 / (2 * blockSize()).
+    Plan<T> backward_;
+    // partitions() spectra of blockSize() + 1 values per channel.
+    internal::AlignedBuffer<C> spectra_;
+    // Per channel slices, the delay line holds partitions() spectra per
+    // channel.
+    internal::AlignedBuffer<C> delayLine_;
+    internal::AlignedBuffer<C> accumulators_;
+    internal::AlignedBuffer<C> scratch_;
+    internal::AlignedBuffer<T> windows_;
+    internal::AlignedBuffer<T> results_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildPartitionedConvolver(const T* const* responses,
+                                    const std::size_t responseSize,
+                                    const std::size_t channels,
+                                    const std::size_t blockSize,
+                                    PartitionedConvolver<T>& convolver) noexcept
+{
+    // The real plans of 2 * blockSize points need at least 8 values.
+    if (!isRadix2(blockSize) || blockSize < 4) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (responseSize == 0 || channels == 0) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (responses == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    for (std::size_t c = 0; c < channels; c++) {
+        if (responses[c] == nullptr) {
+            return FFTSTATUS::NULL_POINTER;
+        }
+    }
+
+    const std::size_t nfft = 2 * blockSize;
+    const std::size_t bins = blockSize + 1;
+    PartitionedConvolver<T> created;
+    created.blockSize_ = blockSize;
+    created.channels_ = channels;
+    created.partitions_ = (responseSize + blockSize - 1) / blockSize;
+    created.responseSize_ = responseSize;
+    FFTSTATUS status =
+        createPlan<T>(nfft, TransformType::REAL, Direction::FORWARD,
+                      created.forward_);
+    if (status == FFTSTATUS::OK) {
+        status = createPlan<T>(nfft, TransformType::REAL, Direction::BACKWARD,
+                               Normalization::BY_SIZE, created.backward_);
+    }
+    if (status != FFTSTATUS::OK) {
+        return status;
+    }
+    const std::size_t spectra = channels * created.partitions_ * bins;
+    try {
+        created.spectra_ = AlignedBuffer<std::complex<T>>(spectra);
+        created.delayLine_ = AlignedBuffer<std::complex<T>>(spectra);
+        created.accumulators_ =
+            AlignedBuffer<std::complex<T>>(channels * bins);
+        created.scratch_ = AlignedBuffer<std::complex<T>>(
+            channels * created.backward_.scratchSize());
+        created.windows_ = AlignedBuffer<T>(channels * nfft);
+        created.results_ = AlignedBuffer<T>(channels * nfft);
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+    // Partition p is zero padded to nfft values, results_ serves as the
+    // padded buffer.
+    T* padded = created.results_.data();
+    for (std::size_t c = 0; c < channels; c++) {
+        for (std::size_t p = 0; p < created.partitions_; p++) {
+            const std::size_t begin = p * blockSize;
+            const std::size_t end = std::min(responseSize, begin + blockSize);
+            std::fill(padded, padded + nfft, T(0));
+            std::copy(responses[c] + begin, responses[c] + end, padded);
+            created.forward_.execute(
+                padded,
+                created.spectra_.data() + (c * created.partitions_ + p) * bins);
+        }
+    }
+
+    convolver = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Partitioned convolver of channels channels, channel c is filtered with
+// responses[c] of responseSize values. Pass the same response for every
+// channel to filter them all alike. blockSize is a power of two of at least 4.
+template <typename T>
+FFTSTATUS createPartitionedConvolver(const T* const* responses,
+                                     const std::size_t responseSize,
+                                     const std::size_t channels,
+                                     const std::size_t blockSize,
+                                     PartitionedConvolver<T>& convolver) noexcept
+{
+    return internal::buildPartitionedConvolver<T>(
+        responses, responseSize, channels, blockSize, convolver);
+}
+
+// Convolution with long impulse responses at the latency of one small block,
+// with partitions that grow along the response. The first 4 * blockSize()
+// values of the response are partitioned by blockSize(). Segment k >= 1 then
+// covers [2 * B_k, 4 * B_k) with two partitions of B_k = 2^k * blockSize()
+// values, up to maximumBlockSize(). The last segment takes the rest of the
+// response in partitions of maximumBlockSize() values.
+//
+// A segment starts 2 * B_k values into the response, so the result of one of
+// its blocks is needed B_k values after its input is complete. Its transforms
+// run as a task of the pool passed at creation and only have to finish
+// before the segment's next block is complete. At that deadline process runs
+// the segment's task itself if no thread of the pool has started it yet,
+// otherwise it waits for that task only. It never runs other tasks of the
+// pool. Without a pool the segments run inline when their block is complete.
+// The results are identical either way.
+template <typename T>
+class NonUniformConvolver {
+public:
+    NonUniformConvolver() = default;
+    NonUniformConvolver(const NonUniformConvolver&) = delete;
+    NonUniformConvolver& operator=(const NonUniformConvolver&) = delete;
+    NonUniformConvolver(NonUniformConvolver&&) noexcept = default;
+    NonUniformConvolver& operator=(NonUniformConvolver&&) noexcept = default;
+
+    std::size_t blockSize() const noexcept { return head_.blockSize(); }
+    std::size_t responseSize() const noexcept { return responseSize_; }
+    std::size_t maximumBlockSize() const noexcept { return maximumBlockSize_; }
+
+    // Number of segments after the uniformly partitioned head and the
+    // partition size of a segment.
+    std::size_t segments() const noexcept { return segments_.size(); }
+    std::size_t segmentBlockSize(std::size_t segment) const noexcept
+    {
+        return segments_[segment]->engine.blockSize();
+    }
+
+    // Filters one block of blockSize() values, in and out may be the same
+    // array. out[n] is the convolution evaluated at in[n].
+    void process(const T* in, T* out) noexcept
+    {
+        const std::size_t block = blockSize();
+        for (auto& segment : segments_) {
+            std::copy(in, in + block,
+                      segment->staging[segment->current].data() +
+                          segment->phase);
+        }
+        head_.process(&in, &out);
+        for (auto& segment : segments_) {
+            const T* result =
+                segment->results[segment->current].data() + segment->phase;
+            for (std::size_t i = 0; i < block; i++) {
+                out[i] += result[i];
+            }
+            segment->phase += block;
+            if (segment->phase == segment->engine.blockSize()) {
+                submit(*segment);
+            }
+        }
+    }
+
+    // Waits for the running segments and clears the input history, the
+    // response is kept.
+    void reset() noexcept
+    {
+        head_.reset();
+        for (auto& segment : segments_) {
+            segment->finish();
+            segment->engine.reset();
+            for (std::size_t b = 0; b < 2; b++) {
+                std::fill(segment->staging[b].data(),
+                          segment->staging[b].data() +
+                              segment->staging[b].size(),
+                          T(0));
+                std::fill(segment->results[b].data(),
+                          segment->results[b].data() +
+                              segment->results[b].size(),
+                          T(0));
+            }
+            segment->current = 0;
+            segment->phase = 0;
+        }
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildNonUniformConvolver(
+        const U* response, const std::size_t responseSize,
+        const std::size_t blockSize, const std::size_t maximumBlockSize,
+        ThreadPool* pool, NonUniformConvolver<U>& convolver) noexcept;
+
+    struct Segment {
+        PartitionedConvolver<T> engine;
+        // The block being collected and the result being played use
+        // buffer current, the running task the other one.
+        internal::AlignedBuffer<T> staging[2];
+        internal::AlignedBuffer<T> results[2];
+        std::size_t current{0};
+        std::size_t running{0};
+        std::size_t phase{0};
+        // The task of the running block is claimed by whichever thread gets
+        // to it first, a worker of the pool or the thread calling process.
+        std::atomic<bool> claimed{true};
+        std::atomic<bool> done{true};
+        // Destroyed first, it waits for the queued task.
+        std::unique_ptr<TaskGroup> group;
+
+        void transform() noexcept
+        {
+            const T* in = staging[running].data();
+            T* out = results[running].data();
+            engine.process(&in, &out);
+        }
+
+        void claimAndTransform() noexcept
+        {
+            if (!claimed.exchange(true, std::memory_order_acq_rel)) {
+                transform();
+                done.store(true, std::memory_order_release);
+            }
+        }
+
+        // Completes the running block without running foreign tasks of the
+        // pool, unlike TaskGroup::wait.
+        void finish() noexcept
+        {
+            claimAndTransform();
+            while (!done.load(std::memory_order_acquire)) {
+                std::this_thread::yield();
+            }
+        }
+    };
+
+    static void submit(Segment& segment) noexcept
+    {
+        // The previous block's result is played from the next call on.
+        segment.finish();
+        segment.running = segment.current;
+        if (segment.group) {
+            segment.done.store(false, std::memory_order_relaxed);
+            segment.claimed.store(false, std::memory_order_release);
+            // A single captured pointer fits the small buffer of
+            // std::function, queueing the task does not allocate it.
+            Segment* running = &segment;
+            segment.group->run([running]() { running->claimAndTransform(); });
+        } else {
+            segment.transform();
+        }
+        segment.current ^= 1;
+        segment.phase = 0;
+    }
+
+    std::size_t responseSize_{0};
+    std::size_t maximumBlockSize_{0};
+    PartitionedConvolver<T> head_;
+    // Heap allocated, the tasks keep pointers into them.
+    std::vector<std::unique_ptr<Segment>> segments_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildNonUniformConvolver(const T* response,
+                                   const std::size_t responseSize,
+                                   const std::size_t blockSize,
+                                   const std::size_t maximumBlockSize,
+                                   ThreadPool* pool,
+                                   NonUniformConvolver<T>& convolver) noexcept
+{
+    if (!isRadix2(blockSize) || blockSize < 4) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    const std::size_t largest =
+        maximumBlockSize == 0
+            ? std::max(blockSize, defaultMaximumPartition)
+            : maximumBlockSize;
+    if (!isRadix2(largest) || largest < blockSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (responseSize == 0) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (response == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    using Segment = typename NonUniformConvolver<T>::Segment;
+    NonUniformConvolver<T> created;
+    created.responseSize_ = responseSize;
+    created.maximumBlockSize_ = largest;
+    // A single uniform segment if the partition size cannot grow.
+    const std::size_t headSize = std::min(
+        responseSize, largest == blockSize ? responseSize : 4 * blockSize);
+    FFTSTATUS status = createPartitionedConvolver<T>(
+        &response, headSize, 1, blockSize, created.head_);
+    if (status != FFTSTATUS::OK) {
+        return status;
+    }
+    try {
+        for (std::size_t size = 2 * blockSize, begin = headSize;
+             begin < responseSize && size <= largest; size *= 2) {
+            const std::size_t end =
+                size == largest ? responseSize
+                                : std::min(responseSize, 4 * size);
+            auto segment = std::make_unique<Segment>();
+            const T* slice = response + begin;
+            status = createPartitionedConvolver<T>(&slice, end - begin, 1,
+                                                   size, segment->engine);
+            if (status != FFTSTATUS::OK) {
+                return status;
+            }
+            for (std::size_t b = 0; b < 2; b++) {
+                segment->staging[b] = AlignedBuffer<T>(size);
+                segment->results[b] = AlignedBuffer<T>(size);
+            }
+            if (pool != nullptr) {
+                segment->group = std::make_unique<TaskGroup>(*pool);
+            }
+            created.segments_.push_back(std::move(segment));
+            begin = end;
+        }
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+
+    convolver = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Non-uniformly partitioned convolver of response. blockSize is a power of
+// two of at least 4, maximumBlockSize a power of two of at least blockSize,
+// 0 selects 8192 or blockSize if that is larger. With a pool, the segments
+// of larger partitions run on its threads, the pool has to outlive the
+// convolver.
+template <typename T>
+FFTSTATUS createNonUniformConvolver(const T* response,
+                                    const std::size_t responseSize,
+                                    const std::size_t blockSize,
+                                    NonUniformConvolver<T>& convolver,
+                                    const std::size_t maximumBlockSize = 0,
+                                    ThreadPool* pool = nullptr) noexcept
+{
+    return internal::buildNonUniformConvolver<T>(
+        response, responseSize, blockSize, maximumBlockSize, pool, convolver);
+}
+} // namespace splitradixfft
@@ -0,0 +1,325 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_correlation.hpp
+ * Cross-correlation of every pair of channels of a frame, optionally with the
+ * phase transform (GCC-PHAT). Every channel is transformed once, the pairs
+ * only cost a vectorized conjugate multiply and an inverse transform of which
+ * only the requested lags are read.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft_plan.hpp"
+#include "splitradixfft_spectral.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+namespace splitradixfft {
+
+// NONE correlates the frames as they are. PHAT divides every cross-spectrum
+// by its magnitude, which leaves a peak of 1 at the delay between two
+// channels that only differ by a delay.
+enum class CrossWeighting { NONE = 0, PHAT = 1 };
+
+template <typename T>
+class CrossCorrelator;
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+template <typename T>
+FFTSTATUS buildCrossCorrelator(const std::size_t frameSize,
+                               const std::size_t channels,
+                               const std::size_t maxLag,
+                               const CrossWeighting weighting,
+                               CrossCorrelator<T>& correlator) noexcept;
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+// Correlates frames of frameSize() values of channels() channels. The pairs
+// i < j are numbered (0, 1), (0, 2), ..., (0, channels() - 1), (1, 2), ...,
+// see pair(i, j). out[pair(i, j)][maxLag() + lag] is
+// sum_n x_i[n] * x_j[n + lag] for lag = -maxLag() to maxLag(), a peak at a
+// positive lag means x_j lags behind x_i. The frames are zero padded to
+// fftSize() >= frameSize() + maxLag(), which keeps the requested lags free of
+// circular wrap-around, so a smaller lag window also picks a smaller size.
+template <typename T>
+class CrossCorrelator {
+public:
+    using C = std::complex<T>;
+
+    CrossCorrelator() = default;
+    CrossCorrelator(const CrossCorrelator&) = delete;
+    CrossCorrelator& operator=(const CrossCorrelator&) = delete;
+    CrossCorrelator(CrossCorrelator&&) noexcept = default;
+    CrossCorrelator& operator=(CrossCorrelator&&) noexcept = default;
+
+    std::size_t frameSize() const noexcept { return frameSize_; }
+    std::size_t channels() const noexcept { return channels_; }
+    std::size_t pairs() const noexcept
+    {
+        return channels_ * (channels_ - 1) / 2;
+    }
+    std::size_t maxLag() const noexcept { return maxLag_; }
+    // Values of every correlation.
+    std::size_t lagCount() const noexcept { return 2 * maxLag_ + 1; }
+    std::size_t fftSize() const noexcept { return nfft_; }
+    CrossWeighting weighting() const noexcept { return weighting_; }
+
+    // Index of the pair of channels i < j.
+    std::size_t pair(std::size_t i, std::size_t j) const noexcept
+    {
+        return i * (2 * channels_ - i - 1) / 2 + (j - i - 1);
+    }
+
+    // frames[c] holds frameSize() values of channel c, out[p] receives the
+    // lagCount() values of pair p.
+    FFTSTATUS process(const T* const* frames, T* const* out) noexcept
+    {
+        return process(frames, out, nullptr);
+    }
+
+    // The channels and then the pairs are spread over the pool, with results
+    // identical to the serial overload.
+    FFTSTATUS process(const T* const* frames, T* const* out,
+                      ThreadPool& pool) noexcept
+    {
+        return process(frames, out, &pool);
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildCrossCorrelator(
+        const std::size_t frameSize, const std::size_t channels,
+        const std::size_t maxLag, const CrossWeighting weighting,
+        CrossCorrelator<U>& correlator) noexcept;
+
+    FFTSTATUS process(const T* const* frames, T* const* out,
+                      ThreadPool* pool) noexcept
+    {
+        if (frames == nullptr || out == nullptr) {
+            return FFTSTATUS::NULL_POINTER;
+        }
+        for (std::size_t c = 0; c < channels_; c++) {
+            if (frames[c] == nullptr) {
+                return FFTSTATUS::NULL_POINTER;
+            }
+        }
+        for (std::size_t p = 0; p < pairs(); p++) {
+            if (out[p] == nullptr) {
+                return FFTSTATUS::NULL_POINTER;
+            }
+        }
+
+        const std::size_t bins = nfft_ / 2 + 1;
+        auto forward = [this, frames, bins](std::size_t begin,
+                                            std::size_t end) {
+            for (std::size_t c = begin; c < end; c++) {
+                C* spectrum = spectra_.data() + c * stride_;
+                internal::rfftForwardZeroPadded<T>(frames[c], frameSize_,
+                                                   spectrum,
+                                                   forwardTwiddles_.data(),
+                                                   nfft_);
+                if (weighting_ == CrossWeighting::PHAT) {
+                    // The PHAT weight 1 / |conj(X) * Y| of a pair is the
+                    // product of the weights of its channels, so it is
+                    // applied once per channel.
+                    internal::normalizeSpectrum<T>(spectrum, bins);
+                }
+            }
+            return FFTSTATUS::OK;
+        };
+        auto backward = [this, out, bins](std::size_t begin,
+                                          std::size_t end) {
+            // The cross-spectrum is scrambled in place, the inverse
+            // transform writes behind it.
+            C* scratch = internal::threadScratch<T>(2 * bins);
+            if (scratch == nullptr) {
+                return FFTSTATUS::ALLOCATION_FAILED;
+            }
+            for (std::size_t p = begin; p < end; p++) {
+                correlate(p, scratch, scratch + bins, out[p]);
+            }
+            return FFTSTATUS::OK;
+        };
+
+        const std::size_t spectrumBytes = bins * sizeof(C);
+        FFTSTATUS status = run(channels_, spectrumBytes, forward, pool);
+        if (status != FFTSTATUS::OK) {
+            return status;
+        }
+        return run(pairs(), 3 * spectrumBytes, backward, pool);
+    }
+
+    template <typename Function>
+    static FFTSTATUS run(std::size_t count, std::size_t itemBytes,
+                         Function& function, ThreadPool* pool) noexcept
+    {
+        if (pool == nullptr) {
+            return function(0, count);
+        }
+        std::atomic<FFTSTATUS> status{FFTSTATUS::OK};
+        const std::size_t chunk =
+            internal::batchChunkSize(count, itemBytes, pool->size());
+        internal::parallelChunks(
+            *pool, count, chunk,
+            [&function, &status](std::size_t begin, std::size_t end) {
+                FFTSTATUS chunkStatus = function(begin, end);
+                if (chunkStatus != FFTSTATUS::OK) {
+                    status.store(chunkStatus);
+                }
+            });
+        return status.load();
+    }
+
+    void correlate(std::size_t p, C* cross, C* result, T* out) const noexcept
+    {
+        const C* x = spectra_.data() + pairs_[2 * p] * stride_;
+        const C* y = spectra_.data() + pairs_[2 * p + 1] * stride_;
+        internal::multiplyConjugateSpectrum<T>(cross, x, y, nfft_ / 2 + 1);
+        internal::rfftInverseScramble<T>(cross, cross, backwardTwiddles_.data(),
+                                         nfft_);
+        internal::cfftInverse<T>(cross, result, backwardTwiddles_.data(),
+                                 nfft_ / 2);
+        // Only the lags of the window are deinterleaved, the factor 2 of the
+        // folded spectrum and 1 / fftSize() applied on the way.
+        const T* values = reinterpret_cast<const T*>(result);
+        const T scale{T(2) / (T)nfft_};
+        for (std::size_t lag = 0; lag <= maxLag_; lag++) {
+            out[maxLag_ + lag] = scale * values[lag];
+        }
+        for (std::size_t lag = 1; lag <= maxLag_; lag++) {
+            out[maxLag_ - lag] = scale * values[nfft_ - lag];
+        }
+    }
+
+    std::size_t frameSize_{0};
+    std::size_t channels_{0};
+    std::size_t maxLag_{0};
+    std::size_t nfft_{0};
+    // Distance of the spectra of two channels, a multiple of 8 values keeps
+    // every spectrum aligned.
+    std::size_t stride_{0};
+    CrossWeighting weighting_{CrossWeighting::NONE};
+    internal::AlignedBuffer<C> forwardTwiddles_;
+    internal::AlignedBuffer<C> backwardTwiddles_;
+    internal::AlignedBuffer<C> spectra_;
+    // The channels i and j of every pair.
+    internal::AlignedBuffer<std::uint32_t> pairs_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildCrossCorrelator(const std::size_t frameSize,
+                               const std::size_t channels,
+                               const std::size_t maxLag,
+                               const CrossWeighting weighting,
+                               CrossCorrelator<T>& correlator) noexcept
+{
+    if (frameSize == 0 || channels < 2 || maxLag >= frameSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    std::size_t nfft = minimumRfftSize;
+    while (nfft < frameSize + maxLag) {
+        nfft *= 2;
+    }
+
+    CrossCorrelator<T> created;
+    created.frameSize_ = frameSize;
+    created.channels_ = channels;
+    created.maxLag_ = maxLag;
+    created.nfft_ = nfft;
+    created.stride_ = (nfft / 2 + 1 + 7) & ~(std::size_t)7;
+    created.weighting_ = weighting;
+    const std::size_t pairs = channels * (channels - 1) / 2;
+    try {
+        created.forwardTwiddles_ = AlignedBuffer<std::complex<T>>(nfft);
+        created.backwardTwiddles_ = AlignedBuffer<std::complex<T>>(nfft);
+        created.spectra_ =
+            AlignedBuffer<std::complex<T>>(channels * created.stride_);
+        created.pairs_ = AlignedBuffer<std::uint32_t>(2 * pairs);
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+    populateRfftTwiddles<T>(created.forwardTwiddles_.data(), nfft, false);
+    populateRfftTwiddles<T>(created.backwardTwiddles_.data(), nfft, true);
+    std::size_t p = 0;
+    for (std::size_t i = 0; i < channels; i++) {
+        for (std::size_t j = i + 1; j < channels; j++) {
+            created.pairs_[2 * p] = (std::uint32_t)i;
+            created.pairs_[2 * p + 1] = (std::uint32_t)j;
+            p++;
+        }
+    }
+
+    correlator = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Correlator of every pair of channels for frames of frameSize values and the
+// lags -maxLag to maxLag, maxLag < frameSize.
+template <typename T>
+FFTSTATUS createCrossCorrelator(const std::size_t frameSize,
+                                const std::size_t channels,
+                                const std::size_t maxLag,
+                                const CrossWeighting weighting,
+                                CrossCorrelator<T>& correlator) noexcept
+{
+    return internal::buildCrossCorrelator<T>(frameSize, channels, maxLag,
+                                             weighting, correlator);
+}
+
+// GCC-PHAT over all lags -(frameSize - 1) to frameSize - 1.
+template <typename T>
+FFTSTATUS createCrossCorrelator(const std::size_t frameSize,
+                                const std::size_t channels,
+                                CrossCorrelator<T>& correlator) noexcept
+{
+    return createCrossCorrelator<T>(frameSize, channels,
+                                    frameSize == 0 ? 0 : frameSize - 1,
+                                    CrossWeighting::PHAT, correlator);
+}
+} // namespace splitradixfft
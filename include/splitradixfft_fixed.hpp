@@ -0,0 +1,324 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_fixed.hpp
+ * Transforms of a size known at compile time. The split-radix tree is
+ * instantiated as templates, every leaf and combine sees its size, input offset
+ * and stride as constants and the twiddle factors are constexpr tables in the
+ * binary. No table has to be allocated or populated before the first call.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft.hpp"
+#include <array>
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace splitradixfft {
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+constexpr long double constexprPi = 3.141592653589793238462643383279502884L;
+
+// Taylor series of sin and cos, accurate to long double precision for
+// |x| <= pi/4.
+constexpr long double constexprSinOctant(long double x)
+{
+    long double term = x;
+    long double sum = x;
+    for (int n = 1; n < 16; n++) {
+        term *= -x * x / (long double)((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr long double constexprCosOctant(long double x)
+{
+    long double term = 1;
+    long double sum = 1;
+    for (int n = 1; n < 16; n++) {
+        term *= -x * x / (long double)((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+    return sum;
+}
+
+// cos and sin of 2 pi k / N. The angle is reduced to the first octant with
+// integer arithmetic, symmetric twiddle factors are exactly symmetric.
+constexpr std::pair<long double, long double> constexprUnitRoot(std::size_t k,
+                                                                std::size_t N)
+{
+    k %= N;
+    // 2 pi k / N = quadrant * pi / 2 + r * pi / (2 N) with 0 <= r < N.
+    const std::size_t quadrant = 4 * k / N;
+    const std::size_t r = 4 * k - quadrant * N;
+    long double c = 0;
+    long double s = 0;
+    if (2 * r <= N) {
+        const long double x =
+            constexprPi * (long double)r / (long double)(2 * N);
+        c = constexprCosOctant(x);
+        s = constexprSinOctant(x);
+    } else {
+        const long double x =
+            constexprPi * (long double)(N - r) / (long double)(2 * N);
+        c = constexprSinOctant(x);
+        s = constexprCosOctant(x);
+    }
+    switch (quadrant) {
+    case 1:
+        return {-s, c};
+    case 2:
+        return {-c, -s};
+    case 3:
+        return {s, -c};
+    default:
+        return {c, s};
+    }
+}
+
+// w^(k * step + first) with w = exp(-+ 2 pi j / N).
+template <typename T, std::size_t N, bool F, std::size_t Step,
+          std::size_t First, std::size_t... I>
+constexpr std::array<std::complex<T>, sizeof...(I)>
+fixedTwiddleTable(std::index_sequence<I...>)
+{
+    return {{std::complex<T>(
+        (T)constexprUnitRoot(I * Step + First, N).first,
+        (F ? (T)1 : (T)-1) *
+            (T)constexprUnitRoot(I * Step + First, N).second)...}};
+}
+
+// Twiddle factors of the complex transform, the root combine reads N/4 of them.
+template <typename T, std::size_t N, bool F>
+struct FixedCfftTwiddles {
+    static constexpr std::array<std::complex<T>, N / 4> values =
+        fixedTwiddleTable<T, N, F, 1, 0>(std::make_index_sequence<N / 4>());
+};
+
+// Twiddle factors of the real transform, split into the even and odd powers of
+// w like the second half of populateRfftTwiddles. The leading N/8 even powers
+// are the twiddle factors of the complex transform of size N/2.
+template <typename T, std::size_t N, bool F>
+struct FixedRfftTwiddles {
+    static constexpr std::array<std::complex<T>, N / 4> even =
+        fixedTwiddleTable<T, N, F, 2, 0>(std::make_index_sequence<N / 4>());
+    static constexpr std::array<std::complex<T>, N / 4> odd =
+        fixedTwiddleTable<T, N, F, 2, 1>(std::make_index_sequence<N / 4>());
+};
+
+// Node of the split-radix tree of transformRecursion with the input offset and
+// stride as template arguments. Offset is already reduced by Mask.
+template <typename T, bool F, std::size_t N, std::size_t Offset,
+          std::size_t Stride, std::size_t Mask>
+struct FixedRecursion {
+    // load(i) returns the i-th value of the input sequence.
+    template <typename Load>
+    static inline void run(std::complex<T>* out,
+                           const std::complex<T>* twiddle, Load load)
+    {
+        if constexpr (N <= maxLeafSize) {
+            transformLeaf<T, F>(out, N, [load](std::size_t k) {
+                return load((Offset + k * Stride) & Mask);
+            });
+        } else {
+            FixedRecursion<T, F, N / 2, Offset, 2 * Stride, Mask>::run(
+                out, twiddle, load);
+            FixedRecursion<T, F, N / 4, (Offset + Stride) & Mask, 4 * Stride,
+                           Mask>::run(out + N / 2, twiddle, load);
+            FixedRecursion<T, F, N / 4, (Offset + Mask + 1 - Stride) & Mask,
+                           4 * Stride, Mask>::run(out + 3 * N / 4, twiddle,
+                                                  load);
+            combineButterflies<T, F>(out, twiddle, Stride, N);
+        }
+    }
+};
+
+// In-place variant of FixedRecursion for data reordered by FixedPermutation,
+// every leaf finds its input in the range it overwrites. Nodes of the same size
+// share one instantiation.
+template <typename T, bool F, std::size_t N, std::size_t Stride>
+struct FixedPermutedRecursion {
+    static inline void run(std::complex<T>* data,
+                           const std::complex<T>* twiddle)
+    {
+        if constexpr (N <= maxLeafSize) {
+            transformLeaf<T, F>(data, N,
+                                [data](std::size_t k) { return data[k]; });
+        } else {
+            FixedPermutedRecursion<T, F, N / 2, 2 * Stride>::run(data,
+                                                                 twiddle);
+            FixedPermutedRecursion<T, F, N / 4, 4 * Stride>::run(
+                data + N / 2, twiddle);
+            FixedPermutedRecursion<T, F, N / 4, 4 * Stride>::run(
+                data + 3 * N / 4, twiddle);
+            combineButterflies<T, F>(data, twiddle, Stride, N);
+        }
+    }
+};
+
+template <std::size_t Size>
+constexpr void fixedPermutationNode(std::array<std::uint32_t, Size>& values,
+                                    std::size_t outIndex, std::size_t offset,
+                                    std::size_t stride, std::size_t N)
+{
+    if (N <= maxLeafSize) {
+        for (std::size_t k = 0; k < N; k++) {
+            values[outIndex + k] =
+                (std::uint32_t)((offset + k * stride) & (Size - 1));
+        }
+        return;
+    }
+    fixedPermutationNode(values, outIndex, offset, 2 * stride, N / 2);
+    fixedPermutationNode(values, outIndex + N / 2, offset + stride,
+                         4 * stride, N / 4);
+    fixedPermutationNode(values, outIndex + 3 * N / 4, offset + Size - stride,
+                         4 * stride, N / 4);
+}
+
+// Compile-time equivalent of buildPermutation, data[j] = in[values[j]].
+template <std::size_t N>
+struct FixedPermutation {
+    static constexpr std::array<std::uint32_t, N> build()
+    {
+        std::array<std::uint32_t, N> values{};
+        fixedPermutationNode(values, 0, 0, 1, N);
+        return values;
+    }
+
+    static constexpr std::array<std::uint32_t, N> values = build();
+};
+
+// Complex transform of N points, load(i) returns the i-th input value.
+template <typename T, bool F, std::size_t N, typename Load>
+inline void fixedCfft(std::complex<T>* out, const std::complex<T>* twiddle,
+                      Load load)
+{
+    if constexpr (N >= permutedScheduleThreshold) {
+        const std::uint32_t* permutation = FixedPermutation<N>::values.data();
+        for (std::size_t j = 0; j < N; j++) {
+            out[j] = load(permutation[j]);
+        }
+        FixedPermutedRecursion<T, F, N, 1>::run(out, twiddle);
+    } else {
+        FixedRecursion<T, F, N, 0, 1, N - 1>::run(out, twiddle, load);
+    }
+}
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+// Transform of N points in the given direction, for both the complex and the
+// real transform. The results equal the ones of the functions in
+// splitradixfft.hpp up to the rounding of the twiddle factors, which are
+// computed in long double precision at compile time. Large N increase the
+// compile time, every node of the split-radix tree is its own instantiation.
+template <typename T, std::size_t N, Direction D>
+class FixedFft {
+public:
+    static_assert(N > 0 && (N & (N - 1)) == 0, "N must be a power of 2");
+
+    using C = std::complex<T>;
+
+    static constexpr std::size_t size() { return N; }
+
+    static constexpr Direction direction() { return D; }
+
+    // Scratch values of the real transform, see execute(const C*, T*, C*).
+    static constexpr std::size_t realScratchSize()
+    {
+        return D == Direction::FORWARD ? 0 : N;
+    }
+
+    // Complex transform of N values, in and out must not overlap.
+    static void execute(const C* in, C* out) noexcept
+    {
+        internal::fixedCfft<T, inverse, N>(
+            out, internal::FixedCfftTwiddles<T, N, inverse>::values.data(),
+            [in](std::size_t i) { return in[i]; });
+    }
+
+    // Forward real transform of N values into the N/2+1 bins of the half
+    // spectrum. The interleaving of the real input is folded into the leaves,
+    // no scratch is required.
+    static void execute(const T* in, C* out) noexcept
+    {
+        static_assert(D == Direction::FORWARD,
+                      "the real input transform is the forward transform");
+        static_assert(N >= internal::minimumRfftSize,
+                      "the real transform requires N >= 8");
+        using Twiddles = internal::FixedRfftTwiddles<T, N, false>;
+        internal::fixedCfft<T, false, N / 2>(
+            out, Twiddles::even.data(), [in](std::size_t i) {
+                return C(in[2 * i], in[2 * i + 1]);
+            });
+        internal::rfftForwardUnscramble<T>(out, Twiddles::even.data(),
+                                           Twiddles::odd.data(), N);
+    }
+
+    // Backward real transform of the N/2+1 bins of the half spectrum into N
+    // values, unnormalized like performRfftBackward. scratch holds
+    // realScratchSize() values, in is not modified.
+    static void execute(const C* in, T* out, C* scratch) noexcept
+    {
+        static_assert(D == Direction::BACKWARD,
+                      "the real output transform is the backward transform");
+        static_assert(N >= internal::minimumRfftSize,
+                      "the real transform requires N >= 8");
+        using Twiddles = internal::FixedRfftTwiddles<T, N, true>;
+        internal::rfftInverseScramble<T>(in, scratch, Twiddles::even.data(),
+                                         Twiddles::odd.data(), N);
+        C* result = scratch + N / 2;
+        internal::fixedCfft<T, true, N / 2>(
+            result, Twiddles::even.data(),
+            [scratch](std::size_t i) { return scratch[i]; });
+        for (std::size_t i = 0; i < N / 2; i++) {
+            out[2 * i] = (T)2 * result[i].real();
+            out[2 * i + 1] = (T)2 * result[i].imag();
+        }
+    }
+
+private:
+    static constexpr bool inverse = D == Direction::BACKWARD;
+};
+} // namespace splitradixfft
@@ -0,0 +1,423 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_nd.hpp
+ * Two and three dimensional transforms of row-major arrays, built from one
+ * split-radix plan per axis. The last axis is transformed row by row, the
+ * other axes move blocks of columns through thread local tiles like the
+ * four-step plans. Real transforms produce the half-complex spectrum with
+ * n / 2 + 1 values along the last axis.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft_plan.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace splitradixfft {
+
+template <typename T>
+class PlanND;
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+constexpr std::size_t maximumRank = 3;
+
+template <typename T>
+FFTSTATUS buildPlanND(const std::size_t rank, const std::size_t* dims,
+                      const TransformType type, const Direction direction,
+                      const Normalization normalization, const T customScale,
+                      PlanND<T>& plan) noexcept;
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+template <typename T>
+class PlanND {
+public:
+    using C = std::complex<T>;
+
+    PlanND() = default;
+    PlanND(const PlanND&) = delete;
+    PlanND& operator=(const PlanND&) = delete;
+    PlanND(PlanND&&) noexcept = default;
+    PlanND& operator=(PlanND&&) noexcept = default;
+
+    // Number of axes, 2 or 3, and the number of values along an axis.
+    std::size_t rank() const noexcept { return rank_; }
+    std::size_t size(std::size_t axis) const noexcept { return dims_[axis]; }
+    TransformType type() const noexcept { return type_; }
+    Direction direction() const noexcept { return direction_; }
+    T scale() const noexcept { return scale_; }
+
+    // Number of values of the real array and of the complex array, which
+    // holds size(rank() - 1) / 2 + 1 values per row for real plans.
+    std::size_t realSize() const noexcept { return rows_ * dims_[rank_ - 1]; }
+    std::size_t complexSize() const noexcept { return rows_ * rowLength_; }
+
+    // Number of complex values of scratch the const real backward overloads
+    // of execute require, 0 for the other plans.
+    std::size_t scratchSize() const noexcept
+    {
+        return type_ == TransformType::REAL && direction_ == Direction::BACKWARD
+                   ? complexSize()
+                   : 0;
+    }
+
+    // Complex transform of complexSize() values. in and out may not alias.
+    void execute(const C* in, C* out) const noexcept
+    {
+        forward(in, out, nullptr);
+    }
+
+    // Real forward transform of realSize() values into complexSize() values.
+    void execute(const T* in, C* out) const noexcept
+    {
+        forward(in, out, nullptr);
+    }
+
+    // Real backward transform of complexSize() values into realSize()
+    // values. The input is left untouched.
+    void execute(const C* in, T* out) noexcept
+    {
+        backward(in, out, scratch_.data(), nullptr);
+    }
+
+    // Same as above with caller provided scratch of scratchSize() values, the
+    // overload does not modify the plan.
+    void execute(const C* in, T* out, C* scratch) const noexcept
+    {
+        backward(in, out, scratch, nullptr);
+    }
+
+    // Same as the overloads above, but the rows and the blocks of columns of
+    // every matrix are spread over the threads of pool. The results are
+    // identical to the serial execution.
+    void execute(const C* in, C* out, ThreadPool& pool) const noexcept
+    {
+        forward(in, out, &pool);
+    }
+
+    void execute(const T* in, C* out, ThreadPool& pool) const noexcept
+    {
+        forward(in, out, &pool);
+    }
+
+    void execute(const C* in, T* out, ThreadPool& pool) noexcept
+    {
+        backward(in, out, scratch_.data(), &pool);
+    }
+
+    void execute(const C* in, T* out, C* scratch,
+                 ThreadPool& pool) const noexcept
+    {
+        backward(in, out, scratch, &pool);
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildPlanND(const std::size_t rank,
+                                           const std::size_t* dims,
+                                           const TransformType type,
+                                           const Direction direction,
+                                           const Normalization normalization,
+                                           const U customScale,
+                                           PlanND<U>& plan) noexcept;
+
+    template <typename Function>
+    static void split(ThreadPool* pool, std::size_t count, std::size_t grain,
+                      Function function) noexcept
+    {
+        if (pool != nullptr) {
+            internal::parallelChunks(*pool, count, grain, function);
+        } else {
+            function(0, count);
+        }
+    }
+
+    template <typename In>
+    void forward(const In* in, C* out, ThreadPool* pool) const noexcept
+    {
+        // The rows of the last axis first, the complex and real forward plans
+        // read their input in place. The remaining axes then run in place on
+        // out.
+        const Plan<T>& plan = plans_[rank_ - 1];
+        const std::size_t length = dims_[rank_ - 1];
+        auto rows = [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r = begin; r < end; r++) {
+                plan.execute(in + r * length, out + r * rowLength_);
+            }
+        };
+        split(pool, rows_, rowGrain(), rows);
+        for (std::size_t axis = rank_ - 1; axis-- > 0;) {
+            columns(axis, out, out, pool);
+        }
+    }
+
+    void backward(const C* in, T* out, C* scratch,
+                  ThreadPool* pool) const noexcept
+    {
+        // The columns first, the first axis reads the input and writes the
+        // scratch so the input stays untouched. The real rows are last.
+        for (std::size_t axis = 0; axis + 1 < rank_; axis++) {
+            columns(axis, axis == 0 ? in : scratch, scratch, pool);
+        }
+        const Plan<T>& plan = plans_[rank_ - 1];
+        const std::size_t length = dims_[rank_ - 1];
+        auto rows = [&](std::size_t begin, std::size_t end) {
+            internal::TileLease<T> lease(plan.scratchSize(), *reservedTiles_);
+            C* rowScratch = lease.data();
+            for (std::size_t r = begin; r < end; r++) {
+                plan.execute(scratch + r * rowLength_, out + r * length,
+                             rowScratch);
+            }
+        };
+        split(pool, rows_, rowGrain(), rows);
+    }
+
+    // Columns per tile of axis, fewer than fourStepBlock for narrow arrays.
+    std::size_t columnBlock(std::size_t axis) const noexcept
+    {
+        std::size_t count = dims_[axis];
+        for (std::size_t a = 0; a < axis; a++) {
+            count *= dims_[a];
+        }
+        return std::min(internal::fourStepBlock, complexSize() / count);
+    }
+
+    // Tile and transformed tile of the columns of axis.
+    std::size_t columnTileSize(std::size_t axis) const noexcept
+    {
+        return 2 * columnBlock(axis) *
+               (dims_[axis] + internal::fourStepPadding);
+    }
+
+    std::size_t rowGrain() const noexcept
+    {
+        return std::max<std::size_t>(1, internal::parallelGatherGrain /
+                                            rowLength_);
+    }
+
+    void columns(std::size_t axis, const C* src, C* dst,
+                 ThreadPool* pool) const noexcept
+    {
+        // The array is a stack of `count` row-major matrices of n x width
+        // values, axis runs along the columns of every matrix. Blocks of
+        // columns are gathered into a tile, transformed contiguously and
+        // scattered back row by row.
+        const Plan<T>& plan = plans_[axis];
+        const std::size_t n = dims_[axis];
+        std::size_t count = 1;
+        for (std::size_t a = 0; a < axis; a++) {
+            count *= dims_[a];
+        }
+        const std::size_t width = complexSize() / (count * n);
+        const std::size_t block = columnBlock(axis);
+        const std::size_t pitch = n + internal::fourStepPadding;
+        const std::size_t blocks = (width + block - 1) / block;
+        auto run = [&](std::size_t begin, std::size_t end) {
+            internal::TileLease<T> lease(columnTileSize(axis),
+                                         *reservedTiles_);
+            C* tile = lease.data();
+            C* result = tile + block * pitch;
+            for (std::size_t t = begin; t < end; t++) {
+                const std::size_t matrix = (t / blocks) * n * width;
+                const std::size_t c = (t % blocks) * block;
+                const std::size_t span = std::min(block, width - c);
+                for (std::size_t i = 0; i < n; i++) {
+                    const C* row = src + matrix + i * width + c;
+                    for (std::size_t b = 0; b < span; b++) {
+                        tile[b * pitch + i] = row[b];
+                    }
+                }
+                for (std::size_t b = 0; b < span; b++) {
+                    plan.execute(tile + b * pitch, result + b * pitch);
+                }
+                for (std::size_t i = 0; i < n; i++) {
+                    C* row = dst + matrix + i * width + c;
+                    for (std::size_t b = 0; b < span; b++) {
+                        row[b] = result[b * pitch + i];
+                    }
+                }
+            }
+        };
+        split(pool, count * blocks,
+              std::max<std::size_t>(1, internal::parallelGatherGrain /
+                                           (block * n)),
+              run);
+    }
+
+    std::size_t rank_{0};
+    std::size_t dims_[internal::maximumRank]{};
+    // Rows of the last axis and complex values per row.
+    std::size_t rows_{0};
+    std::size_t rowLength_{0};
+    TransformType type_{TransformType::COMPLEX};
+    Direction direction_{Direction::FORWARD};
+    T scale_{1};
+    // One plan per axis, the plan of the last axis is real for real plans and
+    // applies the normalization.
+    Plan<T> plans_[internal::maximumRank];
+    internal::AlignedBuffer<std::complex<T>> scratch_;
+    // The largest column tile or real row scratch, see TileLease.
+    std::unique_ptr<internal::ReservedTiles<T>> reservedTiles_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildPlanND(const std::size_t rank, const std::size_t* dims,
+                      const TransformType type, const Direction direction,
+                      const Normalization normalization, const T customScale,
+                      PlanND<T>& plan) noexcept
+{
+    PlanND<T> created;
+    created.rank_ = rank;
+    created.type_ = type;
+    created.direction_ = direction;
+    std::size_t total = 1;
+    for (std::size_t axis = 0; axis < rank; axis++) {
+        created.dims_[axis] = dims[axis];
+        total *= dims[axis];
+    }
+    created.rowLength_ =
+        type == TransformType::COMPLEX ? dims[rank - 1] : dims[rank - 1] / 2 + 1;
+    created.scale_ = normalizationScale<T>(normalization, total, customScale);
+
+    // The axis plans validate the sizes, only the last axis is real. They run
+    // on the tiles of fourStepTiles, so they must not use the four-step
+    // algorithm, which gathers its own blocks into the same buffer.
+    for (std::size_t axis = 0; axis < rank; axis++) {
+        const bool last = axis + 1 == rank;
+        FFTSTATUS status = buildPlan<T>(
+            dims[axis], last ? type : TransformType::COMPLEX, direction, false,
+            SIZE_MAX, last ? created.scale_ : T(1), created.plans_[axis]);
+        if (status != FFTSTATUS::OK) {
+            return status;
+        }
+    }
+    created.rows_ = total / dims[rank - 1];
+    std::size_t tiles = created.plans_[rank - 1].scratchSize();
+    for (std::size_t axis = 0; axis + 1 < rank; axis++) {
+        tiles = std::max(tiles, created.columnTileSize(axis));
+    }
+    try {
+        created.scratch_ =
+            AlignedBuffer<std::complex<T>>(created.scratchSize());
+        created.reservedTiles_ = std::make_unique<ReservedTiles<T>>();
+        created.reservedTiles_->tiles = AlignedBuffer<std::complex<T>>(tiles);
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+
+    plan = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Transform of a row-major n0 x n1 array, every size a power of two. Real
+// plans require n1 >= 8 and transform between n0 x n1 real values and
+// n0 x (n1 / 2 + 1) complex values.
+template <typename T>
+FFTSTATUS createPlan2D(const std::size_t n0, const std::size_t n1,
+                       const TransformType type, const Direction direction,
+                       const Normalization normalization, const T customScale,
+                       PlanND<T>& plan) noexcept
+{
+    const std::size_t dims[] = {n0, n1};
+    return internal::buildPlanND<T>(2, dims, type, direction, normalization,
+                                    customScale, plan);
+}
+
+template <typename T>
+FFTSTATUS createPlan2D(const std::size_t n0, const std::size_t n1,
+                       const TransformType type, const Direction direction,
+                       const Normalization normalization,
+                       PlanND<T>& plan) noexcept
+{
+    return createPlan2D<T>(n0, n1, type, direction, normalization, T(1), plan);
+}
+
+template <typename T>
+FFTSTATUS createPlan2D(const std::size_t n0, const std::size_t n1,
+                       const TransformType type, const Direction direction,
+                       PlanND<T>& plan) noexcept
+{
+    return createPlan2D<T>(n0, n1, type, direction, Normalization::NONE, T(1),
+                           plan);
+}
+
+// Same as above for a row-major n0 x n1 x n2 array, real plans have
+// n0 x n1 x (n2 / 2 + 1) complex values.
+template <typename T>
+FFTSTATUS createPlan3D(const std::size_t n0, const std::size_t n1,
+                       const std::size_t n2, const TransformType type,
+                       const Direction direction,
+                       const Normalization normalization, const T customScale,
+                       PlanND<T>& plan) noexcept
+{
+    const std::size_t dims[] = {n0, n1, n2};
+    return internal::buildPlanND<T>(3, dims, type, direction, normalization,
+                                    customScale, plan);
+}
+
+template <typename T>
+FFTSTATUS createPlan3D(const std::size_t n0, const std::size_t n1,
+                       const std::size_t n2, const TransformType type,
+                       const Direction direction,
+                       const Normalization normalization,
+                       PlanND<T>& plan) noexcept
+{
+    return createPlan3D<T>(n0, n1, n2, type, direction, normalization, T(1),
+                           plan);
+}
+
+template <typename T>
+FFTSTATUS createPlan3D(const std::size_t n0, const std::size_t n1,
+                       const std::size_t n2, const TransformType type,
+                       const Direction direction, PlanND<T>& plan) noexcept
+{
+    return createPlan3D<T>(n0, n1, n2, type, direction, Normalization::NONE,
+                           T(1), plan);
+}
+} // namespace splitradixfft
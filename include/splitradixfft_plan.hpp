@@ -0,0 +1,978 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_plan.hpp
+ * Reusable transform plans. Contrary to the functions in splitradixfft.hpp a
+ * plan allocates and owns the twiddle factors and the scratch space. All
+ * arguments are validated once when the plan is created, executing the plan is
+ * unchecked.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft.hpp"
+#include "splitradixfft_threads.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace splitradixfft {
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+// Alignment of the plan owned buffers, one cache line which also covers the
+// widest (AVX-512) register.
+constexpr std::size_t bufferAlignment = 64;
+
+template <typename T>
+class AlignedBuffer {
+public:
+    AlignedBuffer() = default;
+
+    // Throws std::bad_alloc, the values are zero initialized.
+    explicit AlignedBuffer(std::size_t size)
+    {
+        if (size == 0) {
+            return;
+        }
+        data_ = static_cast<T*>(::operator new(
+            size * sizeof(T), std::align_val_t(bufferAlignment)));
+        for (std::size_t i = 0; i < size; i++) {
+            new (data_ + i) T();
+        }
+        size_ = size;
+    }
+
+    AlignedBuffer(const AlignedBuffer&) = delete;
+    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
+
+    AlignedBuffer(AlignedBuffer&& other) noexcept
+        : data_(std::exchange(other.data_, nullptr)),
+          size_(std::exchange(other.size_, 0))
+    {
+    }
+
+    AlignedBuffer& operator=(AlignedBuffer&& other) noexcept
+    {
+        if (this != &other) {
+            release();
+            data_ = std::exchange(other.data_, nullptr);
+            size_ = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    ~AlignedBuffer() { release(); }
+
+    T* data() noexcept { return data_; }
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    T& operator[](std::size_t i) noexcept { return data_[i]; }
+    const T& operator[](std::size_t i) const noexcept { return data_[i]; }
+
+private:
+    void release() noexcept
+    {
+        if (data_ != nullptr) {
+            for (std::size_t i = 0; i < size_; i++) {
+                data_[i].~T();
+            }
+            ::operator delete(data_, std::align_val_t(bufferAlignment));
+        }
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    T* data_{nullptr};
+    std::size_t size_{0};
+};
+
+// Complex transforms of this many bytes and more default to the four-step
+// algorithm. The depth-first recursion is faster as long as a good part of
+// its working set stays in the last level cache, the crossover moves with the
+// cache size, see benchmarks/four_step.cpp.
+constexpr std::size_t fourStepThresholdBytes = (std::size_t)1 << 27;
+
+template <typename T>
+constexpr std::size_t defaultFourStepThreshold()
+{
+    return fourStepThresholdBytes / sizeof(std::complex<T>);
+}
+
+// The four-step algorithm transposes blocks of this many columns at once, a
+// few cache lines per row of the matrix.
+constexpr std::size_t fourStepBlock = 16;
+
+// Padding of the tile rows in values. Rows a power of two apart map to the
+// same cache sets, which makes the transposes thrash the L1 cache.
+constexpr std::size_t fourStepPadding = 8;
+
+// Smallest four-step transform, both factors have to hold a block of columns.
+constexpr std::size_t fourStepMinimumSize = (std::size_t)1 << 12;
+
+template <typename T>
+inline std::complex<T> fourStepRoot(const std::complex<T>* low,
+                                    const std::complex<T>* high,
+                                    std::size_t n1, std::size_t shift,
+                                    std::size_t m)
+{
+    // w_N^m = w_N^(m mod N1) * w_N2^(m / N1), see Plan::fourStep.
+    const std::complex<T> a{low[m & (n1 - 1)]};
+    const std::complex<T> b{high[m >> shift]};
+    return std::complex<T>(a.real() * b.real() - a.imag() * b.imag(),
+                           a.real() * b.imag() + a.imag() * b.real());
+}
+
+template <typename T>
+void fourStepTwiddleRow(std::complex<T>* row, std::size_t r,
+                        const std::complex<T>* low,
+                        const std::complex<T>* high, std::size_t n1,
+                        std::size_t shift)
+{
+    // row[k] *= w_N^(r * k). The factors are w_N^(r * k0) * w_N^(r * l) with
+    // k = k0 + l and l < span, the second factor only depends on the row.
+    // The multiplications are written out, std::complex would check every
+    // product for infinities.
+    constexpr std::size_t span = 16;
+    T baseRe[span];
+    T baseIm[span];
+    for (std::size_t l = 0; l < span; l++) {
+        const std::complex<T> w{fourStepRoot<T>(low, high, n1, shift, r * l)};
+        baseRe[l] = w.real();
+        baseIm[l] = w.imag();
+    }
+    for (std::size_t k0 = 0; k0 < n1; k0 += span) {
+        const std::complex<T> a{fourStepRoot<T>(low, high, n1, shift, r * k0)};
+        const T aRe{a.real()};
+        const T aIm{a.imag()};
+        T* x = reinterpret_cast<T*>(row + k0);
+        for (std::size_t l = 0; l < span; l++) {
+            const T wRe{aRe * baseRe[l] - aIm * baseIm[l]};
+            const T wIm{aRe * baseIm[l] + aIm * baseRe[l]};
+            const T xRe{x[2 * l]};
+            const T xIm{x[2 * l + 1]};
+            x[2 * l] = xRe * wRe - xIm * wIm;
+            x[2 * l + 1] = xRe * wIm + xIm * wRe;
+        }
+    }
+}
+
+template <typename T>
+std::complex<T>* fourStepTiles(std::size_t size) noexcept
+{
+    // Transposed blocks of the calling thread, the buffer grows to the largest
+    // size requested and is reused by every later transform. nullptr if
+    // growing fails.
+    static thread_local std::vector<std::complex<T>> tiles;
+    if (tiles.size() < size) {
+        try {
+            tiles.resize(size);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+    return tiles.data();
+}
+
+// Tiles a plan allocates when it is created. The execute overloads have no
+// status to report a failed allocation with, a thread that cannot grow its
+// own tiles borrows these under the lock instead.
+template <typename T>
+struct ReservedTiles {
+    AlignedBuffer<std::complex<T>> tiles;
+    std::mutex mutex;
+};
+
+// The tiles of the calling thread, or the reserved tiles for the lifetime of
+// the lease. reserved must hold at least size values.
+template <typename T>
+class TileLease {
+public:
+    TileLease(std::size_t size, ReservedTiles<T>& reserved) noexcept
+        : tiles_(fourStepTiles<T>(size))
+    {
+        if (tiles_ == nullptr) {
+            lock_ = std::unique_lock<std::mutex>(reserved.mutex);
+            tiles_ = reserved.tiles.data();
+        }
+    }
+
+    std::complex<T>* data() const noexcept { return tiles_; }
+
+private:
+    std::unique_lock<std::mutex> lock_;
+    std::complex<T>* tiles_;
+};
+
+template <typename T>
+void transposeSquareInPlace(std::complex<T>* data, std::size_t n)
+{
+    // Swap blocks of fourStepBlock x fourStepBlock values across the
+    // diagonal, n is a multiple of fourStepBlock.
+    constexpr std::size_t block = fourStepBlock;
+    for (std::size_t bi = 0; bi < n; bi += block) {
+        for (std::size_t bj = bi; bj < n; bj += block) {
+            for (std::size_t i = bi; i < bi + block; i++) {
+                for (std::size_t j = bi == bj ? i + 1 : bj; j < bj + block;
+                     j++) {
+                    std::swap(data[i * n + j], data[j * n + i]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+template <typename T>
+class Plan;
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildPlan(const std::size_t nfft, const TransformType type,
+                    const Direction direction, const bool ownScratch,
+                    const std::size_t fourStepThreshold, const T scale,
+                    Plan<T>& plan) noexcept;
+} // namespace internal
+
+template <typename T>
+class Plan {
+public:
+    using C = std::complex<T>;
+
+    Plan() = default;
+    Plan(const Plan&) = delete;
+    Plan& operator=(const Plan&) = delete;
+    Plan(Plan&&) noexcept = default;
+    Plan& operator=(Plan&&) noexcept = default;
+
+    std::size_t size() const noexcept { return nfft_; }
+    TransformType type() const noexcept { return type_; }
+    Direction direction() const noexcept { return direction_; }
+
+    // Factor every output of the plan is multiplied by, 1 unless the plan was
+    // created with a Normalization.
+    T scale() const noexcept { return scale_; }
+
+    // Number of complex values of scratch the const overloads of execute
+    // require, zero for complex plans and real forward plans.
+    std::size_t scratchSize() const noexcept
+    {
+        if (type_ == TransformType::COMPLEX ||
+            direction_ == Direction::FORWARD) {
+            return 0;
+        }
+        return nfft_;
+    }
+
+    // Bytes owned by the plan.
+    std::size_t memoryFootprint() const noexcept
+    {
+        std::size_t bytes =
+            sizeof(Plan) +
+            (twiddles_.size() + rfftTwiddles_.size() + scratch_.size()) *
+                sizeof(C) +
+            schedule_.size() * sizeof(internal::ScheduleStep) +
+            (permutation_.size() + cycleLeaders_.size()) *
+                sizeof(std::uint32_t);
+        if (fourStepFirst_) {
+            bytes += fourStepFirst_->memoryFootprint() +
+                     fourStepSecond_->memoryFootprint() +
+                     reservedTiles_->tiles.size() * sizeof(C);
+        }
+        return bytes;
+    }
+
+    // True if the complex transform runs the four-step algorithm.
+    bool usesFourStep() const noexcept { return fourStepFirst_ != nullptr; }
+
+    // Complex forward / backward transform of size() values. in and out may
+    // not alias.
+    void execute(const C* in, C* out) const noexcept
+    {
+        kernel_(*this, in, 1, out);
+    }
+
+    // Real forward transform of size() values into the half-spectrum of
+    // size() / 2 + 1 values. The half-length complex transform reads the real
+    // input as interleaved complex values, no scratch is used and the
+    // overload does not modify the plan.
+    void execute(const T* in, C* out) const noexcept
+    {
+        kernel_(*this, internal::complexView<T>(in), 1, out);
+        internal::rfftForwardUnscramble<T>(out, rfftTwiddles_.data(),
+                                           rfftTwiddles_.data() + nfft_ / 4,
+                                           nfft_, scale_);
+    }
+
+    // Real backward transform of the size() / 2 + 1 half-spectrum into
+    // size() values. The input is left untouched.
+    void execute(const C* in, T* out) noexcept
+    {
+        execute(in, out, scratch_.data());
+    }
+
+    // Same as above but with caller provided scratch of scratchSize() values.
+    // These overloads do not modify the plan and can be used concurrently on
+    // a shared plan. The forward transform ignores the scratch.
+    void execute(const T* in, C* out, C* /*scratch*/) const noexcept
+    {
+        execute(in, out);
+    }
+
+    void execute(const C* in, T* out, C* scratch) const noexcept
+    {
+        internal::rfftInverseScramble<T>(in, scratch, rfftTwiddles_.data(),
+                                         rfftTwiddles_.data() + nfft_ / 4,
+                                         nfft_);
+        kernel_(*this, scratch, 1, scratch + nfft_ / 2);
+        internal::deinterleaveSequence<T>(scratch + nfft_ / 2, out, nfft_,
+                                          (T)2 * scale_);
+    }
+
+    // Complex transform of size() values in place, the results are identical
+    // to execute. Complex plans only.
+    void executeInPlace(C* data) const noexcept
+    {
+        if (fourStepFirst_) {
+            fourStepInPlace(data);
+        } else if (direction_ == Direction::FORWARD) {
+            transformInPlace<false>(data);
+        } else {
+            transformInPlace<true>(data);
+        }
+    }
+
+    // Same as the const overloads of execute, but nodes of the transform of
+    // serialCutoff values and more spread their sub-transforms and combine
+    // loops over the threads of pool. The results are identical to the serial
+    // execution. Concurrent calls may share the plan and the pool.
+    void execute(const C* in, C* out, ThreadPool& pool,
+                 std::size_t serialCutoff =
+                     internal::parallelSerialCutoff) const noexcept
+    {
+        runParallel(in, out, pool, serialCutoff);
+    }
+
+    void execute(const T* in, C* out, ThreadPool& pool,
+                 std::size_t serialCutoff =
+                     internal::parallelSerialCutoff) const noexcept
+    {
+        runParallel(internal::complexView<T>(in), out, pool, serialCutoff);
+        internal::rfftForwardUnscramble<T>(out, rfftTwiddles_.data(),
+                                           rfftTwiddles_.data() + nfft_ / 4,
+                                           nfft_, scale_);
+    }
+
+    void execute(const T* in, C* out, C* /*scratch*/, ThreadPool& pool,
+                 std::size_t serialCutoff =
+                     internal::parallelSerialCutoff) const noexcept
+    {
+        execute(in, out, pool, serialCutoff);
+    }
+
+    void execute(const C* in, T* out, C* scratch, ThreadPool& pool,
+                 std::size_t serialCutoff =
+                     internal::parallelSerialCutoff) const noexcept
+    {
+        internal::rfftInverseScramble<T>(in, scratch, rfftTwiddles_.data(),
+                                         rfftTwiddles_.data() + nfft_ / 4,
+                                         nfft_);
+        runParallel(scratch, scratch + nfft_ / 2, pool, serialCutoff);
+        internal::deinterleaveSequence<T>(scratch + nfft_ / 2, out, nfft_,
+                                          (T)2 * scale_);
+    }
+
+    // Number of complex values of scratch executeBatch requires. Complex
+    // plans only use it when the output is strided.
+    std::size_t batchScratchSize() const noexcept
+    {
+        return type_ == TransformType::COMPLEX ? nfft_ : nfft_ + 1;
+    }
+
+    // Batched transforms of howMany sequences. Value i of sequence b is read
+    // from in[b * inDistance + i * inStride] and written to
+    // out[b * outDistance + i * outStride]. The overload is picked by the plan
+    // type like for execute, in and out may not overlap. These overloads do
+    // not modify the plan.
+    void executeBatch(std::size_t howMany, const C* in, std::size_t inStride,
+                      std::size_t inDistance, C* out, std::size_t outStride,
+                      std::size_t outDistance, C* scratch) const noexcept
+    {
+        for (std::size_t b = 0; b < howMany; b++) {
+            C* dst = out + b * outDistance;
+            if (outStride == 1) {
+                kernel_(*this, in + b * inDistance, inStride, dst);
+            } else {
+                kernel_(*this, in + b * inDistance, inStride, scratch);
+                internal::scatterSequence<T>(scratch, dst, outStride, nfft_);
+            }
+        }
+    }
+
+    void executeBatch(std::size_t howMany, const T* in, std::size_t inStride,
+                      std::size_t inDistance, C* out, std::size_t outStride,
+                      std::size_t outDistance, C* scratch) const noexcept
+    {
+        // scratch holds the half-spectrum followed by the interleaved input,
+        // contiguous inputs are read through the complex view instead.
+        C* interleaved = scratch + nfft_ / 2 + 1;
+        for (std::size_t b = 0; b < howMany; b++) {
+            const T* src = in + b * inDistance;
+            C* dst = out + b * outDistance;
+            C* result = outStride == 1 ? dst : scratch;
+            if (inStride == 1) {
+                kernel_(*this, internal::complexView<T>(src), 1, result);
+            } else {
+                for (std::size_t idx = 0; idx < nfft_ / 2; idx++) {
+                    interleaved[idx] = C(src[2 * idx * inStride],
+                                         src[(2 * idx + 1) * inStride]);
+                }
+                kernel_(*this, interleaved, 1, result);
+            }
+            internal::rfftForwardUnscramble<T>(
+                result, rfftTwiddles_.data(), rfftTwiddles_.data() + nfft_ / 4,
+                nfft_, scale_);
+            if (outStride != 1) {
+                internal::scatterSequence<T>(result, dst, outStride,
+                                             nfft_ / 2 + 1);
+            }
+        }
+    }
+
+    void executeBatch(std::size_t howMany, const C* in, std::size_t inStride,
+                      std::size_t inDistance, T* out, std::size_t outStride,
+                      std::size_t outDistance, C* scratch) const noexcept
+    {
+        // scratch holds the complex result followed by the folded input.
+        C* folded = scratch + nfft_ / 2;
+        const T factor = (T)2 * scale_;
+        for (std::size_t b = 0; b < howMany; b++) {
+            const C* src = in + b * inDistance;
+            T* dst = out + b * outDistance;
+            if (inStride != 1) {
+                for (std::size_t idx = 0; idx < nfft_ / 2 + 1; idx++) {
+                    folded[idx] = src[idx * inStride];
+                }
+                src = folded;
+            }
+            internal::rfftInverseScramble<T>(
+                src, folded, rfftTwiddles_.data(),
+                rfftTwiddles_.data() + nfft_ / 4, nfft_);
+            kernel_(*this, folded, 1, scratch);
+            for (std::size_t idx = 0; idx < nfft_ / 2; idx++) {
+                dst[2 * idx * outStride] = factor * scratch[idx].real();
+                dst[(2 * idx + 1) * outStride] = factor * scratch[idx].imag();
+            }
+        }
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildPlan(const std::size_t nfft,
+                                         const TransformType type,
+                                         const Direction direction,
+                                         const bool ownScratch,
+                                         const std::size_t fourStepThreshold,
+                                         const U scale,
+                                         Plan<U>& plan) noexcept;
+
+    // Complex transform of cfftSize_ values, the core of every plan type.
+    // Input value i is read from in[i * inStride], the outputs are multiplied
+    // by kernelScale_.
+    using Kernel = void (*)(const Plan&, const C*, std::size_t, C*);
+
+    // Only selected for transforms that are a single leaf, which read no
+    // twiddle factors.
+    template <bool F>
+    static void recursive(const Plan& plan, const C* in, std::size_t inStride,
+                          C* out)
+    {
+        auto load = [in, inStride](std::size_t i) { return in[i * inStride]; };
+        if (plan.kernelScale_ != T(1)) {
+            internal::transformNodesScaled<T, F>(
+                load, out, plan.twiddles_.data(), 0, 1, plan.cfftSize_,
+                plan.cfftSize_ - 1, plan.kernelScale_);
+        } else {
+            internal::transformNodes<T, F>(load, out, plan.twiddles_.data(), 0,
+                                           1, plan.cfftSize_,
+                                           plan.cfftSize_ - 1);
+        }
+    }
+
+    static void recursiveForward(const Plan& plan, const C* in,
+                                 std::size_t inStride, C* out)
+    {
+        recursive<false>(plan, in, inStride, out);
+    }
+
+    static void recursiveBackward(const Plan& plan, const C* in,
+                                  std::size_t inStride, C* out)
+    {
+        recursive<true>(plan, in, inStride, out);
+    }
+
+    static void permutedForward(const Plan& plan, const C* in,
+                                std::size_t inStride, C* out)
+    {
+        internal::executePermutedSchedule<T, false>(
+            plan.schedule_.data(), plan.schedule_.size(), in, out,
+            plan.twiddles_.data(), plan.permutation_.data(), plan.cfftSize_,
+            inStride, plan.kernelScale_);
+    }
+
+    static void permutedBackward(const Plan& plan, const C* in,
+                                 std::size_t inStride, C* out)
+    {
+        internal::executePermutedSchedule<T, true>(
+            plan.schedule_.data(), plan.schedule_.size(), in, out,
+            plan.twiddles_.data(), plan.permutation_.data(), plan.cfftSize_,
+            inStride, plan.kernelScale_);
+    }
+
+    void runParallel(const C* in, C* out, ThreadPool& pool,
+                     std::size_t serialCutoff) const noexcept
+    {
+        // Only the permuted schedule runs in place on independent output
+        // ranges, smaller transforms are not worth splitting anyway. The
+        // four-step algorithm spreads its blocks of columns.
+        if (pool.size() < 2 || cfftSize_ < serialCutoff) {
+            kernel_(*this, in, 1, out);
+        } else if (fourStepFirst_) {
+            fourStep(in, 1, out, &pool);
+        } else if (permutation_.size() == 0) {
+            kernel_(*this, in, 1, out);
+        } else if (direction_ == Direction::FORWARD) {
+            internal::executePermutedScheduleParallel<T, false>(
+                schedule_.data(), schedule_.size(), in, out, twiddles_.data(),
+                permutation_.data(), cfftSize_, 1, pool, serialCutoff,
+                kernelScale_);
+        } else {
+            internal::executePermutedScheduleParallel<T, true>(
+                schedule_.data(), schedule_.size(), in, out, twiddles_.data(),
+                permutation_.data(), cfftSize_, 1, pool, serialCutoff,
+                kernelScale_);
+        }
+    }
+
+    static void fourStepKernel(const Plan& plan, const C* in,
+                               std::size_t inStride, C* out)
+    {
+        plan.fourStep(in, inStride, out, nullptr);
+    }
+
+    void fourStep(const C* in, std::size_t inStride, C* out,
+                  ThreadPool* pool) const noexcept
+    {
+        // N = N1 * N2 with input value n1 * N2 + n2 in row n1, column n2 of
+        // an N1 x N2 matrix. The N1 point transforms of the columns, scaled
+        // by w_N^(n2 * k1), are stored as the rows of an N2 x N1 matrix in
+        // out. The N2 point transforms of its columns give output value
+        // k1 + N1 * k2 in place. Both passes move blocks of columns through
+        // thread local tiles, so every transform reads contiguous values and
+        // the matrices are only touched row by row.
+        const Plan& first = *fourStepFirst_;
+        const Plan& second = *fourStepSecond_;
+        const std::size_t n1 = first.cfftSize_;
+        const std::size_t n2 = second.cfftSize_;
+        const std::size_t block = internal::fourStepBlock;
+        // Rows of a tile, N2 >= N1.
+        const std::size_t pitch = n2 + internal::fourStepPadding;
+        std::size_t shift = 0;
+        while (((std::size_t)1 << shift) < n1) {
+            shift++;
+        }
+        const C* low = twiddles_.data();
+        const C* high = twiddles_.data() + n1;
+
+        auto columns = [&](std::size_t begin, std::size_t end) {
+            internal::TileLease<T> lease(2 * block * pitch, *reservedTiles_);
+            C* tile = lease.data();
+            for (std::size_t c = begin * block; c < end * block; c += block) {
+                for (std::size_t i = 0; i < n1; i++) {
+                    const C* src = in + (i * n2 + c) * inStride;
+                    for (std::size_t b = 0; b < block; b++) {
+                        tile[b * pitch + i] = src[b * inStride];
+                    }
+                }
+                for (std::size_t b = 0; b < block; b++) {
+                    C* row = out + (c + b) * n1;
+                    first.kernel_(first, tile + b * pitch, 1, row);
+                    internal::fourStepTwiddleRow<T>(row, c + b, low, high, n1,
+                                                    shift);
+                }
+            }
+        };
+        auto rows = [&](std::size_t begin, std::size_t end) {
+            internal::TileLease<T> lease(2 * block * pitch, *reservedTiles_);
+            C* tile = lease.data();
+            C* result = tile + block * pitch;
+            for (std::size_t c = begin * block; c < end * block; c += block) {
+                for (std::size_t i = 0; i < n2; i++) {
+                    const C* src = out + i * n1 + c;
+                    for (std::size_t b = 0; b < block; b++) {
+                        tile[b * pitch + i] = src[b];
+                    }
+                }
+                for (std::size_t b = 0; b < block; b++) {
+                    second.kernel_(second, tile + b * pitch, 1,
+                                   result + b * pitch);
+                }
+                for (std::size_t i = 0; i < n2; i++) {
+                    C* dst = out + i * n1 + c;
+                    for (std::size_t b = 0; b < block; b++) {
+                        dst[b] = result[b * pitch + i];
+                    }
+                }
+            }
+        };
+        if (pool != nullptr) {
+            internal::parallelChunks(*pool, n2 / block, 1, columns);
+            internal::parallelChunks(*pool, n1 / block, 1, rows);
+        } else {
+            columns(0, n2 / block);
+            rows(0, n1 / block);
+        }
+    }
+
+    template <bool F>
+    void transformInPlace(C* data) const noexcept
+    {
+        // Transforms below permutedScheduleThreshold are a single leaf, which
+        // reads all of its input before it writes. Running the kernel of
+        // execute keeps the results identical when the compiler contracts
+        // the leaf differently in different call sites.
+        if (permutation_.size() == 0) {
+            kernel_(*this, data, 1, data);
+            return;
+        }
+        internal::permuteInPlace<T>(data, permutation_.data(),
+                                    cycleLeaders_.data(),
+                                    cycleLeaders_.size());
+        internal::executePermutedSteps<T, F>(schedule_.data(),
+                                             schedule_.size(), data,
+                                             twiddles_.data(), kernelScale_);
+    }
+
+    void fourStepInPlace(C* data) const noexcept
+    {
+        // The steps of fourStep with the roles of the two matrices swapped:
+        // the N1 point transforms of the columns of the N1 x N2 input matrix
+        // and the twiddle multiply are written back to the columns, the N2
+        // point transforms run on its rows. A final transpose stores output
+        // value k1 + N1 * k2. N2 = 2 * N1 transposes the two square halves
+        // after moving the left halves of the rows in front of the right
+        // halves, by rotating the cycles in cycleLeaders_.
+        const Plan& first = *fourStepFirst_;
+        const Plan& second = *fourStepSecond_;
+        const std::size_t n1 = first.cfftSize_;
+        const std::size_t n2 = second.cfftSize_;
+        const std::size_t block = internal::fourStepBlock;
+        const std::size_t pitch = n2 + internal::fourStepPadding;
+        std::size_t shift = 0;
+        while (((std::size_t)1 << shift) < n1) {
+            shift++;
+        }
+        const C* low = twiddles_.data();
+        const C* high = twiddles_.data() + n1;
+        internal::TileLease<T> lease(2 * block * pitch, *reservedTiles_);
+        C* tile = lease.data();
+        C* result = tile + block * pitch;
+
+        for (std::size_t c = 0; c < n2; c += block) {
+            for (std::size_t i = 0; i < n1; i++) {
+                const C* src = data + i * n2 + c;
+                for (std::size_t b = 0; b < block; b++) {
+                    tile[b * pitch + i] = src[b];
+                }
+            }
+            for (std::size_t b = 0; b < block; b++) {
+                C* row = result + b * pitch;
+                first.kernel_(first, tile + b * pitch, 1, row);
+                internal::fourStepTwiddleRow<T>(row, c + b, low, high, n1,
+                                                shift);
+            }
+            for (std::size_t i = 0; i < n1; i++) {
+                C* dst = data + i * n2 + c;
+                for (std::size_t b = 0; b < block; b++) {
+                    dst[b] = result[b * pitch + i];
+                }
+            }
+        }
+        for (std::size_t i = 0; i < n1; i++) {
+            C* row = data + i * n2;
+            std::copy(row, row + n2, tile);
+            second.kernel_(second, tile, 1, row);
+        }
+
+        if (n2 != n1) {
+            // Row i of N1 values comes from row 2 * i for i < N1 and from
+            // row 2 * (i - N1) + 1 otherwise.
+            for (std::size_t l = 0; l < cycleLeaders_.size(); l++) {
+                const std::size_t leader = cycleLeaders_[l];
+                std::copy(data + leader * n1, data + (leader + 1) * n1, tile);
+                std::size_t current = leader;
+                for (;;) {
+                    const std::size_t next = current < n1
+                                                 ? 2 * current
+                                                 : 2 * (current - n1) + 1;
+                    if (next == leader) {
+                        break;
+                    }
+                    std::copy(data + next * n1, data + (next + 1) * n1,
+                              data + current * n1);
+                    current = next;
+                }
+                std::copy(tile, tile + n1, data + current * n1);
+            }
+            internal::transposeSquareInPlace<T>(data + n1 * n1, n1);
+        }
+        internal::transposeSquareInPlace<T>(data, n1);
+    }
+
+    Kernel selectKernel() const noexcept
+    {
+        // Every transform with a combine step, cfftSize_ >=
+        // permutedScheduleThreshold, reorders its input once and runs the
+        // flattened schedule over leaves that stream through memory. Smaller
+        // transforms are a single leaf, which needs neither.
+        if (fourStepFirst_) {
+            return &fourStepKernel;
+        }
+        if (permutation_.size() > 0) {
+            return direction_ == Direction::FORWARD ? &permutedForward
+                                                    : &permutedBackward;
+        }
+        return direction_ == Direction::FORWARD ? &recursiveForward
+                                                : &recursiveBackward;
+    }
+
+    // Throws std::bad_alloc.
+    void setCycleLeaders(const std::vector<std::uint32_t>& leaders)
+    {
+        cycleLeaders_ = internal::AlignedBuffer<std::uint32_t>(leaders.size());
+        std::copy(leaders.begin(), leaders.end(), cycleLeaders_.data());
+    }
+
+    std::size_t nfft_{0};
+    std::size_t cfftSize_{0};
+    TransformType type_{TransformType::COMPLEX};
+    Direction direction_{Direction::FORWARD};
+    // Normalization of the plan and the part of it applied by kernel_: all
+    // of it for complex plans, none for real plans which scale while
+    // unscrambling or deinterleaving. Four-step plans pass it on to the N2
+    // point transforms.
+    T scale_{1};
+    T kernelScale_{1};
+    Kernel kernel_{nullptr};
+    // Per level twiddle factors of the complex transform, see
+    // levelTwiddleOffset.
+    internal::AlignedBuffer<C> twiddles_;
+    // Real plans: the even and odd twiddle factors of the unscramble step.
+    internal::AlignedBuffer<C> rfftTwiddles_;
+    internal::AlignedBuffer<C> scratch_;
+    internal::AlignedBuffer<internal::ScheduleStep> schedule_;
+    internal::AlignedBuffer<std::uint32_t> permutation_;
+    // Leaders of the cycles executeInPlace rotates: of permutation_, or of
+    // the row halves of a four-step plan with N2 = 2 * N1.
+    internal::AlignedBuffer<std::uint32_t> cycleLeaders_;
+    // Four-step plans: the N1 and N2 point transforms. twiddles_ then holds
+    // w_N^i for i < N1 followed by w_N2^i for i < N2.
+    std::unique_ptr<Plan> fourStepFirst_;
+    std::unique_ptr<Plan> fourStepSecond_;
+    // Four-step plans: tiles of one block, see TileLease.
+    std::unique_ptr<internal::ReservedTiles<T>> reservedTiles_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildPlan(const std::size_t nfft, const TransformType type,
+                    const Direction direction, const bool ownScratch,
+                    const std::size_t fourStepThreshold, const T scale,
+                    Plan<T>& plan) noexcept
+{
+    if (!isRadix2(nfft)) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (type == TransformType::REAL && nfft < minimumRfftSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    // The input permutation is stored with 32 bit indices.
+    if (nfft - 1 > std::numeric_limits<std::uint32_t>::max()) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    const bool inverseTransform = direction == Direction::BACKWARD;
+    Plan<T> created;
+    created.nfft_ = nfft;
+    created.type_ = type;
+    created.direction_ = direction;
+    created.scale_ = scale;
+    created.kernelScale_ = type == TransformType::COMPLEX ? scale : T(1);
+    try {
+        created.cfftSize_ = type == TransformType::COMPLEX ? nfft : nfft / 2;
+        const std::size_t cfftSize = created.cfftSize_;
+        if (cfftSize >= std::max(fourStepThreshold, fourStepMinimumSize)) {
+            // N1 = N2 or 2 * N1 = N2.
+            std::size_t n1 = 1;
+            while (n1 * n1 * 4 <= cfftSize) {
+                n1 *= 2;
+            }
+            const std::size_t n2 = cfftSize / n1;
+            created.fourStepFirst_ = std::make_unique<Plan<T>>();
+            created.fourStepSecond_ = std::make_unique<Plan<T>>();
+            FFTSTATUS status = buildPlan<T>(n1, TransformType::COMPLEX,
+                                            direction, false, cfftSize, T(1),
+                                            *created.fourStepFirst_);
+            if (status == FFTSTATUS::OK) {
+                status = buildPlan<T>(n2, TransformType::COMPLEX, direction,
+                                      false, cfftSize, created.kernelScale_,
+                                      *created.fourStepSecond_);
+            }
+            if (status != FFTSTATUS::OK) {
+                return status;
+            }
+            created.twiddles_ = AlignedBuffer<std::complex<T>>(n1 + n2);
+            populateUnitRoots<T>(created.twiddles_.data(), n1, 0, 1, cfftSize,
+                                 inverseTransform);
+            populateUnitRoots<T>(created.twiddles_.data() + n1, n2, 0, 1, n2,
+                                 inverseTransform);
+            if (n2 != n1) {
+                created.setCycleLeaders(findCycleLeaders(
+                    [n1](std::uint32_t i) {
+                        return (std::uint32_t)(i < n1 ? 2 * i
+                                                      : 2 * (i - n1) + 1);
+                    },
+                    n2));
+            }
+            created.reservedTiles_ = std::make_unique<ReservedTiles<T>>();
+            created.reservedTiles_->tiles = AlignedBuffer<std::complex<T>>(
+                2 * fourStepBlock * (n2 + fourStepPadding));
+        } else {
+            created.twiddles_ =
+                AlignedBuffer<std::complex<T>>(levelTwiddleCount(cfftSize));
+            populateLevelTwiddles<T>(created.twiddles_.data(), cfftSize,
+                                     inverseTransform);
+            created.schedule_ =
+                AlignedBuffer<ScheduleStep>(scheduleLength(cfftSize));
+            buildSchedule(created.schedule_.data(), 0, 1, cfftSize, 0);
+            useLevelTwiddles(created.schedule_.data(),
+                             created.schedule_.size());
+            if (cfftSize >= permutedScheduleThreshold) {
+                created.permutation_ = AlignedBuffer<std::uint32_t>(cfftSize);
+                buildPermutation(created.schedule_.data(),
+                                 created.schedule_.size(), cfftSize - 1,
+                                 created.permutation_.data());
+                created.setCycleLeaders(buildPermutationCycles(
+                    created.permutation_.data(), cfftSize));
+            }
+        }
+        if (type == TransformType::REAL) {
+            created.rfftTwiddles_ = AlignedBuffer<std::complex<T>>(nfft / 2);
+            populateRfftUnscrambleTwiddles<T>(
+                created.rfftTwiddles_.data(),
+                created.rfftTwiddles_.data() + nfft / 4, nfft,
+                inverseTransform);
+        }
+        if (ownScratch) {
+            created.scratch_ =
+                AlignedBuffer<std::complex<T>>(created.scratchSize());
+        }
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+    created.kernel_ = created.selectKernel();
+
+    plan = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Complex transforms of at least fourStepThreshold values, the complex core of
+// size nfft / 2 for real plans, use the four-step algorithm.
+template <typename T>
+FFTSTATUS
+createPlan(const std::size_t nfft, const TransformType type,
+           const Direction direction, Plan<T>& plan,
+           const std::size_t fourStepThreshold =
+               internal::defaultFourStepThreshold<T>()) noexcept
+{
+    return internal::buildPlan<T>(nfft, type, direction, true,
+                                  fourStepThreshold, T(1), plan);
+}
+
+// Same as above for a plan whose outputs are multiplied by the normalization
+// factor of nfft, or by customScale for Normalization::CUSTOM. The factor is
+// applied by the last combine step of complex plans and by the unscramble
+// and deinterleave steps of real plans, it costs no extra pass.
+template <typename T>
+FFTSTATUS
+createPlan(const std::size_t nfft, const TransformType type,
+           const Direction direction, const Normalization normalization,
+           const T customScale, Plan<T>& plan,
+           const std::size_t fourStepThreshold =
+               internal::defaultFourStepThreshold<T>()) noexcept
+{
+    return internal::buildPlan<T>(
+        nfft, type, direction, true, fourStepThreshold,
+        internal::normalizationScale<T>(normalization, nfft, customScale),
+        plan);
+}
+
+template <typename T>
+FFTSTATUS
+createPlan(const std::size_t nfft, const TransformType type,
+           const Direction direction, const Normalization normalization,
+           Plan<T>& plan,
+           const std::size_t fourStepThreshold =
+               internal::defaultFourStepThreshold<T>()) noexcept
+{
+    return createPlan<T>(nfft, type, direction, normalization, T(1), plan,
+                         fourStepThreshold);
+}
+} // namespace splitradixfft
@@ -0,0 +1,441 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_plan_cache.hpp
+ * Thread-safe cache of shared, immutable plans keyed by size, precision,
+ * transform type, direction and normalization. Every thread keeps weak references to the
+ * entries it used, a repeated lookup only reads an atomic generation counter
+ * and locks the weak reference. The global entry table is only locked on a
+ * miss or when entries are evicted, plans are built outside of the lock.
+ * Concurrent misses of one key build the plan once, the other threads wait
+ * for it while misses of other keys build in parallel.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft_plan.hpp"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace splitradixfft {
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+struct PlanKey {
+    std::size_t nfft;
+    std::size_t precision; // sizeof(T)
+    TransformType type;
+    Direction direction;
+    Normalization normalization;
+    // 1 unless normalization is CUSTOM.
+    long double customScale;
+
+    bool operator==(const PlanKey& other) const
+    {
+        return nfft == other.nfft && precision == other.precision &&
+               type == other.type && direction == other.direction &&
+               normalization == other.normalization &&
+               customScale == other.customScale;
+    }
+
+    bool operator<(const PlanKey& other) const
+    {
+        return std::make_tuple(nfft, precision, (int)type, (int)direction,
+                               (int)normalization, customScale) <
+               std::make_tuple(other.nfft, other.precision, (int)other.type,
+                               (int)other.direction, (int)other.normalization,
+                               other.customScale);
+    }
+};
+
+struct PlanCacheEntry {
+    PlanKey key;
+    std::shared_ptr<const void> plan;
+    std::size_t bytes;
+    // Approximate recency for the eviction policy, see PlanCache::touch.
+    mutable std::atomic<std::uint64_t> lastUse{0};
+};
+
+// Result of the one build of a key that concurrent misses wait for.
+struct PlanCacheBuild {
+    FFTSTATUS status;
+    std::shared_ptr<const PlanCacheEntry> entry;
+};
+
+// Weak, so evicted plans and the entries of destroyed caches are released
+// when the cache drops them rather than when the thread exits.
+struct PlanCacheLocalEntry {
+    std::uint64_t cacheId;
+    std::uint64_t generation;
+    PlanKey key;
+    std::weak_ptr<const PlanCacheEntry> entry;
+};
+
+inline std::vector<PlanCacheLocalEntry>& planCacheLocalEntries()
+{
+    static thread_local std::vector<PlanCacheLocalEntry> entries;
+    return entries;
+}
+
+inline std::uint64_t nextPlanCacheId()
+{
+    static std::atomic<std::uint64_t> id{0};
+    return ++id;
+}
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+class PlanCache {
+public:
+    // capacityBytes limits the summed memoryFootprint() of the cached plans, 0
+    // disables eviction.
+    explicit PlanCache(std::size_t capacityBytes = 0)
+        : id_(internal::nextPlanCacheId()), capacity_(capacityBytes)
+    {
+    }
+
+    PlanCache(const PlanCache&) = delete;
+    PlanCache& operator=(const PlanCache&) = delete;
+
+    // The process-wide cache used by acquirePlan.
+    static PlanCache& global()
+    {
+        static PlanCache cache;
+        return cache;
+    }
+
+    // Return the shared plan for the key, building it on the first request.
+    // The plan does not own scratch, use the const execute overloads: real
+    // backward plans take a scratch pointer of plan->scratchSize() values.
+    // Plans of different normalizations are cached separately, see
+    // createPlan.
+    template <typename T>
+    FFTSTATUS acquire(const std::size_t nfft, const TransformType type,
+                      const Direction direction,
+                      std::shared_ptr<const Plan<T>>& plan) noexcept
+    {
+        return acquire<T>(nfft, type, direction, Normalization::NONE, T(1),
+                          plan);
+    }
+
+    template <typename T>
+    FFTSTATUS acquire(const std::size_t nfft, const TransformType type,
+                      const Direction direction,
+                      const Normalization normalization,
+                      std::shared_ptr<const Plan<T>>& plan) noexcept
+    {
+        return acquire<T>(nfft, type, direction, normalization, T(1), plan);
+    }
+
+    template <typename T>
+    FFTSTATUS acquire(const std::size_t nfft, const TransformType type,
+                      const Direction direction,
+                      const Normalization normalization, const T customScale,
+                      std::shared_ptr<const Plan<T>>& plan) noexcept
+    {
+        const long double scale = normalization == Normalization::CUSTOM
+                                      ? (long double)customScale
+                                      : 1.0L;
+        const internal::PlanKey key{nfft,      sizeof(T),     type,
+                                    direction, normalization, scale};
+        const std::uint64_t generation =
+            generation_.load(std::memory_order_acquire);
+        for (const auto& local : internal::planCacheLocalEntries()) {
+            if (local.cacheId == id_ && local.generation == generation &&
+                local.key == key) {
+                if (auto entry = local.entry.lock()) {
+                    touch(*entry);
+                    plan = std::static_pointer_cast<const Plan<T>>(entry->plan);
+                    return FFTSTATUS::OK;
+                }
+                break;
+            }
+        }
+        return acquireSlow<T>(key, plan);
+    }
+
+    void setCapacity(std::size_t capacityBytes)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        capacity_ = capacityBytes;
+        evict(nullptr);
+    }
+
+    std::size_t capacity() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return capacity_;
+    }
+
+    // Number of cached plans.
+    std::size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    // Summed memoryFootprint() of the cached plans.
+    std::size_t memoryUsage() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return usage_;
+    }
+
+    // Number of plans built by the cache, including failed builds and plans
+    // evicted since.
+    std::size_t builds() const noexcept
+    {
+        return builds_.load(std::memory_order_relaxed);
+    }
+
+    // Drop all plans. Plans still referenced by the caller stay valid.
+    void clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+        usage_ = 0;
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+    }
+
+private:
+    using Entry = internal::PlanCacheEntry;
+    using Build = internal::PlanCacheBuild;
+
+    void touch(const Entry& entry) const noexcept
+    {
+        // Only write the shared entry once per clock tick to keep the cache
+        // line of hot plans shared between the threads.
+        const std::uint64_t now = clock_.load(std::memory_order_relaxed);
+        if (entry.lastUse.load(std::memory_order_relaxed) != now) {
+            entry.lastUse.store(now, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    FFTSTATUS acquireSlow(const internal::PlanKey& key,
+                          std::shared_ptr<const Plan<T>>& plan) noexcept
+    {
+        try {
+            std::shared_ptr<const Entry> entry;
+            std::shared_future<Build> pending;
+            std::promise<Build> promise;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                clock_.fetch_add(1, std::memory_order_relaxed);
+                auto it = entries_.find(key);
+                if (it != entries_.end()) {
+                    touch(*it->second);
+                    entry = it->second;
+                } else {
+                    auto building = building_.find(key);
+                    if (building != building_.end()) {
+                        pending = building->second;
+                    } else {
+                        building_.emplace(key, promise.get_future().share());
+                    }
+                }
+            }
+            if (!entry) {
+                // Only the first miss of the key builds, without the lock so
+                // a large plan does not hold up the misses of other keys.
+                Build result = pending.valid() ? pending.get()
+                                               : build<T>(key, promise);
+                if (result.status != FFTSTATUS::OK) {
+                    return result.status;
+                }
+                entry = result.entry;
+            }
+            remember(entry);
+            plan = std::static_pointer_cast<const Plan<T>>(entry->plan);
+        } catch (const std::bad_alloc&) {
+            return FFTSTATUS::ALLOCATION_FAILED;
+        }
+        return FFTSTATUS::OK;
+    }
+
+    // Build the plan of the key registered in building_, insert it and hand
+    // the result to the waiting misses.
+    template <typename T>
+    Build build(const internal::PlanKey& key,
+                std::promise<Build>& promise) noexcept
+    {
+        builds_.fetch_add(1, std::memory_order_relaxed);
+        Build result{FFTSTATUS::OK, nullptr};
+        try {
+            Plan<T> created;
+            result.status = internal::buildPlan<T>(
+                key.nfft, key.type, key.direction, false,
+                internal::defaultFourStepThreshold<T>(),
+                internal::normalizationScale<T>(key.normalization, key.nfft,
+                                                (T)key.customScale),
+                created);
+            if (result.status == FFTSTATUS::OK) {
+                auto built = std::make_shared<Entry>();
+                built->key = key;
+                built->bytes = created.memoryFootprint();
+                built->plan =
+                    std::make_shared<const Plan<T>>(std::move(created));
+                result.entry = insert(built);
+            }
+        } catch (const std::bad_alloc&) {
+            result.status = FFTSTATUS::ALLOCATION_FAILED;
+        }
+        if (!result.entry) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            building_.erase(key);
+        }
+        promise.set_value(result);
+        return result;
+    }
+
+    // Insert built and end the build of its key, return the cached entry.
+    std::shared_ptr<const Entry> insert(const std::shared_ptr<Entry>& built)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        building_.erase(built->key);
+        auto inserted = entries_.emplace(built->key, built);
+        Entry& entry = *inserted.first->second;
+        touch(entry);
+        if (inserted.second) {
+            usage_ += entry.bytes;
+            evict(&entry);
+        }
+        return inserted.first->second;
+    }
+
+    // Drop the least recently used plans until the capacity is met. keep is
+    // never evicted, a single plan larger than the capacity stays cached.
+    void evict(const Entry* keep)
+    {
+        bool evicted = false;
+        while (capacity_ > 0 && usage_ > capacity_) {
+            auto victim = entries_.end();
+            for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+                if (it->second.get() == keep) {
+                    continue;
+                }
+                if (victim == entries_.end() ||
+                    it->second->lastUse.load(std::memory_order_relaxed) <
+                        victim->second->lastUse.load(
+                            std::memory_order_relaxed)) {
+                    victim = it;
+                }
+            }
+            if (victim == entries_.end()) {
+                break;
+            }
+            usage_ -= victim->second->bytes;
+            entries_.erase(victim);
+            evicted = true;
+        }
+        if (evicted) {
+            // Invalidate the thread local copies, each thread drops its
+            // references to the evicted plans on its next miss.
+            generation_.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+
+    void remember(const std::shared_ptr<const Entry>& entry)
+    {
+        const std::uint64_t generation =
+            generation_.load(std::memory_order_acquire);
+        auto& locals = internal::planCacheLocalEntries();
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < locals.size(); i++) {
+            // Drop released entries, including those of destroyed caches,
+            // stale copies of this cache and the old copy of the entry.
+            if (locals[i].entry.expired() ||
+                (locals[i].cacheId == id_ &&
+                 (locals[i].generation != generation ||
+                  locals[i].key == entry->key))) {
+                continue;
+            }
+            locals[kept++] = std::move(locals[i]);
+        }
+        locals.resize(kept);
+        locals.push_back({id_, generation, entry->key, entry});
+    }
+
+    const std::uint64_t id_;
+    mutable std::mutex mutex_;
+    std::map<internal::PlanKey, std::shared_ptr<Entry>> entries_;
+    // Keys being built by a thread outside of the lock.
+    std::map<internal::PlanKey, std::shared_future<Build>> building_;
+    std::size_t capacity_;
+    std::size_t usage_{0};
+    std::atomic<std::uint64_t> generation_{0};
+    std::atomic<std::uint64_t> clock_{0};
+    std::atomic<std::size_t> builds_{0};
+};
+
+template <typename T>
+FFTSTATUS acquirePlan(const std::size_t nfft, const TransformType type,
+                      const Direction direction,
+                      std::shared_ptr<const Plan<T>>& plan) noexcept
+{
+    return PlanCache::global().acquire<T>(nfft, type, direction, plan);
+}
+
+template <typename T>
+FFTSTATUS acquirePlan(const std::size_t nfft, const TransformType type,
+                      const Direction direction,
+                      const Normalization normalization,
+                      std::shared_ptr<const Plan<T>>& plan) noexcept
+{
+    return PlanCache::global().acquire<T>(nfft, type, direction,
+                                          normalization, plan);
+}
+
+template <typename T>
+FFTSTATUS acquirePlan(const std::size_t nfft, const TransformType type,
+                      const Direction direction,
+                      const Normalization normalization, const T customScale,
+                      std::shared_ptr<const Plan<T>>& plan) noexcept
+{
+    return PlanCache::global().acquire<T>(nfft, type, direction,
+                                          normalization, customScale, plan);
+}
+} // namespace splitradixfft
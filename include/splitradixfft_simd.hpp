@@ -0,0 +1,435 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_simd.hpp
+ * Packed complex arithmetic used by the vectorized butterflies and spectral
+ * kernels. The widest instruction set enabled at compile time is selected
+ * (AVX-512, AVX2 or SSE2).
+ * Define SPLITRADIXFFT_DISABLE_SIMD to force the scalar code paths.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include <complex>
+#include <cstddef>
+
+#if !defined(SPLITRADIXFFT_DISABLE_SIMD)
+#if defined(__AVX512F__)
+#define SPLITRADIXFFT_SIMD_AVX512 1
+#include <immintrin.h>
+#elif defined(__AVX2__)
+#define SPLITRADIXFFT_SIMD_AVX2 1
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) ||                                  \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SPLITRADIXFFT_SIMD_SSE2 1
+#include <emmintrin.h>
+#endif
+#endif
+
+namespace splitradixfft {
+namespace internal {
+namespace simd {
+
+enum class Isa {
+    SCALAR = 0,
+    SSE2 = 1,
+    AVX2 = 2,
+    AVX512 = 3,
+};
+
+#if defined(SPLITRADIXFFT_SIMD_AVX512)
+constexpr Isa activeIsa = Isa::AVX512;
+#elif defined(SPLITRADIXFFT_SIMD_AVX2)
+constexpr Isa activeIsa = Isa::AVX2;
+#elif defined(SPLITRADIXFFT_SIMD_SSE2)
+constexpr Isa activeIsa = Isa::SSE2;
+#else
+constexpr Isa activeIsa = Isa::SCALAR;
+#endif
+
+// A register of interleaved complex values. All loads and stores are
+// unaligned, the complex arrays passed by the user carry no alignment promise.
+// width is the number of complex values per register, 0 means no vector type is
+// available and the callers have to use the scalar code path.
+template <typename T>
+struct Vec {
+    static constexpr std::size_t width = 0;
+};
+
+#if defined(SPLITRADIXFFT_SIMD_AVX512)
+template <>
+struct Vec<float> {
+    using R = __m512;
+    static constexpr std::size_t width = 8;
+
+    static R load(const std::complex<float>* p)
+    {
+        return _mm512_loadu_ps(reinterpret_cast<const float*>(p));
+    }
+    static void store(std::complex<float>* p, R a)
+    {
+        _mm512_storeu_ps(reinterpret_cast<float*>(p), a);
+    }
+    static R broadcast(float s) { return _mm512_set1_ps(s); }
+    static R add(R a, R b) { return _mm512_add_ps(a, b); }
+    static R sub(R a, R b) { return _mm512_sub_ps(a, b); }
+    static R scale(R a, R s) { return _mm512_mul_ps(a, s); }
+    static R div(R a, R b) { return _mm512_div_ps(a, b); }
+    static R max(R a, R b) { return _mm512_max_ps(a, b); }
+    static R sqrt(R a) { return _mm512_sqrt_ps(a); }
+    // The real parts of a followed by the real parts of b, 2 * width values.
+    static R evenLanes(R a, R b)
+    {
+        return _mm512_permutex2var_ps(
+            a,
+            _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24,
+                              26, 28, 30),
+            b);
+    }
+    static void storeReal(float* p, R a) { _mm512_storeu_ps(p, a); }
+    static R swap(R a) { return _mm512_permute_ps(a, 0xB1); }
+    static R negate(R a, __m512i mask)
+    {
+        return _mm512_castsi512_ps(
+            _mm512_xor_si512(_mm512_castps_si512(a), mask));
+    }
+    // a * b
+    static R mul(R a, R b)
+    {
+        return _mm512_fmaddsub_ps(a, _mm512_moveldup_ps(b),
+                                  _mm512_mul_ps(swap(a), _mm512_movehdup_ps(b)));
+    }
+    // a * conj(b)
+    static R mulConj(R a, R b)
+    {
+        return _mm512_fmsubadd_ps(a, _mm512_moveldup_ps(b),
+                                  _mm512_mul_ps(swap(a), _mm512_movehdup_ps(b)));
+    }
+    // Multiply by -j (F = false) or j (F = true)
+    template <bool F>
+    static R rot90(R a)
+    {
+        const __m512i mask = F ? _mm512_set1_epi64(0x0000000080000000LL)
+                               : _mm512_set1_epi64(0x8000000000000000LL);
+        return negate(swap(a), mask);
+    }
+};
+
+template <>
+struct Vec<double> {
+    using R = __m512d;
+    static constexpr std::size_t width = 4;
+
+    static R load(const std::complex<double>* p)
+    {
+        return _mm512_loadu_pd(reinterpret_cast<const double*>(p));
+    }
+    static void store(std::complex<double>* p, R a)
+    {
+        _mm512_storeu_pd(reinterpret_cast<double*>(p), a);
+    }
+    static R broadcast(double s) { return _mm512_set1_pd(s); }
+    static R add(R a, R b) { return _mm512_add_pd(a, b); }
+    static R sub(R a, R b) { return _mm512_sub_pd(a, b); }
+    static R scale(R a, R s) { return _mm512_mul_pd(a, s); }
+    static R div(R a, R b) { return _mm512_div_pd(a, b); }
+    static R max(R a, R b) { return _mm512_max_pd(a, b); }
+    static R sqrt(R a) { return _mm512_sqrt_pd(a); }
+    static R evenLanes(R a, R b)
+    {
+        return _mm512_permutex2var_pd(
+            a, _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), b);
+    }
+    static void storeReal(double* p, R a) { _mm512_storeu_pd(p, a); }
+    static R swap(R a) { return _mm512_permute_pd(a, 0x55); }
+    static R negate(R a, __m512i mask)
+    {
+        return _mm512_castsi512_pd(
+            _mm512_xor_si512(_mm512_castpd_si512(a), mask));
+    }
+    static R mul(R a, R b)
+    {
+        return _mm512_fmaddsub_pd(
+            a, _mm512_movedup_pd(b),
+            _mm512_mul_pd(swap(a), _mm512_permute_pd(b, 0xFF)));
+    }
+    static R mulConj(R a, R b)
+    {
+        return _mm512_fmsubadd_pd(
+            a, _mm512_movedup_pd(b),
+            _mm512_mul_pd(swap(a), _mm512_permute_pd(b, 0xFF)));
+    }
+    template <bool F>
+    static R rot90(R a)
+    {
+        const __m512i mask =
+            F ? _mm512_set_epi64(0, (long long)0x8000000000000000ULL, 0,
+                                 (long long)0x8000000000000000ULL, 0,
+                                 (long long)0x8000000000000000ULL, 0,
+                                 (long long)0x8000000000000000ULL)
+              : _mm512_set_epi64((long long)0x8000000000000000ULL, 0,
+                                 (long long)0x8000000000000000ULL, 0,
+                                 (long long)0x8000000000000000ULL, 0,
+                                 (long long)0x8000000000000000ULL, 0);
+        return negate(swap(a), mask);
+    }
+};
+#endif
+
+#if defined(SPLITRADIXFFT_SIMD_AVX2)
+template <>
+struct Vec<float> {
+    using R = __m256;
+    static constexpr std::size_t width = 4;
+
+    static R load(const std::complex<float>* p)
+    {
+        return _mm256_loadu_ps(reinterpret_cast<const float*>(p));
+    }
+    static void store(std::complex<float>* p, R a)
+    {
+        _mm256_storeu_ps(reinterpret_cast<float*>(p), a);
+    }
+    static R broadcast(float s) { return _mm256_set1_ps(s); }
+    static R add(R a, R b) { return _mm256_add_ps(a, b); }
+    static R sub(R a, R b) { return _mm256_sub_ps(a, b); }
+    static R scale(R a, R s) { return _mm256_mul_ps(a, s); }
+    static R div(R a, R b) { return _mm256_div_ps(a, b); }
+    static R max(R a, R b) { return _mm256_max_ps(a, b); }
+    static R sqrt(R a) { return _mm256_sqrt_ps(a); }
+    static R evenLanes(R a, R b)
+    {
+        // a0 a2 b0 b2 | a4 a6 b4 b6, then the middle pairs swap lanes.
+        R even = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+        return _mm256_castpd_ps(_mm256_permute4x64_pd(
+            _mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0)));
+    }
+    static void storeReal(float* p, R a) { _mm256_storeu_ps(p, a); }
+    static R swap(R a) { return _mm256_permute_ps(a, 0xB1); }
+    static R mul(R a, R b)
+    {
+        R re = _mm256_moveldup_ps(b);
+        R im = _mm256_mul_ps(swap(a), _mm256_movehdup_ps(b));
+#if defined(__FMA__)
+        return _mm256_fmaddsub_ps(a, re, im);
+#else
+        return _mm256_addsub_ps(_mm256_mul_ps(a, re), im);
+#endif
+    }
+    static R mulConj(R a, R b)
+    {
+        R re = _mm256_moveldup_ps(b);
+        R im = _mm256_mul_ps(swap(a), _mm256_movehdup_ps(b));
+#if defined(__FMA__)
+        return _mm256_fmsubadd_ps(a, re, im);
+#else
+        return _mm256_addsub_ps(_mm256_mul_ps(a, re),
+                                _mm256_xor_ps(im, _mm256_set1_ps(-0.0f)));
+#endif
+    }
+    template <bool F>
+    static R rot90(R a)
+    {
+        const R mask = F ? _mm256_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f, -0.0f,
+                                          0.0f, -0.0f, 0.0f)
+                         : _mm256_setr_ps(0.0f, -0.0f, 0.0f, -0.0f, 0.0f,
+                                          -0.0f, 0.0f, -0.0f);
+        return _mm256_xor_ps(swap(a), mask);
+    }
+};
+
+template <>
+struct Vec<double> {
+    using R = __m256d;
+    static constexpr std::size_t width = 2;
+
+    static R load(const std::complex<double>* p)
+    {
+        return _mm256_loadu_pd(reinterpret_cast<const double*>(p));
+    }
+    static void store(std::complex<double>* p, R a)
+    {
+        _mm256_storeu_pd(reinterpret_cast<double*>(p), a);
+    }
+    static R broadcast(double s) { return _mm256_set1_pd(s); }
+    static R add(R a, R b) { return _mm256_add_pd(a, b); }
+    static R sub(R a, R b) { return _mm256_sub_pd(a, b); }
+    static R scale(R a, R s) { return _mm256_mul_pd(a, s); }
+    static R div(R a, R b) { return _mm256_div_pd(a, b); }
+    static R max(R a, R b) { return _mm256_max_pd(a, b); }
+    static R sqrt(R a) { return _mm256_sqrt_pd(a); }
+    static R evenLanes(R a, R b)
+    {
+        return _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b),
+                                     _MM_SHUFFLE(3, 1, 2, 0));
+    }
+    static void storeReal(double* p, R a) { _mm256_storeu_pd(p, a); }
+    static R swap(R a) { return _mm256_permute_pd(a, 0x5); }
+    static R mul(R a, R b)
+    {
+        R re = _mm256_movedup_pd(b);
+        R im = _mm256_mul_pd(swap(a), _mm256_permute_pd(b, 0xF));
+#if defined(__FMA__)
+        return _mm256_fmaddsub_pd(a, re, im);
+#else
+        return _mm256_addsub_pd(_mm256_mul_pd(a, re), im);
+#endif
+    }
+    static R mulConj(R a, R b)
+    {
+        R re = _mm256_movedup_pd(b);
+        R im = _mm256_mul_pd(swap(a), _mm256_permute_pd(b, 0xF));
+#if defined(__FMA__)
+        return _mm256_fmsubadd_pd(a, re, im);
+#else
+        return _mm256_addsub_pd(_mm256_mul_pd(a, re),
+                                _mm256_xor_pd(im, _mm256_set1_pd(-0.0)));
+#endif
+    }
+    template <bool F>
+    static R rot90(R a)
+    {
+        const R mask = F ? _mm256_setr_pd(-0.0, 0.0, -0.0, 0.0)
+                         : _mm256_setr_pd(0.0, -0.0, 0.0, -0.0);
+        return _mm256_xor_pd(swap(a), mask);
+    }
+};
+#endif
+
+#if defined(SPLITRADIXFFT_SIMD_SSE2)
+template <>
+struct Vec<float> {
+    using R = __m128;
+    static constexpr std::size_t width = 2;
+
+    static R load(const std::complex<float>* p)
+    {
+        return _mm_loadu_ps(reinterpret_cast<const float*>(p));
+    }
+    static void store(std::complex<float>* p, R a)
+    {
+        _mm_storeu_ps(reinterpret_cast<float*>(p), a);
+    }
+    static R broadcast(float s) { return _mm_set1_ps(s); }
+    static R add(R a, R b) { return _mm_add_ps(a, b); }
+    static R sub(R a, R b) { return _mm_sub_ps(a, b); }
+    static R scale(R a, R s) { return _mm_mul_ps(a, s); }
+    static R div(R a, R b) { return _mm_div_ps(a, b); }
+    static R max(R a, R b) { return _mm_max_ps(a, b); }
+    static R sqrt(R a) { return _mm_sqrt_ps(a); }
+    static R evenLanes(R a, R b)
+    {
+        return _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    }
+    static void storeReal(float* p, R a) { _mm_storeu_ps(p, a); }
+    static R swap(R a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+    static R mul(R a, R b)
+    {
+        // SSE2 has no addsub, flip the sign of the even lanes instead.
+        R re = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0)));
+        R im = _mm_mul_ps(swap(a), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1)));
+        return _mm_add_ps(re, _mm_xor_ps(im, _mm_setr_ps(-0.0f, 0.0f, -0.0f,
+                                                         0.0f)));
+    }
+    static R mulConj(R a, R b)
+    {
+        R re = _mm_mul_ps(a, _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0)));
+        R im = _mm_mul_ps(swap(a), _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1)));
+        return _mm_add_ps(re, _mm_xor_ps(im, _mm_setr_ps(0.0f, -0.0f, 0.0f,
+                                                         -0.0f)));
+    }
+    template <bool F>
+    static R rot90(R a)
+    {
+        const R mask = F ? _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f)
+                         : _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f);
+        return _mm_xor_ps(swap(a), mask);
+    }
+};
+
+template <>
+struct Vec<double> {
+    using R = __m128d;
+    static constexpr std::size_t width = 1;
+
+    static R load(const std::complex<double>* p)
+    {
+        return _mm_loadu_pd(reinterpret_cast<const double*>(p));
+    }
+    static void store(std::complex<double>* p, R a)
+    {
+        _mm_storeu_pd(reinterpret_cast<double*>(p), a);
+    }
+    static R broadcast(double s) { return _mm_set1_pd(s); }
+    static R add(R a, R b) { return _mm_add_pd(a, b); }
+    static R sub(R a, R b) { return _mm_sub_pd(a, b); }
+    static R scale(R a, R s) { return _mm_mul_pd(a, s); }
+    static R div(R a, R b) { return _mm_div_pd(a, b); }
+    static R max(R a, R b) { return _mm_max_pd(a, b); }
+    static R sqrt(R a) { return _mm_sqrt_pd(a); }
+    static R evenLanes(R a, R b) { return _mm_unpacklo_pd(a, b); }
+    static void storeReal(double* p, R a) { _mm_storeu_pd(p, a); }
+    static R swap(R a) { return _mm_shuffle_pd(a, a, 1); }
+    static R mul(R a, R b)
+    {
+        R re = _mm_mul_pd(a, _mm_unpacklo_pd(b, b));
+        R im = _mm_mul_pd(swap(a), _mm_unpackhi_pd(b, b));
+        return _mm_add_pd(re, _mm_xor_pd(im, _mm_setr_pd(-0.0, 0.0)));
+    }
+    static R mulConj(R a, R b)
+    {
+        R re = _mm_mul_pd(a, _mm_unpacklo_pd(b, b));
+        R im = _mm_mul_pd(swap(a), _mm_unpackhi_pd(b, b));
+        return _mm_add_pd(re, _mm_xor_pd(im, _mm_setr_pd(0.0, -0.0)));
+    }
+    template <bool F>
+    static R rot90(R a)
+    {
+        const R mask = F ? _mm_setr_pd(-0.0, 0.0) : _mm_setr_pd(0.0, -0.0);
+        return _mm_xor_pd(swap(a), mask);
+    }
+};
+#endif
+
+// Load width twiddle factors that are stride entries apart in the table.
+template <typename T>
+inline typename Vec<T>::R loadStrided(const std::complex<T>* p,
+                                      std::size_t stride)
+{
+    if (stride == 1) {
+        return Vec<T>::load(p);
+    }
+    std::complex<T> tmp[Vec<T>::width];
+    for (std::size_t k = 0; k < Vec<T>::width; k++) {
+        tmp[k] = p[k * stride];
+    }
+    return Vec<T>::load(tmp);
+}
+
+} // namespace simd
+} // namespace internal
+} // namespace splitradixfft
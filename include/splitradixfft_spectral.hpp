@@ -0,0 +1,364 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_spectral.hpp
+ * Vectorized pointwise kernels for spectra in the layout of the transform
+ * output: products, multiply-accumulate, magnitude, power, phase and decibels.
+ * The products are written out instead of using the operators of
+ * std::complex, which check every product for infinities.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft.hpp"
+#include "splitradixfft_simd.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+
+namespace splitradixfft {
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+template <typename T>
+inline void multiplySpectrum(std::complex<T>* out, const std::complex<T>* a,
+                             const std::complex<T>* b, std::size_t size)
+{
+    // out[i] = a[i] * b[i], out may be a or b.
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        for (; i + W <= size; i += W) {
+            V::store(out + i, V::mul(V::load(a + i), V::load(b + i)));
+        }
+    }
+    for (; i < size; i++) {
+        const T aRe{a[i].real()};
+        const T aIm{a[i].imag()};
+        const T bRe{b[i].real()};
+        const T bIm{b[i].imag()};
+        out[i] = std::complex<T>(aRe * bRe - aIm * bIm, aRe * bIm + aIm * bRe);
+    }
+}
+
+template <typename T>
+inline void multiplyConjugateSpectrum(std::complex<T>* out,
+                                      const std::complex<T>* a,
+                                      const std::complex<T>* b,
+                                      std::size_t size)
+{
+    // out[i] = conj(a[i]) * b[i], out may be a or b.
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        for (; i + W <= size; i += W) {
+            V::store(out + i, V::mulConj(V::load(b + i), V::load(a + i)));
+        }
+    }
+    for (; i < size; i++) {
+        const T aRe{a[i].real()};
+        const T aIm{a[i].imag()};
+        const T bRe{b[i].real()};
+        const T bIm{b[i].imag()};
+        out[i] = std::complex<T>(aRe * bRe + aIm * bIm, aRe * bIm - aIm * bRe);
+    }
+}
+
+template <typename T>
+inline void multiplyAccumulateSpectrum(std::complex<T>* acc,
+                                       const std::complex<T>* a,
+                                       const std::complex<T>* b,
+                                       std::size_t size)
+{
+    // acc[i] += a[i] * b[i].
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        for (; i + W <= size; i += W) {
+            V::store(acc + i, V::add(V::load(acc + i),
+                                     V::mul(V::load(a + i), V::load(b + i))));
+        }
+    }
+    for (; i < size; i++) {
+        const T aRe{a[i].real()};
+        const T aIm{a[i].imag()};
+        const T bRe{b[i].real()};
+        const T bIm{b[i].imag()};
+        acc[i] += std::complex<T>(aRe * bRe - aIm * bIm, aRe * bIm + aIm * bRe);
+    }
+}
+
+template <typename T>
+inline void multiplyConjugateAccumulateSpectrum(std::complex<T>* acc,
+                                                const std::complex<T>* a,
+                                                const std::complex<T>* b,
+                                                std::size_t size)
+{
+    // acc[i] += conj(a[i]) * b[i].
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        for (; i + W <= size; i += W) {
+            V::store(acc + i, V::add(V::load(acc + i),
+                                     V::mulConj(V::load(b + i),
+                                                V::load(a + i))));
+        }
+    }
+    for (; i < size; i++) {
+        const T aRe{a[i].real()};
+        const T aIm{a[i].imag()};
+        const T bRe{b[i].real()};
+        const T bIm{b[i].imag()};
+        acc[i] += std::complex<T>(aRe * bRe + aIm * bIm, aRe * bIm - aIm * bRe);
+    }
+}
+
+template <typename T>
+inline void accumulateSquares(std::complex<T>* acc, const std::complex<T>* x,
+                              std::size_t size)
+{
+    // acc[i] += (re(x[i])², im(x[i])²), the sum of both parts is |x[i]|².
+    // Keeping them apart needs no shuffles.
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        for (; i + W <= size; i += W) {
+            const auto v = V::load(x + i);
+            V::store(acc + i, V::add(V::load(acc + i), V::scale(v, v)));
+        }
+    }
+    for (; i < size; i++) {
+        const T re{x[i].real()};
+        const T im{x[i].imag()};
+        acc[i] = std::complex<T>(acc[i].real() + re * re,
+                                 acc[i].imag() + im * im);
+    }
+}
+
+template <typename T, bool Root>
+inline void spectrumNorms(const std::complex<T>* in, T* out, std::size_t size)
+{
+    // out[i] = re² + im², or its square root if Root. Two vectors of squares
+    // are summed with their swapped parts and packed into one real vector.
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        for (; i + 2 * W <= size; i += 2 * W) {
+            const auto a = V::load(in + i);
+            const auto b = V::load(in + i + W);
+            const auto a2 = V::scale(a, a);
+            const auto b2 = V::scale(b, b);
+            auto norms = V::evenLanes(V::add(a2, V::swap(a2)),
+                                      V::add(b2, V::swap(b2)));
+            if constexpr (Root) {
+                norms = V::sqrt(norms);
+            }
+            V::storeReal(out + i, norms);
+        }
+    }
+    for (; i < size; i++) {
+        const T re{in[i].real()};
+        const T im{in[i].imag()};
+        out[i] = Root ? std::sqrt(re * re + im * im) : re * re + im * im;
+    }
+}
+
+template <typename T>
+inline void normalizeSpectrum(std::complex<T>* data, std::size_t size)
+{
+    // data[i] / |data[i]|. The magnitude is raised to the smallest normal
+    // value, so bins without energy stay zero instead of dividing 0 by 0.
+    const T smallest{std::numeric_limits<T>::min()};
+    std::size_t i = 0;
+    constexpr std::size_t W = simd::Vec<T>::width;
+    if constexpr (W > 0) {
+        using V = simd::Vec<T>;
+        const auto floor = V::broadcast(smallest);
+        for (; i + W <= size; i += W) {
+            const auto v = V::load(data + i);
+            const auto v2 = V::scale(v, v);
+            const auto magnitude = V::sqrt(V::add(v2, V::swap(v2)));
+            V::store(data + i, V::div(v, V::max(magnitude, floor)));
+        }
+    }
+    for (; i < size; i++) {
+        const T re{data[i].real()};
+        const T im{data[i].imag()};
+        const T magnitude{std::max(std::sqrt(re * re + im * im), smallest)};
+        data[i] = std::complex<T>(re / magnitude, im / magnitude);
+    }
+}
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+// The kernels apply to size values, e.g. the nfft / 2 + 1 values of a
+// half-spectrum, and are exact for the DC and Nyquist bins: products of values
+// with zero imaginary parts keep zero imaginary parts. Outputs may be the same
+// array as an input.
+
+// out[i] = a[i] * b[i]
+template <typename T>
+FFTSTATUS multiplySpectra(const std::complex<T>* a, const std::complex<T>* b,
+                          std::complex<T>* out, const std::size_t size) noexcept
+{
+    if (a == nullptr || b == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::multiplySpectrum<T>(out, a, b, size);
+    return FFTSTATUS::OK;
+}
+
+// out[i] = conj(a[i]) * b[i]
+template <typename T>
+FFTSTATUS multiplyConjugateSpectra(const std::complex<T>* a,
+                                   const std::complex<T>* b,
+                                   std::complex<T>* out,
+                                   const std::size_t size) noexcept
+{
+    if (a == nullptr || b == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::multiplyConjugateSpectrum<T>(out, a, b, size);
+    return FFTSTATUS::OK;
+}
+
+// acc[i] += a[i] * b[i]
+template <typename T>
+FFTSTATUS multiplyAccumulateSpectra(const std::complex<T>* a,
+                                    const std::complex<T>* b,
+                                    std::complex<T>* acc,
+                                    const std::size_t size) noexcept
+{
+    if (a == nullptr || b == nullptr || acc == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::multiplyAccumulateSpectrum<T>(acc, a, b, size);
+    return FFTSTATUS::OK;
+}
+
+// acc[i] += conj(a[i]) * b[i]
+template <typename T>
+FFTSTATUS multiplyConjugateAccumulateSpectra(const std::complex<T>* a,
+                                             const std::complex<T>* b,
+                                             std::complex<T>* acc,
+                                             const std::size_t size) noexcept
+{
+    if (a == nullptr || b == nullptr || acc == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::multiplyConjugateAccumulateSpectrum<T>(acc, a, b, size);
+    return FFTSTATUS::OK;
+}
+
+// out[i] = |in[i]|. Computed as sqrt(re² + im²) like the vector lanes, which
+// unlike std::abs overflows for magnitudes beyond the square root of the
+// largest value of T.
+template <typename T>
+FFTSTATUS spectrumMagnitude(const std::complex<T>* in, T* out,
+                            const std::size_t size) noexcept
+{
+    if (in == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::spectrumNorms<T, true>(in, out, size);
+    return FFTSTATUS::OK;
+}
+
+// out[i] = |in[i]|², std::norm
+template <typename T>
+FFTSTATUS spectrumPower(const std::complex<T>* in, T* out,
+                        const std::size_t size) noexcept
+{
+    if (in == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::spectrumNorms<T, false>(in, out, size);
+    return FFTSTATUS::OK;
+}
+
+// out[i] = 10 * log10(|in[i]|²), -infinity for zero bins. The power is
+// vectorized, the logarithm is std::log10.
+template <typename T>
+FFTSTATUS spectrumDecibels(const std::complex<T>* in, T* out,
+                           const std::size_t size) noexcept
+{
+    if (in == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    internal::spectrumNorms<T, false>(in, out, size);
+    for (std::size_t i = 0; i < size; i++) {
+        out[i] = T(10) * std::log10(out[i]);
+    }
+    return FFTSTATUS::OK;
+}
+
+// out[i] = arg(in[i]) in [-pi, pi]. Zero imaginary parts count as +0, so real
+// bins such as DC and Nyquist have a phase of 0 or pi even if a product left
+// a negative zero.
+template <typename T>
+FFTSTATUS spectrumPhase(const std::complex<T>* in, T* out,
+                        const std::size_t size) noexcept
+{
+    if (in == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    for (std::size_t i = 0; i < size; i++) {
+        out[i] = std::atan2(in[i].imag() + T(0), in[i].real());
+    }
+    return FFTSTATUS::OK;
+}
+} // namespace splitradixfft
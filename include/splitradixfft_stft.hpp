@@ -0,0 +1,286 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_stft.hpp
+ * Streaming short-time Fourier transform and its overlap-add inverse. The
+ * analysis window is applied by the leaves of the forward transform while
+ * they load the frame, the synthesis window and the normalization while the
+ * backward transform deinterleaves its output into the overlap-add buffer.
+ * Nothing is allocated after the STFT is created.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft.hpp"
+#include "splitradixfft_plan.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace splitradixfft {
+
+template <typename T>
+class Stft;
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+template <typename T>
+FFTSTATUS buildStft(const std::size_t fftSize, const std::size_t hopSize,
+                    const T* window, Stft<T>& stft) noexcept;
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+// Frames of fftSize() values start every hopSize() values. Every frame is
+// multiplied by the analysis window before the real forward transform. The
+// inverse multiplies every backward transform by the synthesis window
+// w[n] / sum_k w[n + k * hopSize()]^2 / fftSize() and overlap-adds the
+// frames, which reconstructs the input for any window whose squares overlap
+// everywhere.
+template <typename T>
+class Stft {
+public:
+    using C = std::complex<T>;
+
+    Stft() = default;
+    Stft(const Stft&) = delete;
+    Stft& operator=(const Stft&) = delete;
+    Stft(Stft&&) noexcept = default;
+    Stft& operator=(Stft&&) noexcept = default;
+
+    std::size_t fftSize() const noexcept { return nfft_; }
+    std::size_t hopSize() const noexcept { return hop_; }
+    // Values of the half-spectrum of a frame.
+    std::size_t binCount() const noexcept { return nfft_ / 2 + 1; }
+    // Lag of the output of process behind its input.
+    std::size_t latency() const noexcept { return nfft_; }
+
+    // Feeds count values of any size. frame(C* spectrum) is called with the
+    // binCount() values of every frame that is complete, the first one after
+    // hopSize() values, the frame ends with the newest value.
+    template <typename Frame>
+    void analyze(const T* in, std::size_t count, Frame&& frame) noexcept
+    {
+        while (count > 0) {
+            const std::size_t n = std::min(count, hop_ - filled_);
+            push(in, n);
+            filled_ += n;
+            in += n;
+            count -= n;
+            if (filled_ == hop_) {
+                frame(transformFrame());
+                filled_ = 0;
+            }
+        }
+    }
+
+    // Overlap-adds the frame of binCount() values and writes the hopSize()
+    // values that no later frame contributes to.
+    void synthesize(const C* spectrum, T* out) noexcept
+    {
+        internal::rfftInverseOverlapAdd<T>(
+            spectrum, scratch_.data(), scratch_.data() + nfft_ / 2,
+            overlap_.data(), synthesisWindow_.data(), backwardTwiddles_.data(),
+            nfft_);
+        T* overlap = overlap_.data();
+        std::copy(overlap, overlap + hop_, out);
+        std::copy(overlap + hop_, overlap + nfft_, overlap);
+        std::fill(overlap + nfft_ - hop_, overlap + nfft_, T(0));
+    }
+
+    // analyze followed by synthesize for every frame, frame(C* spectrum) may
+    // modify the spectrum in place. out[n] is the result for in[n - latency()],
+    // in and out may be the same array.
+    template <typename Frame>
+    void process(const T* in, T* out, std::size_t count,
+                 Frame&& frame) noexcept
+    {
+        while (count > 0) {
+            const std::size_t n = std::min(count, hop_ - filled_);
+            // in is read completely before out is written.
+            push(in, n);
+            std::copy(pending_.data() + filled_, pending_.data() + filled_ + n,
+                      out);
+            filled_ += n;
+            in += n;
+            out += n;
+            count -= n;
+            if (filled_ == hop_) {
+                C* spectrum = transformFrame();
+                frame(spectrum);
+                synthesize(spectrum, pending_.data());
+                filled_ = 0;
+            }
+        }
+    }
+
+    // Clears the input history and the overlap-add buffer.
+    void reset() noexcept
+    {
+        std::fill(history_.data(), history_.data() + history_.size(), T(0));
+        std::fill(overlap_.data(), overlap_.data() + overlap_.size(), T(0));
+        std::fill(pending_.data(), pending_.data() + pending_.size(), T(0));
+        write_ = 0;
+        filled_ = 0;
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildStft(const std::size_t fftSize,
+                                         const std::size_t hopSize,
+                                         const U* window,
+                                         Stft<U>& stft) noexcept;
+
+    void push(const T* in, std::size_t count) noexcept
+    {
+        // The history is stored twice, the newest fftSize() values are always
+        // contiguous from write_ on. count is at most hopSize() <= fftSize().
+        while (count > 0) {
+            const std::size_t n = std::min(count, nfft_ - write_);
+            std::copy(in, in + n, history_.data() + write_);
+            std::copy(in, in + n, history_.data() + write_ + nfft_);
+            write_ = write_ + n == nfft_ ? 0 : write_ + n;
+            in += n;
+            count -= n;
+        }
+    }
+
+    C* transformFrame() noexcept
+    {
+        internal::rfftForwardWindowed<T>(history_.data() + write_,
+                                         analysisWindow_.data(),
+                                         spectrum_.data(),
+                                         forwardTwiddles_.data(), nfft_);
+        return spectrum_.data();
+    }
+
+    std::size_t nfft_{0};
+    std::size_t hop_{0};
+    // Oldest value of the history and the values since the last frame.
+    std::size_t write_{0};
+    std::size_t filled_{0};
+    internal::AlignedBuffer<C> forwardTwiddles_;
+    internal::AlignedBuffer<C> backwardTwiddles_;
+    internal::AlignedBuffer<T> analysisWindow_;
+    // Includes the factor 2 of the folded spectrum and 1 / fftSize().
+    internal::AlignedBuffer<T> synthesisWindow_;
+    internal::AlignedBuffer<T> history_;
+    internal::AlignedBuffer<C> spectrum_;
+    internal::AlignedBuffer<C> scratch_;
+    internal::AlignedBuffer<T> overlap_;
+    // Output of the last frame, played by process.
+    internal::AlignedBuffer<T> pending_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildStft(const std::size_t fftSize, const std::size_t hopSize,
+                    const T* window, Stft<T>& stft) noexcept
+{
+    if (!isRadix2(fftSize) || fftSize < minimumRfftSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (hopSize == 0 || hopSize > fftSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    Stft<T> created;
+    created.nfft_ = fftSize;
+    created.hop_ = hopSize;
+    try {
+        created.forwardTwiddles_ = AlignedBuffer<std::complex<T>>(fftSize);
+        created.backwardTwiddles_ = AlignedBuffer<std::complex<T>>(fftSize);
+        created.analysisWindow_ = AlignedBuffer<T>(fftSize);
+        created.synthesisWindow_ = AlignedBuffer<T>(fftSize);
+        created.history_ = AlignedBuffer<T>(2 * fftSize);
+        created.spectrum_ = AlignedBuffer<std::complex<T>>(fftSize / 2 + 1);
+        created.scratch_ = AlignedBuffer<std::complex<T>>(fftSize);
+        created.overlap_ = AlignedBuffer<T>(fftSize);
+        created.pending_ = AlignedBuffer<T>(hopSize);
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+    populateRfftTwiddles<T>(created.forwardTwiddles_.data(), fftSize, false);
+    populateRfftTwiddles<T>(created.backwardTwiddles_.data(), fftSize, true);
+
+    // The periodic Hann window unless the caller passes one.
+    using L = long double;
+    T* analysis = created.analysisWindow_.data();
+    if (window != nullptr) {
+        std::copy(window, window + fftSize, analysis);
+    } else {
+        periodicHann<T>(analysis, fftSize);
+    }
+    for (std::size_t n = 0; n < fftSize; n++) {
+        L overlap = 0;
+        for (std::size_t k = n % hopSize; k < fftSize; k += hopSize) {
+            overlap += (L)analysis[k] * (L)analysis[k];
+        }
+        if (overlap == 0) {
+            return FFTSTATUS::INVALID_SIZE;
+        }
+        created.synthesisWindow_[n] =
+            (T)((L)2 * (L)analysis[n] / (overlap * (L)fftSize));
+    }
+
+    stft = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// STFT of frames of fftSize values (a power of two of at least 8) every
+// hopSize <= fftSize values. window holds fftSize values or is nullptr for
+// the periodic Hann window. Returns INVALID_SIZE if the squared windows do not
+// overlap at every position, the frames could not be inverted.
+template <typename T>
+FFTSTATUS createStft(const std::size_t fftSize, const std::size_t hopSize,
+                     const T* window, Stft<T>& stft) noexcept
+{
+    return internal::buildStft<T>(fftSize, hopSize, window, stft);
+}
+
+template <typename T>
+FFTSTATUS createStft(const std::size_t fftSize, const std::size_t hopSize,
+                     Stft<T>& stft) noexcept
+{
+    return createStft<T>(fftSize, hopSize, nullptr, stft);
+}
+} // namespace splitradixfft
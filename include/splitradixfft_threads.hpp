@@ -0,0 +1,724 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_threads.hpp
+ * Work-stealing thread pool, the parallel execution of the split-radix tree and
+ * the parallel batch executor. Every worker owns a task deque, it pops its own
+ * tasks from the back and steals from the front of the other deques when it
+ * runs out of work. Threads waiting for a TaskGroup run pending tasks instead
+ * of blocking.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace splitradixfft {
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+class TaskGroup;
+
+class ThreadPool {
+public:
+    // threads counts the thread that waits for the tasks, a pool of one
+    // thread runs every task inline. Zero selects
+    // std::thread::hardware_concurrency(). If the system refuses to start a
+    // thread the pool runs with the threads started so far.
+    explicit ThreadPool(std::size_t threads = 0) noexcept
+    {
+        if (threads == 0) {
+            threads = std::max<std::size_t>(
+                1, (std::size_t)std::thread::hardware_concurrency());
+        }
+        try {
+            // Queue 0 takes the tasks of threads outside the pool, worker w
+            // owns queue w.
+            for (std::size_t q = 0; q < threads; q++) {
+                queues_.push_back(std::make_unique<Queue>());
+            }
+            for (std::size_t w = 1; w < threads; w++) {
+                workers_.emplace_back([this, w]() { work(w); });
+            }
+        } catch (...) {
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Runs the tasks that are still queued before the workers stop.
+    ~ThreadPool()
+    {
+        while (runOne(0)) {
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+        while (runOne(0)) {
+        }
+    }
+
+    // Number of threads that execute tasks, including the waiting thread.
+    std::size_t size() const noexcept { return workers_.size() + 1; }
+
+    // Queue a task nobody waits for, it must not throw. On a pool of one
+    // thread or if queueing fails to allocate the task runs inline.
+    template <typename Function>
+    void post(Function&& function) noexcept
+    {
+        if (size() > 1) {
+            try {
+                push({std::function<void()>(function), nullptr});
+                return;
+            } catch (...) {
+            }
+        }
+        function();
+    }
+
+private:
+    friend class TaskGroup;
+
+    struct Task {
+        std::function<void()> function;
+        std::atomic<std::size_t>* pending;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    struct Current {
+        const ThreadPool* pool{nullptr};
+        std::size_t queue{0};
+    };
+
+    static Current& current() noexcept
+    {
+        static thread_local Current value;
+        return value;
+    }
+
+    std::size_t ownQueue() const noexcept
+    {
+        const Current& value = current();
+        return value.pool == this ? value.queue : 0;
+    }
+
+    // Throws std::bad_alloc, the task is not queued in that case.
+    void push(Task task)
+    {
+        // Count the task before it becomes visible, pop never decrements
+        // below zero.
+        Queue& queue = *queues_[ownQueue()];
+        queued_.fetch_add(1, std::memory_order_release);
+        try {
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            queue.tasks.push_back(std::move(task));
+        } catch (...) {
+            queued_.fetch_sub(1, std::memory_order_relaxed);
+            throw;
+        }
+        {
+            // Pairs with the predicate check of a worker going to sleep.
+            std::lock_guard<std::mutex> lock(sleepMutex_);
+        }
+        wake_.notify_one();
+    }
+
+    bool pop(std::size_t q, bool back, Task& task) noexcept
+    {
+        Queue& queue = *queues_[q];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+        if (back) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        queued_.fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    bool runOne(std::size_t q) noexcept
+    {
+        // Newest own task first, it works on the data touched last. Steal the
+        // oldest task of another queue, it is the largest one left.
+        if (queues_.empty()) {
+            return false;
+        }
+        Task task;
+        bool found = pop(q, true, task);
+        for (std::size_t k = 1; !found && k < queues_.size(); k++) {
+            found = pop((q + k) % queues_.size(), false, task);
+        }
+        if (!found) {
+            return false;
+        }
+        task.function();
+        if (task.pending != nullptr) {
+            task.pending->fetch_sub(1, std::memory_order_release);
+        }
+        return true;
+    }
+
+    void work(std::size_t q) noexcept
+    {
+        current() = {this, q};
+        for (;;) {
+            if (runOne(q)) {
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this]() {
+                return stop_ ||
+                       queued_.load(std::memory_order_acquire) > 0;
+            });
+            if (stop_) {
+                return;
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<Queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> queued_{0};
+    std::mutex sleepMutex_;
+    std::condition_variable wake_;
+    bool stop_{false};
+};
+
+// Fork-join scope on a pool. Tasks must not throw. The destructor waits for
+// the tasks that are still running.
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool) noexcept : pool_(pool) {}
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    ~TaskGroup() { wait(); }
+
+    // Queue the task. It runs inline on a pool of one thread or if queueing
+    // fails to allocate.
+    template <typename Function>
+    void run(Function&& function) noexcept
+    {
+        if (pool_.size() > 1) {
+            pending_.fetch_add(1, std::memory_order_relaxed);
+            try {
+                pool_.push({std::function<void()>(function), &pending_});
+                return;
+            } catch (...) {
+                pending_.fetch_sub(1, std::memory_order_relaxed);
+            }
+        }
+        function();
+    }
+
+    // Run queued tasks of the pool until all tasks of the group completed.
+    void wait() noexcept
+    {
+        const std::size_t q = pool_.ownQueue();
+        while (pending_.load(std::memory_order_acquire) > 0) {
+            if (!pool_.runOne(q)) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+private:
+    ThreadPool& pool_;
+    std::atomic<std::size_t> pending_{0};
+};
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+// Nodes of the split-radix tree below this size run serially on one thread.
+// Smaller subtrees finish in a few microseconds, which is the order of the
+// task overhead.
+constexpr std::size_t parallelSerialCutoff = (std::size_t)1 << 14;
+
+// Butterflies and gathered values per task of the parallel loops.
+constexpr std::size_t parallelCombineGrain = 2048;
+constexpr std::size_t parallelGatherGrain = (std::size_t)1 << 14;
+
+template <typename Function>
+void parallelChunks(ThreadPool& pool, std::size_t count, std::size_t grain,
+                    Function function) noexcept
+{
+    // function(begin, end) for consecutive ranges of grain items.
+    TaskGroup group(pool);
+    std::size_t begin = 0;
+    for (; begin + grain < count; begin += grain) {
+        group.run([&function, begin, grain]() {
+            function(begin, begin + grain);
+        });
+    }
+    function(begin, count);
+    group.wait();
+}
+
+template <typename T, bool F>
+void executePermutedStepsParallel(const ScheduleStep* schedule,
+                                  std::size_t length, std::size_t N,
+                                  std::complex<T>* data,
+                                  const std::complex<T>* twiddle,
+                                  ThreadPool& pool, std::size_t cutoff,
+                                  T scale = T(1)) noexcept
+{
+    // executePermutedSteps for the subtree of size N whose length steps start
+    // at schedule. The three children of a node are consecutive subranges of
+    // the schedule and run as tasks, then the combine loop of the node is
+    // split into chunks. The combine of the subtree multiplies by scale.
+    if (N < cutoff || N <= maxLeafSize) {
+        executePermutedSteps<T, F>(schedule, length, data, twiddle, scale);
+        return;
+    }
+    const std::size_t half = scheduleLength(N / 2);
+    const std::size_t quarter = scheduleLength(N / 4);
+    {
+        TaskGroup group(pool);
+        group.run([=, &pool]() {
+            executePermutedStepsParallel<T, F>(schedule, half, N / 2, data,
+                                               twiddle, pool, cutoff);
+        });
+        group.run([=, &pool]() {
+            executePermutedStepsParallel<T, F>(schedule + half, quarter, N / 4,
+                                               data, twiddle, pool, cutoff);
+        });
+        executePermutedStepsParallel<T, F>(schedule + half + quarter, quarter,
+                                           N / 4, data, twiddle, pool, cutoff);
+        group.wait();
+    }
+    const ScheduleStep& step = schedule[length - 1];
+    std::complex<T>* node{data + step.outIndex};
+    const std::complex<T>* w{twiddle + step.offset};
+    parallelChunks(pool, N / 4, parallelCombineGrain,
+                   [node, w, &step, scale](std::size_t begin, std::size_t end) {
+                       if (scale != T(1)) {
+                           combineButterfliesRange<T, F, true>(
+                               node, w, step.stride, step.N, begin, end, scale);
+                       } else {
+                           combineButterfliesRange<T, F>(node, w, step.stride,
+                                                         step.N, begin, end);
+                       }
+                   });
+}
+
+template <typename T, bool F>
+void executePermutedScheduleParallel(
+    const ScheduleStep* schedule, std::size_t length, const std::complex<T>* in,
+    std::complex<T>* out, const std::complex<T>* twiddle,
+    const std::uint32_t* permutation, std::size_t size, std::size_t inStride,
+    ThreadPool& pool, std::size_t cutoff, T scale = T(1)) noexcept
+{
+    // Same results as executePermutedSchedule, bit for bit.
+    parallelChunks(pool, size, parallelGatherGrain,
+                   [=](std::size_t begin, std::size_t end) {
+                       permuteGather<T>(in, out + begin, permutation + begin,
+                                        end - begin, inStride);
+                   });
+    executePermutedStepsParallel<T, F>(schedule, length, size, out, twiddle,
+                                       pool, cutoff, scale);
+}
+
+// Batch executors size their chunks of sequences to this many bytes of input
+// and output, a share of a typical per core L2 cache that leaves room for the
+// twiddle factors and the scratch space.
+constexpr std::size_t batchCacheBytes = (std::size_t)1 << 18;
+
+// Chunks per thread the batch executors aim for at least, so threads that
+// finish early can steal the work of slower ones.
+constexpr std::size_t batchChunksPerThread = 4;
+
+inline std::size_t batchChunkSize(std::size_t howMany,
+                                  std::size_t sequenceBytes,
+                                  std::size_t threads) noexcept
+{
+    std::size_t chunk = batchCacheBytes / sequenceBytes;
+    std::size_t balanced = (howMany + threads * batchChunksPerThread - 1) /
+                           (threads * batchChunksPerThread);
+    return std::max<std::size_t>(1, std::min(chunk, balanced));
+}
+
+template <typename T>
+std::complex<T>* threadScratch(std::size_t size) noexcept
+{
+    // Scratch space of the calling thread, it grows to the largest size
+    // requested and is reused by every later batch. nullptr if growing fails.
+    static thread_local std::vector<std::complex<T>> buffer;
+    if (buffer.size() < size) {
+        try {
+            buffer.resize(size);
+        } catch (const std::bad_alloc&) {
+            return nullptr;
+        }
+    }
+    return buffer.data();
+}
+
+inline FFTSTATUS validateBatch(std::size_t nfft, std::size_t minimumSize,
+                               const void* twiddleFactors,
+                               std::size_t twiddleFactorSize,
+                               std::size_t inStride, std::size_t outStride,
+                               const void* in, const void* out) noexcept
+{
+    // The checks of the performXxxBatch functions except for the scratch
+    // space, which the executors provide themselves.
+    if (!isRadix2(nfft) || nfft < minimumSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (nfft != twiddleFactorSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (inStride == 0 || outStride == 0) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (twiddleFactors == nullptr || in == nullptr || out == nullptr) {
+        return FFTSTATUS::NULL_POINTER;
+    }
+
+    return FFTSTATUS::OK;
+}
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+// Spreads batches of independent transforms over the threads of a pool. The
+// arguments follow the performXxxBatch functions of splitradixfft.hpp, the
+// sequences are split into chunks that fit the L2 cache of a core and every
+// thread uses its own scratch space. The results are identical to the serial
+// batch functions.
+template <typename T>
+class BatchExecutor {
+public:
+    using C = std::complex<T>;
+    // Called once with the status of the batch, on the thread that finished
+    // the last chunk. It must not throw.
+    using Callback = std::function<void(FFTSTATUS)>;
+
+    explicit BatchExecutor(ThreadPool& pool) noexcept : pool_(pool) {}
+
+    // Blocking calls, they return once the whole batch is transformed.
+    FFTSTATUS cfftForward(std::size_t nfft, const C* twiddleFactors,
+                          std::size_t twiddleFactorSize, std::size_t howMany,
+                          const C* in, std::size_t inStride,
+                          std::size_t inDistance, C* out,
+                          std::size_t outStride,
+                          std::size_t outDistance) noexcept
+    {
+        return cfft<false>(nfft, twiddleFactors, twiddleFactorSize, howMany,
+                           in, inStride, inDistance, out, outStride,
+                           outDistance, nullptr);
+    }
+
+    FFTSTATUS cfftBackward(std::size_t nfft, const C* twiddleFactors,
+                           std::size_t twiddleFactorSize, std::size_t howMany,
+                           const C* in, std::size_t inStride,
+                           std::size_t inDistance, C* out,
+                           std::size_t outStride,
+                           std::size_t outDistance) noexcept
+    {
+        return cfft<true>(nfft, twiddleFactors, twiddleFactorSize, howMany, in,
+                          inStride, inDistance, out, outStride, outDistance,
+                          nullptr);
+    }
+
+    FFTSTATUS rfftForward(std::size_t nfft, const C* twiddleFactors,
+                          std::size_t twiddleFactorSize, std::size_t howMany,
+                          const T* in, std::size_t inStride,
+                          std::size_t inDistance, C* out,
+                          std::size_t outStride,
+                          std::size_t outDistance) noexcept
+    {
+        return rfftForwardImpl(nfft, twiddleFactors, twiddleFactorSize,
+                               howMany, in, inStride, inDistance, out,
+                               outStride, outDistance, nullptr);
+    }
+
+    FFTSTATUS rfftBackward(std::size_t nfft, const C* twiddleFactors,
+                           std::size_t twiddleFactorSize, std::size_t howMany,
+                           const C* in, std::size_t inStride,
+                           std::size_t inDistance, T* out,
+                           std::size_t outStride,
+                           std::size_t outDistance) noexcept
+    {
+        return rfftBackwardImpl(nfft, twiddleFactors, twiddleFactorSize,
+                                howMany, in, inStride, inDistance, out,
+                                outStride, outDistance, nullptr);
+    }
+
+    // Asynchronous calls. Invalid arguments are reported by the return value
+    // and done is not called. Otherwise the call returns OK right away and
+    // done receives the status of the batch once it completed, the arrays
+    // have to stay valid until then. On a pool of one thread the batch runs
+    // before the call returns.
+    FFTSTATUS cfftForward(std::size_t nfft, const C* twiddleFactors,
+                          std::size_t twiddleFactorSize, std::size_t howMany,
+                          const C* in, std::size_t inStride,
+                          std::size_t inDistance, C* out,
+                          std::size_t outStride, std::size_t outDistance,
+                          Callback done) noexcept
+    {
+        return cfft<false>(nfft, twiddleFactors, twiddleFactorSize, howMany,
+                           in, inStride, inDistance, out, outStride,
+                           outDistance, &done);
+    }
+
+    FFTSTATUS cfftBackward(std::size_t nfft, const C* twiddleFactors,
+                           std::size_t twiddleFactorSize, std::size_t howMany,
+                           const C* in, std::size_t inStride,
+                           std::size_t inDistance, C* out,
+                           std::size_t outStride, std::size_t outDistance,
+                           Callback done) noexcept
+    {
+        return cfft<true>(nfft, twiddleFactors, twiddleFactorSize, howMany, in,
+                          inStride, inDistance, out, outStride, outDistance,
+                          &done);
+    }
+
+    FFTSTATUS rfftForward(std::size_t nfft, const C* twiddleFactors,
+                          std::size_t twiddleFactorSize, std::size_t howMany,
+                          const T* in, std::size_t inStride,
+                          std::size_t inDistance, C* out,
+                          std::size_t outStride, std::size_t outDistance,
+                          Callback done) noexcept
+    {
+        return rfftForwardImpl(nfft, twiddleFactors, twiddleFactorSize,
+                               howMany, in, inStride, inDistance, out,
+                               outStride, outDistance, &done);
+    }
+
+    FFTSTATUS rfftBackward(std::size_t nfft, const C* twiddleFactors,
+                           std::size_t twiddleFactorSize, std::size_t howMany,
+                           const C* in, std::size_t inStride,
+                           std::size_t inDistance, T* out,
+                           std::size_t outStride, std::size_t outDistance,
+                           Callback done) noexcept
+    {
+        return rfftBackwardImpl(nfft, twiddleFactors, twiddleFactorSize,
+                                howMany, in, inStride, inDistance, out,
+                                outStride, outDistance, &done);
+    }
+
+private:
+    struct Job {
+        std::atomic<std::size_t> remaining{0};
+        std::atomic<FFTSTATUS> status{FFTSTATUS::OK};
+        Callback done;
+    };
+
+    template <bool F>
+    FFTSTATUS cfft(std::size_t nfft, const C* twiddleFactors,
+                   std::size_t twiddleFactorSize, std::size_t howMany,
+                   const C* in, std::size_t inStride, std::size_t inDistance,
+                   C* out, std::size_t outStride, std::size_t outDistance,
+                   Callback* done) noexcept
+    {
+        FFTSTATUS status = internal::validateBatch(
+            nfft, 1, twiddleFactors, twiddleFactorSize, inStride, outStride,
+            in, out);
+        if (status != FFTSTATUS::OK) {
+            return status;
+        }
+        auto transform = [=](std::size_t begin, std::size_t end) {
+            // Strided outputs go through nfft values of scratch.
+            C* scratch = nullptr;
+            if (outStride != 1) {
+                scratch = internal::threadScratch<T>(nfft);
+                if (scratch == nullptr) {
+                    return FFTSTATUS::ALLOCATION_FAILED;
+                }
+            }
+            internal::cfftBatch<T, F>(twiddleFactors, nfft, end - begin,
+                                      in + begin * inDistance, inStride,
+                                      inDistance, out + begin * outDistance,
+                                      outStride, outDistance, scratch);
+            return FFTSTATUS::OK;
+        };
+        return run(howMany, 2 * nfft * sizeof(C), transform, done);
+    }
+
+    FFTSTATUS rfftForwardImpl(std::size_t nfft, const C* twiddleFactors,
+                              std::size_t twiddleFactorSize,
+                              std::size_t howMany, const T* in,
+                              std::size_t inStride, std::size_t inDistance,
+                              C* out, std::size_t outStride,
+                              std::size_t outDistance, Callback* done) noexcept
+    {
+        FFTSTATUS status = internal::validateBatch(
+            nfft, internal::minimumRfftSize, twiddleFactors,
+            twiddleFactorSize, inStride, outStride, in, out);
+        if (status != FFTSTATUS::OK) {
+            return status;
+        }
+        auto transform = [=](std::size_t begin, std::size_t end) {
+            // Strided outputs go through nfft / 2 + 1 values of scratch.
+            C* scratch = nullptr;
+            if (outStride != 1) {
+                scratch = internal::threadScratch<T>(nfft / 2 + 1);
+                if (scratch == nullptr) {
+                    return FFTSTATUS::ALLOCATION_FAILED;
+                }
+            }
+            internal::rfftForwardBatch<T>(
+                twiddleFactors, nfft, end - begin, in + begin * inDistance,
+                inStride, inDistance, out + begin * outDistance, outStride,
+                outDistance, scratch);
+            return FFTSTATUS::OK;
+        };
+        return run(howMany, nfft * sizeof(T) + (nfft / 2 + 1) * sizeof(C),
+                   transform, done);
+    }
+
+    FFTSTATUS rfftBackwardImpl(std::size_t nfft, const C* twiddleFactors,
+                               std::size_t twiddleFactorSize,
+                               std::size_t howMany, const C* in,
+                               std::size_t inStride, std::size_t inDistance,
+                               T* out, std::size_t outStride,
+                               std::size_t outDistance,
+                               Callback* done) noexcept
+    {
+        FFTSTATUS status = internal::validateBatch(
+            nfft, internal::minimumRfftSize, twiddleFactors,
+            twiddleFactorSize, inStride, outStride, in, out);
+        if (status != FFTSTATUS::OK) {
+            return status;
+        }
+        auto transform = [=](std::size_t begin, std::size_t end) {
+            // Two scratch spaces of nfft / 2 + 1 values.
+            C* scratch = internal::threadScratch<T>(2 * (nfft / 2 + 1));
+            if (scratch == nullptr) {
+                return FFTSTATUS::ALLOCATION_FAILED;
+            }
+            internal::rfftBackwardBatch<T>(
+                twiddleFactors, nfft, end - begin, in + begin * inDistance,
+                inStride, inDistance, out + begin * outDistance, outStride,
+                outDistance, scratch, scratch + nfft / 2 + 1);
+            return FFTSTATUS::OK;
+        };
+        return run(howMany, nfft * sizeof(T) + (nfft / 2 + 1) * sizeof(C),
+                   transform, done);
+    }
+
+    template <typename Transform>
+    FFTSTATUS run(std::size_t howMany, std::size_t sequenceBytes,
+                  Transform transform, Callback* done) noexcept
+    {
+        // transform(begin, end) handles the sequences begin to end and
+        // returns their status.
+        const std::size_t chunk =
+            internal::batchChunkSize(howMany, sequenceBytes, pool_.size());
+        if (done == nullptr) {
+            std::atomic<FFTSTATUS> status{FFTSTATUS::OK};
+            internal::parallelChunks(
+                pool_, howMany, chunk,
+                [&transform, &status](std::size_t begin, std::size_t end) {
+                    FFTSTATUS chunkStatus = transform(begin, end);
+                    if (chunkStatus != FFTSTATUS::OK) {
+                        status.store(chunkStatus);
+                    }
+                });
+            return status.load();
+        }
+
+        std::shared_ptr<Job> job;
+        try {
+            job = std::make_shared<Job>();
+            job->done = std::move(*done);
+        } catch (const std::bad_alloc&) {
+            return FFTSTATUS::ALLOCATION_FAILED;
+        }
+        if (howMany == 0) {
+            job->done(FFTSTATUS::OK);
+            return FFTSTATUS::OK;
+        }
+        job->remaining.store((howMany + chunk - 1) / chunk);
+        for (std::size_t begin = 0; begin < howMany; begin += chunk) {
+            const std::size_t end = std::min(begin + chunk, howMany);
+            pool_.post([job, transform, begin, end]() {
+                FFTSTATUS chunkStatus = transform(begin, end);
+                if (chunkStatus != FFTSTATUS::OK) {
+                    job->status.store(chunkStatus);
+                }
+                if (job->remaining.fetch_sub(1, std::memory_order_acq_rel) ==
+                    1) {
+                    job->done(job->status.load());
+                }
+            });
+        }
+        return FFTSTATUS::OK;
+    }
+
+    ThreadPool& pool_;
+};
+} // namespace splitradixfft
@@ -0,0 +1,370 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_welch.hpp
+ * Welch estimates of power and cross spectral densities. Segments are windowed
+ * while the leaves of the real transform load them, and their half-spectra
+ * are accumulated into a fixed number of partial sums, one spectrum per
+ * accumulator at a time. The partial sums run in parallel and are added in a
+ * fixed order, so the estimates do not depend on the number of threads.
+ *
+ * ==============================================================================
+ */
+
+#pragma once
+#include "splitradixfft_plan.hpp"
+#include "splitradixfft_spectral.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace splitradixfft {
+
+// DENSITY divides by the sample rate and the sum of the squared window, the
+// result is in units² / Hz. SPECTRUM divides by the squared sum of the window,
+// so a sine of amplitude A at the centre of a bin estimates A² / 2.
+enum class SpectralScaling { DENSITY = 0, SPECTRUM = 1 };
+
+template <typename T>
+class WelchEstimator;
+
+/*
+ * ==============================================================================
+ *
+ * Internal API
+ *
+ * ==============================================================================
+ */
+namespace internal {
+
+// Partial sums of an estimator unless the caller picks another number. Every
+// one holds a half-spectrum per channel.
+constexpr std::size_t welchAccumulators = 8;
+
+template <typename T>
+FFTSTATUS buildWelchEstimator(const std::size_t segmentSize,
+                              const std::size_t hopSize,
+                              const std::size_t channels, const T* window,
+                              const T sampleRate, const SpectralScaling scaling,
+                              const std::size_t accumulators,
+                              WelchEstimator<T>& estimator) noexcept;
+
+} // namespace internal
+
+/*
+ * ==============================================================================
+ *
+ * Public API
+ *
+ * ==============================================================================
+ */
+
+// Averages the periodograms of the segments of segmentSize() values that start
+// every hopSize() values of the input. Segment s is assigned to partial sum
+// s * accumulators() / segments, which fixes the order of every addition
+// regardless of how the partial sums are spread over threads.
+template <typename T>
+class WelchEstimator {
+public:
+    using C = std::complex<T>;
+
+    WelchEstimator() = default;
+    WelchEstimator(const WelchEstimator&) = delete;
+    WelchEstimator& operator=(const WelchEstimator&) = delete;
+    WelchEstimator(WelchEstimator&&) noexcept = default;
+    WelchEstimator& operator=(WelchEstimator&&) noexcept = default;
+
+    std::size_t segmentSize() const noexcept { return nfft_; }
+    std::size_t hopSize() const noexcept { return hop_; }
+    std::size_t channels() const noexcept { return channels_; }
+    std::size_t accumulators() const noexcept { return accumulators_; }
+    // Values of a one-sided estimate, from 0 to the Nyquist frequency.
+    std::size_t binCount() const noexcept { return nfft_ / 2 + 1; }
+    // Segments that fit into length values.
+    std::size_t segments(std::size_t length) const noexcept
+    {
+        return length < nfft_ ? 0 : (length - nfft_) / hop_ + 1;
+    }
+
+    // One-sided power spectral density of channels() sequences of length
+    // values, in[c] is estimated into the binCount() values of out[c].
+    // Returns INVALID_SIZE if length is shorter than a segment.
+    FFTSTATUS psd(const T* const* in, std::size_t length,
+                  T* const* out) noexcept
+    {
+        return psd(in, length, out, nullptr);
+    }
+
+    FFTSTATUS psd(const T* const* in, std::size_t length, T* const* out,
+                  ThreadPool& pool) noexcept
+    {
+        return psd(in, length, out, &pool);
+    }
+
+    // One-sided cross spectral density, the average of conj(X) * Y over the
+    // segments, scaled like psd. csd(x, x, ...) is psd of x.
+    FFTSTATUS csd(const T* x, const T* y, std::size_t length, C* out) noexcept
+    {
+        return csd(x, y, length, out, nullptr);
+    }
+
+    FFTSTATUS csd(const T* x, const T* y, std::size_t length, C* out,
+                  ThreadPool& pool) noexcept
+    {
+        return csd(x, y, length, out, &pool);
+    }
+
+private:
+    template <typename U>
+    friend FFTSTATUS internal::buildWelchEstimator(
+        const std::size_t segmentSize, const std::size_t hopSize,
+        const std::size_t channels, const U* window, const U sampleRate,
+        const SpectralScaling scaling, const std::size_t accumulators,
+        WelchEstimator<U>& estimator) noexcept;
+
+    FFTSTATUS psd(const T* const* in, std::size_t length, T* const* out,
+                  ThreadPool* pool) noexcept
+    {
+        if (in == nullptr || out == nullptr) {
+            return FFTSTATUS::NULL_POINTER;
+        }
+        for (std::size_t c = 0; c < channels_; c++) {
+            if (in[c] == nullptr || out[c] == nullptr) {
+                return FFTSTATUS::NULL_POINTER;
+            }
+        }
+        const std::size_t count = segments(length);
+        if (count == 0) {
+            return FFTSTATUS::INVALID_SIZE;
+        }
+
+        const std::size_t bins = binCount();
+        forEachAccumulator(pool, [&](std::size_t slot) {
+            C* spectrum = spectra_.data() + slot * 2 * bins;
+            C* sums = sums_.data() + slot * channels_ * bins;
+            std::fill(sums, sums + channels_ * bins, C(0));
+            // Channel by channel, only one partial sum is written at a time
+            // and every input is read in order.
+            const std::size_t begin = slot * count / accumulators_;
+            const std::size_t end = (slot + 1) * count / accumulators_;
+            for (std::size_t c = 0; c < channels_; c++) {
+                for (std::size_t s = begin; s < end; s++) {
+                    transform(in[c] + s * hop_, spectrum);
+                    internal::accumulateSquares<T>(sums + c * bins, spectrum,
+                                                   bins);
+                }
+            }
+        });
+
+        for (std::size_t c = 0; c < channels_; c++) {
+            for (std::size_t k = 0; k < bins; k++) {
+                T sum{0};
+                for (std::size_t slot = 0; slot < accumulators_; slot++) {
+                    const C value = sums_[(slot * channels_ + c) * bins + k];
+                    sum += value.real() + value.imag();
+                }
+                out[c][k] = sum * binScale(k, count);
+            }
+        }
+        return FFTSTATUS::OK;
+    }
+
+    FFTSTATUS csd(const T* x, const T* y, std::size_t length, C* out,
+                  ThreadPool* pool) noexcept
+    {
+        if (x == nullptr || y == nullptr || out == nullptr) {
+            return FFTSTATUS::NULL_POINTER;
+        }
+        const std::size_t count = segments(length);
+        if (count == 0) {
+            return FFTSTATUS::INVALID_SIZE;
+        }
+
+        const std::size_t bins = binCount();
+        forEachAccumulator(pool, [&](std::size_t slot) {
+            C* spectrumX = spectra_.data() + slot * 2 * bins;
+            C* spectrumY = spectrumX + bins;
+            C* sums = sums_.data() + slot * channels_ * bins;
+            std::fill(sums, sums + bins, C(0));
+            const std::size_t end = (slot + 1) * count / accumulators_;
+            for (std::size_t s = slot * count / accumulators_; s < end; s++) {
+                transform(x + s * hop_, spectrumX);
+                transform(y + s * hop_, spectrumY);
+                internal::multiplyConjugateAccumulateSpectrum<T>(
+                    sums, spectrumX, spectrumY, bins);
+            }
+        });
+
+        for (std::size_t k = 0; k < bins; k++) {
+            C sum{0};
+            for (std::size_t slot = 0; slot < accumulators_; slot++) {
+                sum += sums_[slot * channels_ * bins + k];
+            }
+            out[k] = sum * binScale(k, count);
+        }
+        return FFTSTATUS::OK;
+    }
+
+    template <typename Function>
+    void forEachAccumulator(ThreadPool* pool, Function&& function) noexcept
+    {
+        if (pool == nullptr) {
+            for (std::size_t slot = 0; slot < accumulators_; slot++) {
+                function(slot);
+            }
+            return;
+        }
+        internal::parallelChunks(*pool, accumulators_, 1,
+                                 [&function](std::size_t begin,
+                                             std::size_t end) {
+                                     for (std::size_t slot = begin; slot < end;
+                                          slot++) {
+                                         function(slot);
+                                     }
+                                 });
+    }
+
+    void transform(const T* segment, C* spectrum) const noexcept
+    {
+        internal::rfftForwardWindowed<T>(segment, window_.data(), spectrum,
+                                         twiddles_.data(), nfft_);
+    }
+
+    T binScale(std::size_t k, std::size_t count) const noexcept
+    {
+        // Bins other than DC and Nyquist also hold the negative frequencies.
+        const T folded = k == 0 || k == nfft_ / 2 ? T(1) : T(2);
+        return folded * scale_ / (T)count;
+    }
+
+    std::size_t nfft_{0};
+    std::size_t hop_{0};
+    std::size_t channels_{0};
+    std::size_t accumulators_{0};
+    // 1 / (sampleRate * sum(w²)) or 1 / sum(w)².
+    T scale_{0};
+    internal::AlignedBuffer<C> twiddles_;
+    internal::AlignedBuffer<T> window_;
+    // Two half-spectra per accumulator.
+    internal::AlignedBuffer<C> spectra_;
+    // A half-spectrum per accumulator and channel, the squares of the real
+    // and imaginary parts are summed separately for psd.
+    internal::AlignedBuffer<C> sums_;
+};
+
+namespace internal {
+template <typename T>
+FFTSTATUS buildWelchEstimator(const std::size_t segmentSize,
+                              const std::size_t hopSize,
+                              const std::size_t channels, const T* window,
+                              const T sampleRate, const SpectralScaling scaling,
+                              const std::size_t accumulators,
+                              WelchEstimator<T>& estimator) noexcept
+{
+    if (!isRadix2(segmentSize) || segmentSize < minimumRfftSize) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    if (hopSize == 0 || channels == 0 || !(sampleRate > T(0))) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+
+    WelchEstimator<T> created;
+    created.nfft_ = segmentSize;
+    created.hop_ = hopSize;
+    created.channels_ = channels;
+    created.accumulators_ = accumulators == 0 ? welchAccumulators
+                                              : accumulators;
+    const std::size_t bins = segmentSize / 2 + 1;
+    try {
+        created.twiddles_ = AlignedBuffer<std::complex<T>>(segmentSize);
+        created.window_ = AlignedBuffer<T>(segmentSize);
+        created.spectra_ =
+            AlignedBuffer<std::complex<T>>(created.accumulators_ * 2 * bins);
+        created.sums_ = AlignedBuffer<std::complex<T>>(created.accumulators_ *
+                                                       channels * bins);
+    } catch (const std::bad_alloc&) {
+        return FFTSTATUS::ALLOCATION_FAILED;
+    }
+    populateRfftTwiddles<T>(created.twiddles_.data(), segmentSize, false);
+
+    // The periodic Hann window unless the caller passes one.
+    using L = long double;
+    T* w = created.window_.data();
+    if (window != nullptr) {
+        std::copy(window, window + segmentSize, w);
+    } else {
+        periodicHann<T>(w, segmentSize);
+    }
+    L sum = 0;
+    L sumOfSquares = 0;
+    for (std::size_t n = 0; n < segmentSize; n++) {
+        sum += (L)w[n];
+        sumOfSquares += (L)w[n] * (L)w[n];
+    }
+    const L norm = scaling == SpectralScaling::DENSITY
+                       ? (L)sampleRate * sumOfSquares
+                       : sum * sum;
+    if (norm == 0) {
+        return FFTSTATUS::INVALID_SIZE;
+    }
+    created.scale_ = (T)((L)1 / norm);
+
+    estimator = std::move(created);
+    return FFTSTATUS::OK;
+}
+} // namespace internal
+
+// Welch estimator for segments of segmentSize values (a power of two of at
+// least 8) every hopSize values of channels sequences. window holds
+// segmentSize values or is nullptr for the periodic Hann window. accumulators
+// is the number of partial sums and bounds the threads an estimate can use, 0
+// selects internal::welchAccumulators.
+template <typename T>
+FFTSTATUS createWelchEstimator(const std::size_t segmentSize,
+                               const std::size_t hopSize,
+                               const std::size_t channels, const T* window,
+                               const T sampleRate,
+                               const SpectralScaling scaling,
+                               WelchEstimator<T>& estimator,
+                               const std::size_t accumulators = 0) noexcept
+{
+    return internal::buildWelchEstimator<T>(segmentSize, hopSize, channels,
+                                            window, sampleRate, scaling,
+                                            accumulators, estimator);
+}
+
+// Periodic Hann window, densities per unit of the sample rate.
+template <typename T>
+FFTSTATUS createWelchEstimator(const std::size_t segmentSize,
+                               const std::size_t hopSize,
+                               const std::size_t channels,
+                               WelchEstimator<T>& estimator) noexcept
+{
+    return createWelchEstimator<T>(segmentSize, hopSize, channels, nullptr,
+                                   T(1), SpectralScaling::DENSITY, estimator);
+}
+} // namespace splitradixfft
@@ -0,0 +1,237 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
+
+// Element layouts tested for a batch of howMany sequences of size values:
+// contiguous rows, interleaved channels and padded strided rows.
+struct Layout {
+    std::size_t stride;
+    std::size_t distance;
+};
+
+static std::vector<Layout> layouts(std::size_t size, std::size_t howMany)
+{
+    return {{1, size}, {howMany, 1}, {2, 2 * size + 3}};
+}
+
+static std::size_t extent(const Layout& layout, std::size_t size,
+                          std::size_t howMany)
+{
+    return (howMany - 1) * layout.distance + (size - 1) * layout.stride + 1;
+}
+
+TEST_CASE("performCfftForwardBatchDouble::MatchesSingleTransforms", "[batch]")
+{
+    using C = std::complex<double>;
+    const std::size_t howMany = 5;
+    for (std::size_t nfft = 1; nfft <= 256; nfft *= 4) {
+        auto twiddleFactors = std::make_unique<C[]>(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<double>(
+            nfft, twiddleFactors.get(), nfft);
+        std::vector<C> scratch(nfft);
+        for (const Layout& inLayout : layouts(nfft, howMany)) {
+            for (const Layout& outLayout : layouts(nfft, howMany)) {
+                auto in = reference::randomSequence<double>(
+                    extent(inLayout, nfft, howMany));
+                std::vector<C> out(extent(outLayout, nfft, howMany));
+                REQUIRE(splitradixfft::performCfftForwardBatch<double>(
+                            nfft, twiddleFactors.get(), nfft, howMany,
+                            in.data(), inLayout.stride, inLayout.distance,
+                            out.data(), outLayout.stride, outLayout.distance,
+                            scratch.data(),
+                            scratch.size()) == splitradixfft::FFTSTATUS::OK);
+                for (std::size_t b = 0; b < howMany; b++) {
+                    std::vector<C> single(nfft);
+                    std::vector<C> ref(nfft);
+                    for (std::size_t i = 0; i < nfft; i++) {
+                        single[i] =
+                            in[b * inLayout.distance + i * inLayout.stride];
+                    }
+                    splitradixfft::internal::cfftForward<double>(
+                        single.data(), ref.data(), twiddleFactors.get(), nfft);
+                    for (std::size_t i = 0; i < nfft; i++) {
+                        REQUIRE(out[b * outLayout.distance +
+                                    i * outLayout.stride] == ref[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("performRfftBatchFloat::RoundTrip", "[batch]")
+{
+    using C = std::complex<float>;
+    const std::size_t howMany = 4;
+    const std::size_t nfft = 64;
+    auto forwardTwiddles = std::make_unique<C[]>(nfft);
+    auto backwardTwiddles = std::make_unique<C[]>(nfft);
+    splitradixfft::populateRfftTwiddleFactorsForward<float>(
+        nfft, forwardTwiddles.get(), nfft);
+    splitradixfft::populateRfftTwiddleFactorsBackward<float>(
+        nfft, backwardTwiddles.get(), nfft);
+    std::vector<C> scratch0(nfft / 2 + 1);
+    std::vector<C> scratch1(nfft / 2 + 1);
+
+    for (const Layout& layout : layouts(nfft, howMany)) {
+        const Layout spectrumLayout{
+            layout.stride,
+            layout.distance == 1 ? 1 : layout.stride * (nfft / 2 + 1) + 1};
+        auto sequence =
+            reference::randomSequence<float>(extent(layout, nfft, howMany));
+        std::vector<float> in(sequence.size());
+        for (std::size_t i = 0; i < in.size(); i++) {
+            in[i] = sequence[i].real();
+        }
+        std::vector<C> spectrum(extent(spectrumLayout, nfft / 2 + 1, howMany));
+        REQUIRE(splitradixfft::performRfftForwardBatch<float>(
+                    nfft, forwardTwiddles.get(), nfft, howMany, in.data(),
+                    layout.stride, layout.distance, spectrum.data(),
+                    spectrumLayout.stride, spectrumLayout.distance,
+                    scratch0.data(),
+                    scratch0.size()) == splitradixfft::FFTSTATUS::OK);
+
+        for (std::size_t b = 0; b < howMany; b++) {
+            std::vector<float> single(nfft);
+            for (std::size_t i = 0; i < nfft; i++) {
+                single[i] = in[b * layout.distance + i * layout.stride];
+            }
+            std::vector<C> ref(nfft / 2 + 1);
+            splitradixfft::performRfftForward<float>(
+                nfft, forwardTwiddles.get(), nfft, single.data(), nfft,
+                ref.data(), nfft / 2 + 1, scratch1.data(), nfft / 2 + 1);
+            for (std::size_t i = 0; i < nfft / 2 + 1; i++) {
+                REQUIRE(spectrum[b * spectrumLayout.distance +
+                                 i * spectrumLayout.stride] == ref[i]);
+            }
+        }
+
+        std::vector<float> out(in.size());
+        REQUIRE(splitradixfft::performRfftBackwardBatch<float>(
+                    nfft, backwardTwiddles.get(), nfft, howMany,
+                    spectrum.data(), spectrumLayout.stride,
+                    spectrumLayout.distance, out.data(), layout.stride,
+                    layout.distance, scratch0.data(), scratch1.data(),
+                    scratch0.size()) == splitradixfft::FFTSTATUS::OK);
+        for (std::size_t b = 0; b < howMany; b++) {
+            for (std::size_t i = 0; i < nfft; i++) {
+                const std::size_t idx = b * layout.distance + i * layout.stride;
+                REQUIRE(std::abs(out[idx] / (float)nfft - in[idx]) < 1e-5f);
+            }
+        }
+    }
+}
+
+TEST_CASE("performBatch::InvalidArguments", "[batch]")
+{
+    using C = std::complex<double>;
+    const std::size_t nfft = 16;
+    std::vector<C> twiddleFactors(nfft);
+    std::vector<C> data(nfft);
+    REQUIRE(splitradixfft::performCfftForwardBatch<double>(
+                nfft, twiddleFactors.data(), nfft, 1, data.data(), 0, nfft,
+                data.data(), 1, nfft, nullptr,
+                0) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performCfftForwardBatch<double>(
+                nfft, twiddleFactors.data(), nfft, 1, data.data(), 1, nfft,
+                data.data(), 2, nfft, nullptr,
+                nfft) == splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::performRfftForwardBatch<double>(
+                4, twiddleFactors.data(), 4, 1, (const double*)nullptr, 1, 4,
+                data.data(), 1, 3, nullptr,
+                0) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+}
+
+template <typename T>
+static void requirePlanBatchMatchesExecute(splitradixfft::TransformType type,
+                                           splitradixfft::Direction direction)
+{
+    using C = std::complex<T>;
+    const std::size_t nfft = 512;
+    const std::size_t howMany = 3;
+    splitradixfft::Plan<T> plan;
+    REQUIRE(splitradixfft::createPlan<T>(nfft, type, direction, plan) ==
+            splitradixfft::FFTSTATUS::OK);
+    std::vector<C> scratch(plan.batchScratchSize());
+    std::vector<C> singleScratch(plan.scratchSize());
+    const bool complex = type == splitradixfft::TransformType::COMPLEX;
+    const bool forward = direction == splitradixfft::Direction::FORWARD;
+    const std::size_t inSize = complex || forward ? nfft : nfft / 2 + 1;
+    const std::size_t outSize = complex || !forward ? nfft : nfft / 2 + 1;
+
+    for (const Layout& inLayout : layouts(inSize, howMany)) {
+        for (const Layout& outLayout : layouts(outSize, howMany)) {
+            auto in = reference::randomSequence<T>(
+                extent(inLayout, inSize, howMany));
+            std::vector<T> realIn(in.size());
+            for (std::size_t i = 0; i < in.size(); i++) {
+                realIn[i] = in[i].real();
+            }
+            std::vector<C> out(extent(outLayout, outSize, howMany));
+            std::vector<T> realOut(out.size());
+            if (complex) {
+                plan.executeBatch(howMany, in.data(), inLayout.stride,
+                                  inLayout.distance, out.data(),
+                                  outLayout.stride, outLayout.distance,
+                                  scratch.data());
+            } else if (forward) {
+                plan.executeBatch(howMany, realIn.data(), inLayout.stride,
+                                  inLayout.distance, out.data(),
+                                  outLayout.stride, outLayout.distance,
+                                  scratch.data());
+            } else {
+                plan.executeBatch(howMany, in.data(), inLayout.stride,
+                                  inLayout.distance, realOut.data(),
+                                  outLayout.stride, outLayout.distance,
+                                  scratch.data());
+            }
+
+            for (std::size_t b = 0; b < howMany; b++) {
+                std::vector<C> single(inSize);
+                std::vector<T> realSingle(inSize);
+                for (std::size_t i = 0; i < inSize; i++) {
+                    const std::size_t idx =
+                        b * inLayout.distance + i * inLayout.stride;
+                    single[i] = in[idx];
+                    realSingle[i] = realIn[idx];
+                }
+                std::vector<C> ref(outSize);
+                std::vector<T> realRef(outSize);
+                if (complex) {
+                    plan.execute(single.data(), ref.data());
+                } else if (forward) {
+                    plan.execute(realSingle.data(), ref.data(),
+                                 singleScratch.data());
+                } else {
+                    plan.execute(single.data(), realRef.data(),
+                                 singleScratch.data());
+                }
+                for (std::size_t i = 0; i < outSize; i++) {
+                    const std::size_t idx =
+                        b * outLayout.distance + i * outLayout.stride;
+                    if (!complex && !forward) {
+                        REQUIRE(realOut[idx] == realRef[i]);
+                    } else {
+                        REQUIRE(out[idx] == ref[i]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("PlanExecuteBatch::MatchesExecute", "[batch]")
+{
+    using splitradixfft::Direction;
+    using splitradixfft::TransformType;
+    requirePlanBatchMatchesExecute<float>(TransformType::COMPLEX,
+                                          Direction::FORWARD);
+    requirePlanBatchMatchesExecute<double>(TransformType::COMPLEX,
+                                           Direction::BACKWARD);
+    requirePlanBatchMatchesExecute<float>(TransformType::REAL,
+                                          Direction::FORWARD);
+    requirePlanBatchMatchesExecute<double>(TransformType::REAL,
+                                           Direction::BACKWARD);
+}
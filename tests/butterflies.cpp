@@ -0,0 +1,78 @@
+#include "reference.hpp"
+#include "splitradixfft.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+TEST_CASE("combineButterfliesFloat::MatchesScalar", "[butterflies]")
+{
+    const std::size_t nfft = 256;
+    auto twiddleFactors = std::make_unique<std::complex<float>[]>(nfft);
+    splitradixfft::internal::populateCfftTwiddles<float>(twiddleFactors.get(),
+                                                         nfft, false);
+
+    for (std::size_t N = 16; N <= nfft; N *= 2) {
+        auto data = reference::randomSequence<float>(N, (unsigned int)N);
+        auto expected = data;
+        std::size_t stride = nfft / N;
+        splitradixfft::internal::combineButterfliesScalar<float, false>(
+            expected.data(), twiddleFactors.get(), stride, N, 0, N / 4);
+        splitradixfft::internal::combineButterflies<float, false>(
+            data.data(), twiddleFactors.get(), stride, N);
+        REQUIRE(reference::maxError(data.data(), expected.data(), N) < 1e-6f);
+    }
+}
+
+TEST_CASE("combineButterfliesDouble::MatchesScalar", "[butterflies]")
+{
+    const std::size_t nfft = 256;
+    auto twiddleFactors = std::make_unique<std::complex<double>[]>(nfft);
+    splitradixfft::internal::populateCfftTwiddles<double>(twiddleFactors.get(),
+                                                          nfft, true);
+
+    for (std::size_t N = 16; N <= nfft; N *= 2) {
+        auto data = reference::randomSequence<double>(N, (unsigned int)N);
+        auto expected = data;
+        std::size_t stride = nfft / N;
+        splitradixfft::internal::combineButterfliesScalar<double, true>(
+            expected.data(), twiddleFactors.get(), stride, N, 0, N / 4);
+        splitradixfft::internal::combineButterflies<double, true>(
+            data.data(), twiddleFactors.get(), stride, N);
+        REQUIRE(reference::maxError(data.data(), expected.data(), N) < 1e-12);
+    }
+}
+
+TEST_CASE("performCfftForwardFloat::LargeSizes", "[butterflies]")
+{
+    for (std::size_t nfft = 16; nfft <= 2048; nfft *= 2) {
+        auto twiddleFactors = std::make_unique<std::complex<float>[]>(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<float>(
+            nfft, twiddleFactors.get(), nfft);
+        auto in = reference::randomSequence<float>(nfft);
+        std::vector<std::complex<float>> out(nfft);
+        auto err = splitradixfft::performCfftForward<float>(
+            nfft, twiddleFactors.get(), nfft, in.data(), nfft, out.data(),
+            nfft);
+        REQUIRE(err == splitradixfft::FFTSTATUS::OK);
+        auto ref = reference::dft(in.data(), nfft, false);
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <
+                1e-5f * (float)nfft);
+    }
+}
+
+TEST_CASE("performCfftBackwardDouble::LargeSizes", "[butterflies]")
+{
+    for (std::size_t nfft = 16; nfft <= 2048; nfft *= 2) {
+        auto twiddleFactors = std::make_unique<std::complex<double>[]>(nfft);
+        splitradixfft::populateCfftTwiddleFactorsBackward<double>(
+            nfft, twiddleFactors.get(), nfft);
+        auto in = reference::randomSequence<double>(nfft);
+        std::vector<std::complex<double>> out(nfft);
+        auto err = splitradixfft::performCfftBackward<double>(
+            nfft, twiddleFactors.get(), nfft, in.data(), nfft, out.data(),
+            nfft);
+        REQUIRE(err == splitradixfft::FFTSTATUS::OK);
+        auto ref = reference::dft(in.data(), nfft, true);
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <
+                1e-12 * (double)nfft);
+    }
+}
@@ -0,0 +1,50 @@
+#include "reference.hpp"
+#include "splitradixfft.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+template <typename T, bool F>
+static void requireMatchesDft(std::size_t N, T tolerance)
+{
+    auto in = reference::randomSequence<T>(N, 11);
+    std::vector<std::complex<T>> out(N);
+    auto load = [&in](std::size_t k) { return in[k]; };
+    switch (N) {
+    case 16:
+        splitradixfft::internal::leaf16<T, F>(out.data(), load);
+        break;
+    case 32:
+        splitradixfft::internal::leaf32<T, F>(out.data(), load);
+        break;
+    }
+    auto ref = reference::dft(in.data(), N, F);
+    REQUIRE(reference::maxError(out.data(), ref.data(), N) < tolerance);
+}
+
+TEST_CASE("codeletsFloat::MatchDft", "[codelets]")
+{
+    for (std::size_t N = 16; N <= 32; N *= 2) {
+        requireMatchesDft<float, false>(N, 1e-5f);
+        requireMatchesDft<float, true>(N, 1e-5f);
+    }
+}
+
+TEST_CASE("codeletsDouble::MatchDft", "[codelets]")
+{
+    for (std::size_t N = 16; N <= 32; N *= 2) {
+        requireMatchesDft<double, false>(N, 1e-13);
+        requireMatchesDft<double, true>(N, 1e-13);
+    }
+}
+
+TEST_CASE("codelets::InPlace", "[codelets]")
+{
+    // All inputs are loaded before the first store, the leaf can overwrite its
+    // own input.
+    auto in = reference::randomSequence<double>(32, 3);
+    std::vector<std::complex<double>> data(in);
+    splitradixfft::internal::leaf32<double, false>(
+        data.data(), [&data](std::size_t k) { return data[k]; });
+    auto ref = reference::dft(in.data(), 32, false);
+    REQUIRE(reference::maxError(data.data(), ref.data(), 32) < 1e-13);
+}
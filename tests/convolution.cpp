@@ -0,0 +1,339 @@
+#include "reference.hpp"
+#include "splitradixfft_convolution.hpp"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+template <typename T>
+static void checkConvolver(std::size_t kernelSize, std::size_t fftSize,
+                           splitradixfft::ConvolutionMethod method,
+                           std::size_t chunk, T tolerance)
+{
+    const auto kernel = reference::randomReal<T>(kernelSize, 3);
+    const auto input = reference::randomReal<T>(5000, 7);
+    splitradixfft::Convolver<T> convolver;
+    REQUIRE(splitradixfft::createConvolver<T>(kernel.data(), kernelSize,
+                                              method, convolver, fftSize) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(convolver.blockSize() ==
+            convolver.fftSize() - kernelSize + 1);
+
+    // In place, in chunks that do not line up with the blocks.
+    std::vector<T> output = input;
+    for (std::size_t begin = 0; begin < output.size(); begin += chunk) {
+        const std::size_t count = std::min(chunk, output.size() - begin);
+        convolver.process(output.data() + begin, output.data() + begin,
+                          count);
+    }
+
+    const std::size_t latency = convolver.latency();
+    for (std::size_t n = 0; n < output.size(); n++) {
+        long double expected = 0;
+        for (std::size_t k = 0; k < kernelSize && k + latency <= n; k++) {
+            expected += (long double)kernel[k] * input[n - latency - k];
+        }
+        REQUIRE(std::fabs(output[n] - (T)expected) < tolerance);
+    }
+}
+
+TEST_CASE("ConvolverDouble::MatchesDirectConvolution", "[convolution]")
+{
+    for (auto method : {splitradixfft::ConvolutionMethod::OVERLAP_SAVE,
+                        splitradixfft::ConvolutionMethod::OVERLAP_ADD}) {
+        checkConvolver<double>(1, 0, method, 1, 1e-12);
+        checkConvolver<double>(7, 0, method, 3, 1e-12);
+        checkConvolver<double>(64, 0, method, 100, 1e-12);
+        checkConvolver<double>(100, 128, method, 17, 1e-12);
+        checkConvolver<double>(300, 0, method, 1000, 1e-12);
+    }
+}
+
+TEST_CASE("ConvolverFloat::MatchesDirectConvolution", "[convolution]")
+{
+    for (auto method : {splitradixfft::ConvolutionMethod::OVERLAP_SAVE,
+                        splitradixfft::ConvolutionMethod::OVERLAP_ADD}) {
+        checkConvolver<float>(33, 0, method, 64, 1e-4f);
+        checkConvolver<float>(250, 256, method, 5, 1e-4f);
+    }
+}
+
+TEST_CASE("Convolver::FftSize", "[convolution]")
+{
+    std::vector<float> kernel(1000, 1.0f);
+    splitradixfft::Convolver<float> convolver;
+    REQUIRE(splitradixfft::createConvolver<float>(kernel.data(), 1,
+                                                  convolver) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(convolver.fftSize() == 8);
+    // The cheapest size keeps the block well above the kernel size.
+    REQUIRE(splitradixfft::createConvolver<float>(kernel.data(), 1000,
+                                                  convolver) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(convolver.fftSize() >= 4096);
+    REQUIRE(convolver.method() ==
+            splitradixfft::ConvolutionMethod::OVERLAP_SAVE);
+}
+
+TEST_CASE("Convolver::Reset", "[convolution]")
+{
+    const auto kernel = reference::randomReal<double>(20, 1);
+    const auto input = reference::randomReal<double>(300, 2);
+    splitradixfft::Convolver<double> convolver;
+    REQUIRE(splitradixfft::createConvolver<double>(
+                kernel.data(), kernel.size(),
+                splitradixfft::ConvolutionMethod::OVERLAP_ADD, convolver) ==
+            splitradixfft::FFTSTATUS::OK);
+    std::vector<double> first(input.size());
+    std::vector<double> second(input.size());
+    convolver.process(input.data(), first.data(), input.size());
+    convolver.reset();
+    convolver.process(input.data(), second.data(), input.size());
+    REQUIRE(first == second);
+}
+
+TEST_CASE("Convolver::InvalidArguments", "[convolution]")
+{
+    std::vector<float> kernel(100);
+    splitradixfft::Convolver<float> convolver;
+    REQUIRE(splitradixfft::createConvolver<float>(kernel.data(), 0,
+                                                  convolver) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createConvolver<float>(nullptr, 100, convolver) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::createConvolver<float>(
+                kernel.data(), 100,
+                splitradixfft::ConvolutionMethod::OVERLAP_SAVE, convolver,
+                64) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createConvolver<float>(
+                kernel.data(), 100,
+                splitradixfft::ConvolutionMethod::OVERLAP_SAVE, convolver,
+                200) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createConvolver<float>(
+                kernel.data(), 3,
+                splitradixfft::ConvolutionMethod::OVERLAP_ADD, convolver,
+                4) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+}
+
+template <typename T>
+static void checkPartitioned(std::size_t responseSize, std::size_t blockSize,
+                             T tolerance)
+{
+    const std::size_t channels = 3;
+    const std::size_t blocks = 40;
+    std::vector<std::vector<T>> responses;
+    std::vector<std::vector<T>> inputs;
+    std::vector<const T*> responsePointers;
+    for (std::size_t c = 0; c < channels; c++) {
+        responses.push_back(
+            reference::randomReal<T>(responseSize, 10 + (unsigned)c));
+        inputs.push_back(
+            reference::randomReal<T>(blocks * blockSize, 20 + (unsigned)c));
+        responsePointers.push_back(responses[c].data());
+    }
+    splitradixfft::PartitionedConvolver<T> serial;
+    splitradixfft::PartitionedConvolver<T> parallel;
+    REQUIRE(splitradixfft::createPartitionedConvolver<T>(
+                responsePointers.data(), responseSize, channels, blockSize,
+                serial) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(splitradixfft::createPartitionedConvolver<T>(
+                responsePointers.data(), responseSize, channels, blockSize,
+                parallel) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(serial.partitions() ==
+            (responseSize + blockSize - 1) / blockSize);
+
+    // The serial convolver runs in place.
+    std::vector<std::vector<T>> outputs = inputs;
+    std::vector<std::vector<T>> parallelOutputs = inputs;
+    splitradixfft::ThreadPool pool(3);
+    for (std::size_t b = 0; b < blocks; b++) {
+        std::vector<const T*> in;
+        std::vector<T*> out;
+        std::vector<T*> parallelOut;
+        for (std::size_t c = 0; c < channels; c++) {
+            in.push_back(outputs[c].data() + b * blockSize);
+            out.push_back(outputs[c].data() + b * blockSize);
+            parallelOut.push_back(parallelOutputs[c].data() + b * blockSize);
+        }
+        parallel.process(parallelOut.data(), parallelOut.data(), pool);
+        serial.process(in.data(), out.data());
+    }
+
+    for (std::size_t c = 0; c < channels; c++) {
+        REQUIRE(parallelOutputs[c] == outputs[c]);
+        for (std::size_t n = 0; n < outputs[c].size(); n++) {
+            long double expected = 0;
+            for (std::size_t k = 0; k < responseSize && k <= n; k++) {
+                expected += (long double)responses[c][k] * inputs[c][n - k];
+            }
+            REQUIRE(std::fabs(outputs[c][n] - (T)expected) < tolerance);
+        }
+    }
+}
+
+TEST_CASE("PartitionedConvolverDouble::MatchesDirectConvolution",
+          "[convolution]")
+{
+    checkPartitioned<double>(1, 4, 1e-12);
+    checkPartitioned<double>(64, 64, 1e-12);
+    checkPartitioned<double>(1000, 64, 1e-11);
+    checkPartitioned<double>(333, 16, 1e-11);
+}
+
+TEST_CASE("PartitionedConvolverFloat::MatchesDirectConvolution",
+          "[convolution]")
+{
+    checkPartitioned<float>(500, 32, 1e-4f);
+}
+
+TEST_CASE("PartitionedConvolver::InvalidArguments", "[convolution]")
+{
+    std::vector<float> response(100);
+    const float* responses[] = {response.data(), nullptr};
+    splitradixfft::PartitionedConvolver<float> convolver;
+    REQUIRE(splitradixfft::createPartitionedConvolver<float>(
+                responses, 100, 1, 48, convolver) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPartitionedConvolver<float>(
+                responses, 100, 1, 2, convolver) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPartitionedConvolver<float>(
+                responses, 0, 1, 64, convolver) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPartitionedConvolver<float>(
+                responses, 100, 2, 64, convolver) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::createPartitionedConvolver<float>(
+                nullptr, 100, 1, 64, convolver) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+}
+
+template <typename T>
+static void checkNonUniform(std::size_t responseSize, std::size_t blockSize,
+                            std::size_t maximumBlockSize, T tolerance)
+{
+    const auto response = reference::randomReal<T>(responseSize, 5);
+    const auto input = reference::randomReal<T>(3000, 6);
+    splitradixfft::ThreadPool pool(3);
+    splitradixfft::NonUniformConvolver<T> serial;
+    splitradixfft::NonUniformConvolver<T> parallel;
+    REQUIRE(splitradixfft::createNonUniformConvolver<T>(
+                response.data(), responseSize, blockSize, serial,
+                maximumBlockSize) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(splitradixfft::createNonUniformConvolver<T>(
+                response.data(), responseSize, blockSize, parallel,
+                maximumBlockSize, &pool) == splitradixfft::FFTSTATUS::OK);
+    for (std::size_t s = 0; s < serial.segments(); s++) {
+        REQUIRE(serial.segmentBlockSize(s) ==
+                std::min(blockSize << (s + 1), serial.maximumBlockSize()));
+    }
+
+    std::vector<T> output = input;
+    std::vector<T> parallelOutput(input.size());
+    for (std::size_t begin = 0; begin + blockSize <= input.size();
+         begin += blockSize) {
+        serial.process(output.data() + begin, output.data() + begin);
+        parallel.process(input.data() + begin, parallelOutput.data() + begin);
+    }
+    const std::size_t processed = input.size() / blockSize * blockSize;
+    for (std::size_t n = 0; n < processed; n++) {
+        long double expected = 0;
+        for (std::size_t k = 0; k < responseSize && k <= n; k++) {
+            expected += (long double)response[k] * input[n - k];
+        }
+        REQUIRE(std::fabs(output[n] - (T)expected) < tolerance);
+        REQUIRE(parallelOutput[n] == output[n]);
+    }
+}
+
+TEST_CASE("NonUniformConvolverDouble::MatchesDirectConvolution",
+          "[convolution]")
+{
+    checkNonUniform<double>(2000, 8, 64, 1e-11);
+    checkNonUniform<double>(1500, 4, 0, 1e-11);
+    checkNonUniform<double>(20, 8, 64, 1e-12);
+    checkNonUniform<double>(100, 16, 16, 1e-12);
+    checkNonUniform<double>(4 * 8 + 2 * 16 + 3, 8, 256, 1e-12);
+}
+
+TEST_CASE("NonUniformConvolverFloat::MatchesDirectConvolution",
+          "[convolution]")
+{
+    checkNonUniform<float>(1000, 16, 128, 1e-4f);
+}
+
+TEST_CASE("NonUniformConvolver::Reset", "[convolution]")
+{
+    const auto response = reference::randomReal<double>(700, 1);
+    const auto input = reference::randomReal<double>(512, 2);
+    splitradixfft::ThreadPool pool(2);
+    splitradixfft::NonUniformConvolver<double> convolver;
+    REQUIRE(splitradixfft::createNonUniformConvolver<double>(
+                response.data(), response.size(), 8, convolver, 0, &pool) ==
+            splitradixfft::FFTSTATUS::OK);
+    std::vector<double> first(input.size());
+    std::vector<double> second(input.size());
+    for (std::size_t begin = 0; begin < input.size(); begin += 8) {
+        convolver.process(input.data() + begin, first.data() + begin);
+    }
+    convolver.reset();
+    for (std::size_t begin = 0; begin < input.size(); begin += 8) {
+        convolver.process(input.data() + begin, second.data() + begin);
+    }
+    REQUIRE(first == second);
+}
+
+TEST_CASE("NonUniformConvolver::NoForeignTasks", "[convolution]")
+{
+    // Waiting for a segment must not run other tasks of the pool on the
+    // thread calling process.
+    const auto response = reference::randomReal<double>(4000, 1);
+    const auto input = reference::randomReal<double>(2048, 2);
+    splitradixfft::ThreadPool pool(2);
+    splitradixfft::NonUniformConvolver<double> convolver;
+    REQUIRE(splitradixfft::createNonUniformConvolver<double>(
+                response.data(), response.size(), 8, convolver, 256, &pool) ==
+            splitradixfft::FFTSTATUS::OK);
+    const auto caller = std::this_thread::get_id();
+    std::atomic<std::size_t> finished{0};
+    std::atomic<bool> ranOnCaller{false};
+    std::vector<double> output(input.size());
+    std::size_t posted = 0;
+    for (std::size_t begin = 0; begin < input.size(); begin += 8) {
+        // The newest task of the queue is a foreign one whenever a segment
+        // has to be waited for.
+        pool.post([&]() {
+            if (std::this_thread::get_id() == caller) {
+                ranOnCaller = true;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+            finished++;
+        });
+        posted++;
+        convolver.process(input.data() + begin, output.data() + begin);
+    }
+    while (finished < posted) {
+        std::this_thread::yield();
+    }
+    REQUIRE(!ranOnCaller);
+}
+
+TEST_CASE("NonUniformConvolver::InvalidArguments", "[convolution]")
+{
+    std::vector<float> response(100);
+    splitradixfft::NonUniformConvolver<float> convolver;
+    REQUIRE(splitradixfft::createNonUniformConvolver<float>(
+                response.data(), 100, 12, convolver) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createNonUniformConvolver<float>(
+                response.data(), 100, 32, convolver, 16) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createNonUniformConvolver<float>(
+                response.data(), 0, 32, convolver) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createNonUniformConvolver<float>(
+                nullptr, 100, 32, convolver) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+}
@@ -0,0 +1,209 @@
+#include "reference.hpp"
+#include "splitradixfft_correlation.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+struct Frames {
+    std::vector<std::vector<double>> data;
+    std::vector<const double*> in;
+    std::vector<std::vector<double>> results;
+    std::vector<double*> out;
+};
+
+static Frames makeFrames(std::size_t frameSize, std::size_t channels,
+                         std::size_t pairs, std::size_t lagCount)
+{
+    Frames frames;
+    for (std::size_t c = 0; c < channels; c++) {
+        frames.data.push_back(
+            reference::randomReal<double>(frameSize, 3 + (unsigned int)c));
+    }
+    for (auto& values : frames.data) {
+        frames.in.push_back(values.data());
+    }
+    frames.results.assign(pairs, std::vector<double>(lagCount));
+    for (auto& values : frames.results) {
+        frames.out.push_back(values.data());
+    }
+    return frames;
+}
+
+TEST_CASE("CrossCorrelatorDouble::MatchesDirectCorrelation", "[correlation]")
+{
+    for (std::size_t frameSize : {1, 7, 64, 100, 300}) {
+        for (std::size_t maxLag : {(std::size_t)0, frameSize / 3,
+                                   frameSize - 1}) {
+            splitradixfft::CrossCorrelator<double> correlator;
+            REQUIRE(splitradixfft::createCrossCorrelator<double>(
+                        frameSize, 4, maxLag,
+                        splitradixfft::CrossWeighting::NONE, correlator) ==
+                    splitradixfft::FFTSTATUS::OK);
+            REQUIRE(correlator.pairs() == 6);
+            REQUIRE(correlator.fftSize() >= frameSize + maxLag);
+            auto frames = makeFrames(frameSize, 4, correlator.pairs(),
+                                     correlator.lagCount());
+            REQUIRE(correlator.process(frames.in.data(), frames.out.data()) ==
+                    splitradixfft::FFTSTATUS::OK);
+
+            for (std::size_t i = 0; i < 4; i++) {
+                for (std::size_t j = i + 1; j < 4; j++) {
+                    const auto& x = frames.data[i];
+                    const auto& y = frames.data[j];
+                    const auto& result =
+                        frames.results[correlator.pair(i, j)];
+                    for (long lag = -(long)maxLag; lag <= (long)maxLag;
+                         lag++) {
+                        long double expected = 0;
+                        for (long n = 0; n < (long)frameSize; n++) {
+                            if (n + lag >= 0 && n + lag < (long)frameSize) {
+                                expected += (long double)x[n] * y[n + lag];
+                            }
+                        }
+                        REQUIRE(std::fabs(result[maxLag + lag] -
+                                          (double)expected) < 1e-11);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("CrossCorrelatorDouble::PhatMatchesReference", "[correlation]")
+{
+    const std::size_t frameSize = 50;
+    const std::size_t maxLag = 20;
+    splitradixfft::CrossCorrelator<double> correlator;
+    REQUIRE(splitradixfft::createCrossCorrelator<double>(
+                frameSize, 3, maxLag, splitradixfft::CrossWeighting::PHAT,
+                correlator) == splitradixfft::FFTSTATUS::OK);
+    const std::size_t nfft = correlator.fftSize();
+    auto frames =
+        makeFrames(frameSize, 3, correlator.pairs(), correlator.lagCount());
+    REQUIRE(correlator.process(frames.in.data(), frames.out.data()) ==
+            splitradixfft::FFTSTATUS::OK);
+
+    // Whitened spectra of the zero padded frames, the full spectrum.
+    std::vector<std::vector<std::complex<double>>> spectra;
+    for (const auto& values : frames.data) {
+        std::vector<std::complex<double>> padded(nfft);
+        for (std::size_t n = 0; n < frameSize; n++) {
+            padded[n] = values[n];
+        }
+        auto spectrum = reference::dft<double>(padded.data(), nfft, false);
+        for (auto& bin : spectrum) {
+            bin /= std::abs(bin);
+        }
+        spectra.push_back(spectrum);
+    }
+    for (std::size_t i = 0; i < 3; i++) {
+        for (std::size_t j = i + 1; j < 3; j++) {
+            std::vector<std::complex<double>> cross(nfft);
+            for (std::size_t k = 0; k < nfft; k++) {
+                cross[k] = std::conj(spectra[i][k]) * spectra[j][k];
+            }
+            auto expected = reference::dft<double>(cross.data(), nfft, true);
+            const auto& result = frames.results[correlator.pair(i, j)];
+            for (long lag = -(long)maxLag; lag <= (long)maxLag; lag++) {
+                const std::size_t index =
+                    (std::size_t)(lag + (long)nfft) % nfft;
+                REQUIRE(std::fabs(result[maxLag + lag] -
+                                  expected[index].real() / (double)nfft) <
+                        1e-12);
+            }
+        }
+    }
+}
+
+TEST_CASE("CrossCorrelatorFloat::PhatFindsDelays", "[correlation]")
+{
+    // Channel c is a delayed copy of a white sequence, channel j then lags
+    // behind channel i by delays[j] - delays[i].
+    const std::size_t frameSize = 1000;
+    const long delays[] = {0, 5, 17, 2};
+    const auto source = reference::randomReal<float>(frameSize + 32, 21);
+    std::vector<std::vector<float>> data(4, std::vector<float>(frameSize));
+    std::vector<const float*> in;
+    for (std::size_t c = 0; c < 4; c++) {
+        for (std::size_t n = 0; n < frameSize; n++) {
+            data[c][n] = source[n + 32 - (std::size_t)delays[c]];
+        }
+        in.push_back(data[c].data());
+    }
+    splitradixfft::CrossCorrelator<float> correlator;
+    REQUIRE(splitradixfft::createCrossCorrelator<float>(
+                frameSize, 4, 24, splitradixfft::CrossWeighting::PHAT,
+                correlator) == splitradixfft::FFTSTATUS::OK);
+    // Frame and lag window fit into 1024 values, all lags would need 2048.
+    REQUIRE(correlator.fftSize() == 1024);
+    std::vector<std::vector<float>> results(
+        correlator.pairs(), std::vector<float>(correlator.lagCount()));
+    std::vector<float*> out;
+    for (auto& values : results) {
+        out.push_back(values.data());
+    }
+    splitradixfft::ThreadPool pool(3);
+    REQUIRE(correlator.process(in.data(), out.data(), pool) ==
+            splitradixfft::FFTSTATUS::OK);
+    for (std::size_t i = 0; i < 4; i++) {
+        for (std::size_t j = i + 1; j < 4; j++) {
+            const auto& result = results[correlator.pair(i, j)];
+            std::size_t peak = 0;
+            for (std::size_t k = 1; k < result.size(); k++) {
+                if (result[k] > result[peak]) {
+                    peak = k;
+                }
+            }
+            REQUIRE((long)peak - 24 == delays[j] - delays[i]);
+            REQUIRE(result[peak] > 0.9f);
+        }
+    }
+}
+
+TEST_CASE("CrossCorrelatorDouble::ThreadedMatchesSerial", "[correlation]")
+{
+    const std::size_t channels = 9;
+    splitradixfft::CrossCorrelator<double> correlator;
+    REQUIRE(splitradixfft::createCrossCorrelator<double>(500, channels,
+                                                         correlator) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(correlator.maxLag() == 499);
+    REQUIRE(correlator.fftSize() == 1024);
+    REQUIRE(correlator.weighting() == splitradixfft::CrossWeighting::PHAT);
+    auto serial = makeFrames(500, channels, correlator.pairs(),
+                             correlator.lagCount());
+    auto threaded = makeFrames(500, channels, correlator.pairs(),
+                               correlator.lagCount());
+    splitradixfft::ThreadPool pool(4);
+    REQUIRE(correlator.process(serial.in.data(), serial.out.data()) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(correlator.process(threaded.in.data(), threaded.out.data(),
+                               pool) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(serial.results == threaded.results);
+}
+
+TEST_CASE("CrossCorrelator::InvalidArguments", "[correlation]")
+{
+    splitradixfft::CrossCorrelator<double> correlator;
+    REQUIRE(splitradixfft::createCrossCorrelator<double>(0, 2, correlator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createCrossCorrelator<double>(64, 1, correlator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createCrossCorrelator<double>(
+                64, 2, 64, splitradixfft::CrossWeighting::NONE, correlator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+
+    REQUIRE(splitradixfft::createCrossCorrelator<double>(64, 2, correlator) ==
+            splitradixfft::FFTSTATUS::OK);
+    std::vector<double> x(64);
+    std::vector<double> result(correlator.lagCount());
+    const double* in[] = {x.data(), nullptr};
+    double* out[] = {result.data()};
+    REQUIRE(correlator.process(in, out) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    in[1] = x.data();
+    double* missing[] = {nullptr};
+    REQUIRE(correlator.process(in, missing) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(correlator.process(in, out) == splitradixfft::FFTSTATUS::OK);
+}
@@ -0,0 +1,131 @@
+#include "reference.hpp"
+#include "splitradixfft_fixed.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
+
+template <typename T, std::size_t N, splitradixfft::Direction D>
+static void requireComplexMatchesCfft(T tolerance)
+{
+    const bool inverse = D == splitradixfft::Direction::BACKWARD;
+    auto in = reference::randomSequence<T>(N, 5);
+    std::vector<std::complex<T>> fixed(N);
+    std::vector<std::complex<T>> runtime(N);
+    splitradixfft::FixedFft<T, N, D>::execute(in.data(), fixed.data());
+
+    auto twiddleFactors = std::make_unique<std::complex<T>[]>(N);
+    splitradixfft::internal::populateCfftTwiddles<T>(twiddleFactors.get(), N,
+                                                     inverse);
+    auto copy = in;
+    if (inverse) {
+        splitradixfft::internal::cfftInverse<T>(copy.data(), runtime.data(),
+                                                twiddleFactors.get(), N);
+    } else {
+        splitradixfft::internal::cfftForward<T>(copy.data(), runtime.data(),
+                                                twiddleFactors.get(), N);
+    }
+    REQUIRE(reference::maxError(fixed.data(), runtime.data(), N) <
+            tolerance * (T)N);
+    auto ref = reference::dft(in.data(), N, inverse);
+    REQUIRE(reference::maxError(fixed.data(), ref.data(), N) <
+            tolerance * (T)N);
+}
+
+TEST_CASE("FixedFftFloat::Complex", "[fixed]")
+{
+    using splitradixfft::Direction;
+    requireComplexMatchesCfft<float, 1, Direction::FORWARD>(1e-6f);
+    requireComplexMatchesCfft<float, 2, Direction::FORWARD>(1e-6f);
+    requireComplexMatchesCfft<float, 4, Direction::BACKWARD>(1e-6f);
+    requireComplexMatchesCfft<float, 16, Direction::FORWARD>(1e-6f);
+    requireComplexMatchesCfft<float, 64, Direction::BACKWARD>(1e-6f);
+    requireComplexMatchesCfft<float, 512, Direction::FORWARD>(1e-6f);
+    requireComplexMatchesCfft<float, 1024, Direction::BACKWARD>(1e-6f);
+}
+
+TEST_CASE("FixedFftDouble::Complex", "[fixed]")
+{
+    using splitradixfft::Direction;
+    requireComplexMatchesCfft<double, 8, Direction::BACKWARD>(1e-14);
+    requireComplexMatchesCfft<double, 32, Direction::FORWARD>(1e-14);
+    requireComplexMatchesCfft<double, 128, Direction::FORWARD>(1e-14);
+    requireComplexMatchesCfft<double, 1024, Direction::FORWARD>(1e-14);
+    requireComplexMatchesCfft<double, 4096, Direction::BACKWARD>(1e-14);
+}
+
+template <typename T, std::size_t N>
+static void requireRealMatchesRfft(T tolerance)
+{
+    using C = std::complex<T>;
+    auto sequence = reference::randomSequence<T>(N, 9);
+    std::vector<T> in(N);
+    std::vector<C> complexIn(N);
+    for (std::size_t i = 0; i < N; i++) {
+        in[i] = sequence[i].real();
+        complexIn[i] = C(in[i], 0);
+    }
+
+    std::vector<C> spectrum(N / 2 + 1);
+    splitradixfft::FixedFft<T, N, splitradixfft::Direction::FORWARD>::execute(
+        in.data(), spectrum.data());
+    auto ref = reference::dft(complexIn.data(), N, false);
+    REQUIRE(reference::maxError(spectrum.data(), ref.data(), N / 2 + 1) <
+            tolerance * (T)N);
+
+    auto twiddleFactors = std::make_unique<C[]>(N);
+    splitradixfft::internal::populateRfftTwiddles<T>(twiddleFactors.get(), N,
+                                                     false);
+    std::vector<C> scratch(N / 2);
+    std::vector<C> runtime(N / 2 + 1);
+    splitradixfft::internal::rfftForward<T>(in.data(), scratch.data(),
+                                            runtime.data(),
+                                            twiddleFactors.get(), N);
+    REQUIRE(reference::maxError(spectrum.data(), runtime.data(), N / 2 + 1) <
+            tolerance * (T)N);
+
+    using Backward = splitradixfft::FixedFft<T, N,
+                                             splitradixfft::Direction::BACKWARD>;
+    std::vector<C> backwardScratch(Backward::realScratchSize());
+    std::vector<T> out(N);
+    const auto unmodified = spectrum;
+    Backward::execute(spectrum.data(), out.data(), backwardScratch.data());
+    REQUIRE(spectrum == unmodified);
+    for (std::size_t i = 0; i < N; i++) {
+        REQUIRE(std::abs(out[i] / (T)N - in[i]) < tolerance * (T)N);
+    }
+}
+
+TEST_CASE("FixedFftFloat::Real", "[fixed]")
+{
+    requireRealMatchesRfft<float, 8>(1e-6f);
+    requireRealMatchesRfft<float, 64>(1e-6f);
+    requireRealMatchesRfft<float, 512>(1e-6f);
+}
+
+TEST_CASE("FixedFftDouble::Real", "[fixed]")
+{
+    requireRealMatchesRfft<double, 16>(1e-14);
+    requireRealMatchesRfft<double, 128>(1e-14);
+    requireRealMatchesRfft<double, 1024>(1e-14);
+}
+
+TEST_CASE("FixedFft::TwiddlesAreConstexpr", "[fixed]")
+{
+    using Twiddles =
+        splitradixfft::internal::FixedCfftTwiddles<double, 1024, false>;
+    static_assert(Twiddles::values.size() == 256, "");
+    static_assert(Twiddles::values[0].real() == 1.0, "");
+    // The octant reduction keeps the symmetric factors exactly symmetric.
+    static_assert(Twiddles::values[128].real() ==
+                      -Twiddles::values[128].imag(),
+                  "");
+    static_assert(Twiddles::values[37].real() ==
+                      -Twiddles::values[256 - 37].imag(),
+                  "");
+    auto exact = std::exp(std::complex<long double>(
+        0, -2 * splitradixfft::internal::constexprPi * 37 / 1024));
+    REQUIRE(std::abs(Twiddles::values[37].real() - (double)exact.real()) <=
+            1e-16);
+    REQUIRE(std::abs(Twiddles::values[37].imag() - (double)exact.imag()) <=
+            1e-16);
+}
@@ -0,0 +1,120 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+TEST_CASE("createPlan::FourStepThreshold", "[four_step]")
+{
+    splitradixfft::Plan<float> plan;
+    REQUIRE(splitradixfft::createPlan<float>(
+                1 << 16, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(!plan.usesFourStep());
+    REQUIRE(splitradixfft::createPlan<float>(
+                1 << 16, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD, plan,
+                1 << 16) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(plan.usesFourStep());
+    // Too small to split into blocks of columns.
+    REQUIRE(splitradixfft::createPlan<float>(
+                1 << 11, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD, plan,
+                0) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(!plan.usesFourStep());
+}
+
+TEST_CASE("createPlanDouble::FourStepMatchesDft", "[four_step]")
+{
+    for (std::size_t nfft : {4096, 8192}) {
+        for (auto direction : {splitradixfft::Direction::FORWARD,
+                               splitradixfft::Direction::BACKWARD}) {
+            splitradixfft::Plan<double> plan;
+            REQUIRE(splitradixfft::createPlan<double>(
+                        nfft, splitradixfft::TransformType::COMPLEX,
+                        direction, plan, 0) == splitradixfft::FFTSTATUS::OK);
+            REQUIRE(plan.usesFourStep());
+            auto in = reference::randomSequence<double>(nfft);
+            std::vector<std::complex<double>> out(nfft);
+            plan.execute(in.data(), out.data());
+            auto ref = reference::dft(
+                in.data(), nfft,
+                direction == splitradixfft::Direction::BACKWARD);
+            REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <
+                    1e-13 * std::sqrt((double)nfft));
+        }
+    }
+}
+
+template <typename T>
+static void checkAgainstRecursion(T tolerance)
+{
+    using C = std::complex<T>;
+    for (std::size_t nfft = 4096; nfft <= ((std::size_t)1 << 18); nfft *= 2) {
+        splitradixfft::Plan<T> fourStep;
+        splitradixfft::Plan<T> recursive;
+        REQUIRE(splitradixfft::createPlan<T>(
+                    nfft, splitradixfft::TransformType::COMPLEX,
+                    splitradixfft::Direction::FORWARD, fourStep,
+                    0) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::createPlan<T>(
+                    nfft, splitradixfft::TransformType::COMPLEX,
+                    splitradixfft::Direction::FORWARD,
+                    recursive) == splitradixfft::FFTSTATUS::OK);
+        auto in = reference::randomSequence<T>(nfft);
+        std::vector<C> out(nfft);
+        std::vector<C> ref(nfft);
+        fourStep.execute(in.data(), out.data());
+        recursive.execute(in.data(), ref.data());
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <
+                tolerance * std::sqrt((T)nfft));
+
+        // The parallel execution splits the blocks of columns, the results
+        // do not change.
+        splitradixfft::ThreadPool pool(4);
+        std::vector<C> parallel(nfft);
+        fourStep.execute(in.data(), parallel.data(), pool, 1);
+        REQUIRE(parallel == out);
+    }
+}
+
+TEST_CASE("createPlanFloat::FourStepMatchesRecursion", "[four_step]")
+{
+    checkAgainstRecursion<float>(2e-5f);
+}
+
+TEST_CASE("createPlanDouble::FourStepMatchesRecursion", "[four_step]")
+{
+    checkAgainstRecursion<double>(1e-13);
+}
+
+TEST_CASE("createPlanDouble::FourStepReal", "[four_step]")
+{
+    using C = std::complex<double>;
+    const std::size_t nfft = (std::size_t)1 << 14;
+    splitradixfft::Plan<double> forward;
+    splitradixfft::Plan<double> backward;
+    REQUIRE(splitradixfft::createPlan<double>(
+                nfft, splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::FORWARD, forward,
+                0) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(splitradixfft::createPlan<double>(
+                nfft, splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::BACKWARD, backward,
+                0) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(forward.usesFourStep());
+    auto values = reference::randomSequence<double>(nfft / 2);
+    std::vector<double> in(nfft);
+    for (std::size_t i = 0; i < nfft / 2; i++) {
+        in[2 * i] = values[i].real();
+        in[2 * i + 1] = values[i].imag();
+    }
+    std::vector<C> spectrum(nfft / 2 + 1);
+    std::vector<double> out(nfft);
+    forward.execute(in.data(), spectrum.data());
+    backward.execute(spectrum.data(), out.data());
+    for (std::size_t i = 0; i < nfft; i++) {
+        REQUIRE(std::abs(out[i] / (double)nfft - in[i]) < 1e-12);
+    }
+}
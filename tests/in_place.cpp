@@ -0,0 +1,109 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+template <typename T>
+static void checkFreeFunctions(T tolerance)
+{
+    using C = std::complex<T>;
+    for (std::size_t nfft = 1; nfft <= ((std::size_t)1 << 16); nfft *= 2) {
+        std::vector<C> forwardTwiddles(nfft);
+        std::vector<C> backwardTwiddles(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<T>(
+            nfft, forwardTwiddles.data(), nfft);
+        splitradixfft::populateCfftTwiddleFactorsBackward<T>(
+            nfft, backwardTwiddles.data(), nfft);
+        auto in = reference::randomSequence<T>(nfft);
+
+        std::vector<C> expected(nfft);
+        std::vector<C> data = in;
+        REQUIRE(splitradixfft::performCfftForward<T>(
+                    nfft, forwardTwiddles.data(), nfft, in.data(), nfft,
+                    expected.data(), nfft) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::performCfftForwardInPlace<T>(
+                    nfft, forwardTwiddles.data(), nfft, data.data(), nfft) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(reference::maxError(data.data(), expected.data(), nfft) <=
+                tolerance * std::sqrt((T)nfft));
+
+        data = in;
+        REQUIRE(splitradixfft::performCfftBackward<T>(
+                    nfft, backwardTwiddles.data(), nfft, in.data(), nfft,
+                    expected.data(), nfft) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::performCfftBackwardInPlace<T>(
+                    nfft, backwardTwiddles.data(), nfft, data.data(), nfft) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(reference::maxError(data.data(), expected.data(), nfft) <=
+                tolerance * std::sqrt((T)nfft));
+    }
+}
+
+TEST_CASE("performCfftInPlaceFloat::MatchesOutOfPlace", "[in_place]")
+{
+    checkFreeFunctions<float>(2e-5f);
+}
+
+TEST_CASE("performCfftInPlaceDouble::MatchesOutOfPlace", "[in_place]")
+{
+    checkFreeFunctions<double>(1e-13);
+}
+
+TEST_CASE("performCfftForwardInPlace::InvalidArguments", "[in_place]")
+{
+    std::vector<std::complex<float>> twiddleFactors(16);
+    std::vector<std::complex<float>> data(16);
+    REQUIRE(splitradixfft::performCfftForwardInPlace<float>(
+                12, twiddleFactors.data(), 12, data.data(), 12) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performCfftForwardInPlace<float>(
+                16, twiddleFactors.data(), 16, data.data(), 8) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performCfftBackwardInPlace<float>(
+                16, twiddleFactors.data(), 8, data.data(), 16) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performCfftForwardInPlace<float>(
+                16, nullptr, 16, data.data(), 16) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::performCfftBackwardInPlace<float>(
+                16, twiddleFactors.data(), 16, nullptr, 16) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+}
+
+template <typename T>
+static void checkPlan(std::size_t nfft, std::size_t fourStepThreshold,
+                      T tolerance)
+{
+    using C = std::complex<T>;
+    for (auto direction : {splitradixfft::Direction::FORWARD,
+                           splitradixfft::Direction::BACKWARD}) {
+        splitradixfft::Plan<T> plan;
+        REQUIRE(splitradixfft::createPlan<T>(
+                    nfft, splitradixfft::TransformType::COMPLEX, direction,
+                    plan,
+                    fourStepThreshold) == splitradixfft::FFTSTATUS::OK);
+        auto data = reference::randomSequence<T>(nfft);
+        std::vector<C> expected(nfft);
+        plan.execute(data.data(), expected.data());
+        plan.executeInPlace(data.data());
+        REQUIRE(reference::maxError(data.data(), expected.data(), nfft) <=
+                tolerance * std::sqrt((T)nfft));
+    }
+}
+
+TEST_CASE("PlanExecuteInPlaceFloat::MatchesExecute", "[in_place]")
+{
+    for (std::size_t nfft = 1; nfft <= ((std::size_t)1 << 14); nfft *= 2) {
+        checkPlan<float>(nfft, SIZE_MAX, 2e-5f);
+    }
+}
+
+TEST_CASE("PlanExecuteInPlaceDouble::FourStep", "[in_place]")
+{
+    // Square and rectangular four-step matrices.
+    for (std::size_t nfft = 4096; nfft <= ((std::size_t)1 << 15); nfft *= 2) {
+        checkPlan<double>(nfft, 0, 1e-13);
+    }
+}
@@ -0,0 +1,210 @@
+#include "reference.hpp"
+#include "splitradixfft_nd.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+template <typename T>
+static std::vector<std::complex<T>> referenceND(std::vector<std::size_t> dims,
+                                                std::vector<std::complex<T>> x,
+                                                bool inverseTransform)
+{
+    // One reference dft per line of every axis.
+    std::size_t total = 1;
+    for (std::size_t n : dims) {
+        total *= n;
+    }
+    std::size_t inner = total;
+    for (std::size_t n : dims) {
+        inner /= n;
+        for (std::size_t o = 0; o < total / (n * inner); o++) {
+            for (std::size_t i = 0; i < inner; i++) {
+                std::vector<std::complex<T>> line(n);
+                const std::size_t base = o * n * inner + i;
+                for (std::size_t k = 0; k < n; k++) {
+                    line[k] = x[base + k * inner];
+                }
+                line = reference::dft<T>(line.data(), n, inverseTransform);
+                for (std::size_t k = 0; k < n; k++) {
+                    x[base + k * inner] = line[k];
+                }
+            }
+        }
+    }
+    return x;
+}
+
+template <typename T>
+static void checkComplex(std::vector<std::size_t> dims, T tolerance)
+{
+    for (auto direction : {splitradixfft::Direction::FORWARD,
+                           splitradixfft::Direction::BACKWARD}) {
+        splitradixfft::PlanND<T> plan;
+        if (dims.size() == 2) {
+            REQUIRE(splitradixfft::createPlan2D<T>(
+                        dims[0], dims[1],
+                        splitradixfft::TransformType::COMPLEX, direction,
+                        plan) == splitradixfft::FFTSTATUS::OK);
+        } else {
+            REQUIRE(splitradixfft::createPlan3D<T>(
+                        dims[0], dims[1], dims[2],
+                        splitradixfft::TransformType::COMPLEX, direction,
+                        plan) == splitradixfft::FFTSTATUS::OK);
+        }
+        REQUIRE(plan.rank() == dims.size());
+        auto in = reference::randomSequence<T>(plan.complexSize());
+        std::vector<std::complex<T>> out(plan.complexSize());
+        plan.execute(in.data(), out.data());
+        auto expected = referenceND<T>(
+            dims, in, direction == splitradixfft::Direction::BACKWARD);
+        REQUIRE(reference::maxError(out.data(), expected.data(), out.size()) <
+                tolerance);
+
+        splitradixfft::ThreadPool pool(4);
+        std::vector<std::complex<T>> parallel(plan.complexSize());
+        plan.execute(in.data(), parallel.data(), pool);
+        REQUIRE(parallel == out);
+    }
+}
+
+TEST_CASE("PlanND::Complex2DMatchesReference", "[nd]")
+{
+    checkComplex<double>({8, 16}, 1e-12);
+    checkComplex<double>({32, 4}, 1e-12);
+    checkComplex<double>({64, 64}, 1e-11);
+    // Tall and narrow, the column tiles hold fewer than a block of columns.
+    checkComplex<double>({1024, 2}, 1e-11);
+    checkComplex<float>({16, 32}, 1e-4f);
+}
+
+TEST_CASE("PlanND::Complex3DMatchesReference", "[nd]")
+{
+    checkComplex<double>({4, 8, 16}, 1e-12);
+    checkComplex<double>({16, 2, 32}, 1e-12);
+    checkComplex<float>({8, 8, 8}, 1e-4f);
+}
+
+template <typename T>
+static void checkReal(std::vector<std::size_t> dims, T tolerance)
+{
+    auto create = [&dims](splitradixfft::TransformType type,
+                          splitradixfft::Direction direction,
+                          splitradixfft::Normalization normalization,
+                          splitradixfft::PlanND<T>& plan) {
+        if (dims.size() == 2) {
+            return splitradixfft::createPlan2D<T>(dims[0], dims[1], type,
+                                                  direction, normalization,
+                                                  plan);
+        }
+        return splitradixfft::createPlan3D<T>(dims[0], dims[1], dims[2], type,
+                                              direction, normalization, plan);
+    };
+    splitradixfft::PlanND<T> forward;
+    splitradixfft::PlanND<T> complexForward;
+    splitradixfft::PlanND<T> backward;
+    REQUIRE(create(splitradixfft::TransformType::REAL,
+                   splitradixfft::Direction::FORWARD,
+                   splitradixfft::Normalization::NONE,
+                   forward) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(create(splitradixfft::TransformType::COMPLEX,
+                   splitradixfft::Direction::FORWARD,
+                   splitradixfft::Normalization::NONE,
+                   complexForward) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(create(splitradixfft::TransformType::REAL,
+                   splitradixfft::Direction::BACKWARD,
+                   splitradixfft::Normalization::BY_SIZE,
+                   backward) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(backward.scratchSize() == backward.complexSize());
+
+    const std::size_t last = dims.back();
+    const std::size_t half = last / 2 + 1;
+    auto sequence = reference::randomSequence<T>(forward.realSize());
+    std::vector<T> in(forward.realSize());
+    std::vector<std::complex<T>> complexIn(forward.realSize());
+    for (std::size_t i = 0; i < in.size(); i++) {
+        in[i] = sequence[i].real();
+        complexIn[i] = std::complex<T>(in[i], 0);
+    }
+
+    // The half-complex spectrum is the first last / 2 + 1 columns of the
+    // complex transform of the same values.
+    std::vector<std::complex<T>> spectrum(forward.complexSize());
+    std::vector<std::complex<T>> full(complexForward.complexSize());
+    forward.execute(in.data(), spectrum.data());
+    complexForward.execute(complexIn.data(), full.data());
+    for (std::size_t r = 0; r < forward.realSize() / last; r++) {
+        REQUIRE(reference::maxError(spectrum.data() + r * half,
+                                    full.data() + r * last,
+                                    half) < tolerance);
+    }
+
+    const auto input = spectrum;
+    std::vector<T> out(backward.realSize());
+    backward.execute(spectrum.data(), out.data());
+    REQUIRE(spectrum == input);
+    for (std::size_t i = 0; i < in.size(); i++) {
+        REQUIRE(std::abs(out[i] - in[i]) < tolerance);
+    }
+
+    splitradixfft::ThreadPool pool(3);
+    std::vector<std::complex<T>> parallelSpectrum(forward.complexSize());
+    forward.execute(in.data(), parallelSpectrum.data(), pool);
+    REQUIRE(parallelSpectrum == spectrum);
+    std::vector<T> parallelOut(backward.realSize());
+    std::vector<std::complex<T>> scratch(backward.scratchSize());
+    backward.execute(spectrum.data(), parallelOut.data(), scratch.data(),
+                     pool);
+    REQUIRE(parallelOut == out);
+}
+
+TEST_CASE("PlanND::Real2DRoundTrip", "[nd]")
+{
+    checkReal<double>({8, 8}, 1e-12);
+    checkReal<double>({16, 64}, 1e-12);
+    checkReal<double>({1, 32}, 1e-12);
+    checkReal<double>({512, 8}, 1e-11);
+    checkReal<float>({32, 16}, 1e-4f);
+}
+
+TEST_CASE("PlanND::Real3DRoundTrip", "[nd]")
+{
+    checkReal<double>({4, 8, 16}, 1e-12);
+    checkReal<float>({8, 4, 8}, 1e-4f);
+}
+
+TEST_CASE("PlanND::LargeParallelMatchesSerial", "[nd]")
+{
+    // Enough blocks of columns and rows to be split over several tasks.
+    splitradixfft::PlanND<float> plan;
+    REQUIRE(splitradixfft::createPlan2D<float>(
+                256, 512, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::OK);
+    auto in = reference::randomSequence<float>(plan.complexSize());
+    std::vector<std::complex<float>> serial(plan.complexSize());
+    std::vector<std::complex<float>> parallel(plan.complexSize());
+    plan.execute(in.data(), serial.data());
+    splitradixfft::ThreadPool pool(4);
+    plan.execute(in.data(), parallel.data(), pool);
+    REQUIRE(parallel == serial);
+}
+
+TEST_CASE("PlanND::InvalidArguments", "[nd]")
+{
+    splitradixfft::PlanND<float> plan;
+    REQUIRE(splitradixfft::createPlan2D<float>(
+                12, 16, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPlan2D<float>(
+                16, 0, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPlan2D<float>(
+                16, 4, splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPlan3D<float>(
+                8, 24, 8, splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::BACKWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+}
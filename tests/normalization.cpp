@@ -0,0 +1,398 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using splitradixfft::Normalization;
+
+template <typename T>
+static T expectedScale(Normalization normalization, std::size_t nfft)
+{
+    switch (normalization) {
+    case Normalization::BY_SIZE:
+        return T(1) / (T)nfft;
+    case Normalization::BY_SQRT_SIZE:
+        return (T)(1.0L / std::sqrt((long double)nfft));
+    case Normalization::CUSTOM:
+        return T(0.25);
+    default:
+        return T(1);
+    }
+}
+
+template <typename T>
+static std::vector<std::complex<T>> scaled(std::vector<std::complex<T>> values,
+                                           T scale)
+{
+    for (auto& value : values) {
+        value *= scale;
+    }
+    return values;
+}
+
+// Scaling in the last combine step rounds differently than scaling the
+// result of the unnormalized transform.
+template <typename T>
+static T tolerance(std::size_t nfft, T scale)
+{
+    return std::numeric_limits<T>::epsilon() * (T)4 * (T)nfft * scale;
+}
+
+static const Normalization normalizations[] = {
+    Normalization::NONE, Normalization::BY_SIZE, Normalization::BY_SQRT_SIZE,
+    Normalization::CUSTOM};
+
+TEST_CASE("performCfftDouble::Normalization", "[normalization]")
+{
+    using C = std::complex<double>;
+    for (std::size_t nfft = 1; nfft <= 2048; nfft *= 2) {
+        std::vector<C> forwardTwiddles(nfft);
+        std::vector<C> backwardTwiddles(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<double>(
+            nfft, forwardTwiddles.data(), nfft);
+        splitradixfft::populateCfftTwiddleFactorsBackward<double>(
+            nfft, backwardTwiddles.data(), nfft);
+        // A const input without a normalization selects the unnormalized
+        // transform.
+        const auto in = reference::randomSequence<double>(nfft);
+        std::vector<C> forward(nfft);
+        std::vector<C> backward(nfft);
+        splitradixfft::performCfftForward<double>(
+            nfft, forwardTwiddles.data(), nfft, in.data(), nfft,
+            forward.data(), nfft);
+        splitradixfft::performCfftBackward<double>(
+            nfft, backwardTwiddles.data(), nfft, in.data(), nfft,
+            backward.data(), nfft);
+
+        for (auto normalization : normalizations) {
+            const double scale = expectedScale<double>(normalization, nfft);
+            const double maxError = tolerance<double>(nfft, scale);
+            std::vector<C> out(nfft);
+            REQUIRE(splitradixfft::performCfftForward<double>(
+                        nfft, forwardTwiddles.data(), nfft, in.data(),
+                        nfft, out.data(), nfft, normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            auto ref = scaled(forward, scale);
+            REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <=
+                    maxError);
+            if (normalization == Normalization::NONE) {
+                REQUIRE(out == forward);
+            }
+
+            REQUIRE(splitradixfft::performCfftBackward<double>(
+                        nfft, backwardTwiddles.data(), nfft, in.data(),
+                        nfft, out.data(), nfft, normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            ref = scaled(backward, scale);
+            REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <=
+                    maxError);
+        }
+    }
+}
+
+TEST_CASE("performCfftDouble::RoundTripBySize", "[normalization]")
+{
+    using C = std::complex<double>;
+    const std::size_t nfft = 1024;
+    std::vector<C> forwardTwiddles(nfft);
+    std::vector<C> backwardTwiddles(nfft);
+    splitradixfft::populateCfftTwiddleFactorsForward<double>(
+        nfft, forwardTwiddles.data(), nfft);
+    splitradixfft::populateCfftTwiddleFactorsBackward<double>(
+        nfft, backwardTwiddles.data(), nfft);
+    const auto in = reference::randomSequence<double>(nfft);
+    std::vector<C> spectrum(nfft);
+    std::vector<C> out(nfft);
+    splitradixfft::performCfftForward<double>(
+        nfft, forwardTwiddles.data(), nfft, in.data(), nfft, spectrum.data(),
+        nfft, Normalization::BY_SQRT_SIZE);
+    splitradixfft::performCfftBackward<double>(
+        nfft, backwardTwiddles.data(), nfft, spectrum.data(), nfft, out.data(),
+        nfft, Normalization::BY_SQRT_SIZE);
+    REQUIRE(reference::maxError(out.data(), in.data(), nfft) < 1e-13);
+}
+
+TEST_CASE("performRfftDouble::Normalization", "[normalization]")
+{
+    using C = std::complex<double>;
+    for (std::size_t nfft = 8; nfft <= 2048; nfft *= 2) {
+        std::vector<C> forwardTwiddles(nfft);
+        std::vector<C> backwardTwiddles(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<double>(
+            nfft, forwardTwiddles.data(), nfft);
+        splitradixfft::populateRfftTwiddleFactorsBackward<double>(
+            nfft, backwardTwiddles.data(), nfft);
+        auto sequence = reference::randomSequence<double>(nfft);
+        std::vector<double> in(nfft);
+        for (std::size_t i = 0; i < nfft; i++) {
+            in[i] = sequence[i].real();
+        }
+        std::vector<C> spectrum(nfft / 2 + 1);
+        splitradixfft::performRfftForward<double>(
+            nfft, forwardTwiddles.data(), nfft, in.data(), nfft,
+            spectrum.data(), nfft / 2 + 1);
+        std::vector<C> scratch0(nfft / 2 + 1);
+        std::vector<C> scratch1(nfft / 2 + 1);
+        std::vector<double> backward(nfft);
+        splitradixfft::performRfftBackward<double>(
+            nfft, backwardTwiddles.data(), nfft, spectrum.data(),
+            nfft / 2 + 1, backward.data(), nfft, scratch0.data(),
+            scratch1.data(), nfft / 2 + 1);
+
+        for (auto normalization : normalizations) {
+            const double scale = expectedScale<double>(normalization, nfft);
+            const double maxError = tolerance<double>(nfft, scale);
+            std::vector<C> out(nfft / 2 + 1);
+            REQUIRE(splitradixfft::performRfftForward<double>(
+                        nfft, forwardTwiddles.data(), nfft, in.data(), nfft,
+                        out.data(), nfft / 2 + 1, normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            auto ref = scaled(spectrum, scale);
+            REQUIRE(reference::maxError(out.data(), ref.data(),
+                                        nfft / 2 + 1) <= maxError);
+            if (normalization == Normalization::NONE) {
+                REQUIRE(out == spectrum);
+            }
+
+            std::vector<double> real(nfft);
+            REQUIRE(splitradixfft::performRfftBackward<double>(
+                        nfft, backwardTwiddles.data(), nfft, spectrum.data(),
+                        nfft / 2 + 1, real.data(), nfft, scratch0.data(),
+                        scratch1.data(), nfft / 2 + 1, normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            for (std::size_t i = 0; i < nfft; i++) {
+                REQUIRE(std::fabs(real[i] - scale * backward[i]) <=
+                        maxError);
+            }
+            if (normalization == Normalization::BY_SIZE) {
+                for (std::size_t i = 0; i < nfft; i++) {
+                    REQUIRE(std::fabs(real[i] - in[i]) < 1e-13);
+                }
+            }
+        }
+    }
+}
+
+template <typename T>
+static void checkComplexPlans(std::size_t nfft, std::size_t fourStepThreshold)
+{
+    using C = std::complex<T>;
+    splitradixfft::ThreadPool pool(3);
+    for (auto direction : {splitradixfft::Direction::FORWARD,
+                           splitradixfft::Direction::BACKWARD}) {
+        splitradixfft::Plan<T> plain;
+        REQUIRE(splitradixfft::createPlan<T>(
+                    nfft, splitradixfft::TransformType::COMPLEX, direction,
+                    plain, fourStepThreshold) == splitradixfft::FFTSTATUS::OK);
+        const auto in = reference::randomSequence<T>(nfft);
+        std::vector<C> unscaled(nfft);
+        plain.execute(in.data(), unscaled.data());
+
+        for (auto normalization : normalizations) {
+            splitradixfft::Plan<T> plan;
+            REQUIRE(splitradixfft::createPlan<T>(
+                        nfft, splitradixfft::TransformType::COMPLEX, direction,
+                        normalization, T(0.25), plan, fourStepThreshold) ==
+                    splitradixfft::FFTSTATUS::OK);
+            const T scale = expectedScale<T>(normalization, nfft);
+            REQUIRE(plan.scale() == scale);
+            const auto ref = scaled(unscaled, scale);
+            const T maxError = tolerance<T>(nfft, scale);
+
+            std::vector<C> out(nfft);
+            plan.execute(in.data(), out.data());
+            REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <=
+                    maxError);
+            if (normalization == Normalization::NONE) {
+                REQUIRE(out == unscaled);
+            }
+
+            std::vector<C> data = in;
+            plan.executeInPlace(data.data());
+            REQUIRE(data == out);
+
+            std::vector<C> parallel(nfft);
+            plan.execute(in.data(), parallel.data(), pool, 64);
+            REQUIRE(parallel == out);
+
+            std::vector<C> batch(2 * nfft);
+            std::vector<C> scratch(plan.batchScratchSize());
+            plan.executeBatch(2, in.data(), 1, 0, batch.data(), 2, 1,
+                              scratch.data());
+            for (std::size_t i = 0; i < nfft; i++) {
+                REQUIRE(batch[2 * i] == out[i]);
+                REQUIRE(batch[2 * i + 1] == out[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("createPlanDouble::NormalizedComplex", "[normalization]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 12); nfft *= 4) {
+        checkComplexPlans<double>(nfft,
+                                  splitradixfft::internal::
+                                      defaultFourStepThreshold<double>());
+    }
+    checkComplexPlans<double>(1 << 13, 1 << 12);
+}
+
+TEST_CASE("createPlanFloat::NormalizedComplex", "[normalization]")
+{
+    checkComplexPlans<float>(32, 1 << 12);
+    checkComplexPlans<float>(1 << 12, 1 << 12);
+}
+
+TEST_CASE("createPlanDouble::NormalizedReal", "[normalization]")
+{
+    using C = std::complex<double>;
+    splitradixfft::ThreadPool pool(3);
+    for (std::size_t nfft = 8; nfft <= (1 << 14); nfft *= 4) {
+        splitradixfft::Plan<double> forward;
+        splitradixfft::Plan<double> backward;
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::FORWARD, Normalization::BY_SIZE,
+                    forward) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::BACKWARD, Normalization::NONE,
+                    backward) == splitradixfft::FFTSTATUS::OK);
+        auto sequence = reference::randomSequence<double>(nfft);
+        std::vector<double> in(nfft);
+        std::vector<C> complexIn(nfft);
+        for (std::size_t i = 0; i < nfft; i++) {
+            in[i] = sequence[i].real();
+            complexIn[i] = in[i];
+        }
+
+        std::vector<C> spectrum(nfft / 2 + 1);
+        forward.execute(in.data(), spectrum.data());
+        auto ref = scaled(reference::dft(complexIn.data(), nfft, false),
+                          1.0 / (double)nfft);
+        REQUIRE(reference::maxError(spectrum.data(), ref.data(),
+                                    nfft / 2 + 1) < 1e-15 * (double)nfft);
+        std::vector<C> parallel(nfft / 2 + 1);
+        forward.execute(in.data(), parallel.data(), pool, 64);
+        REQUIRE(parallel == spectrum);
+
+        // Normalizing the forward transform by nfft makes the unnormalized
+        // backward transform the inverse.
+        std::vector<double> out(nfft);
+        backward.execute(spectrum.data(), out.data());
+        for (std::size_t i = 0; i < nfft; i++) {
+            REQUIRE(std::fabs(out[i] - in[i]) < 1e-13);
+        }
+
+        splitradixfft::Plan<double> custom;
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::BACKWARD, Normalization::CUSTOM,
+                    -3.0, custom) == splitradixfft::FFTSTATUS::OK);
+        std::vector<double> scaledOut(nfft);
+        std::vector<C> scratch(custom.scratchSize());
+        custom.execute(spectrum.data(), scaledOut.data(), scratch.data());
+        std::vector<double> batch(nfft);
+        std::vector<C> batchScratch(custom.batchScratchSize());
+        custom.executeBatch(1, spectrum.data(), 1, 0, batch.data(), 1, 0,
+                            batchScratch.data());
+        REQUIRE(batch == scaledOut);
+        for (std::size_t i = 0; i < nfft; i++) {
+            REQUIRE(std::fabs(scaledOut[i] + 3.0 * in[i]) < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("performCfftDouble::NormalizedInPlaceAndBatch", "[normalization]")
+{
+    using C = std::complex<double>;
+    for (std::size_t nfft = 1; nfft <= 4096; nfft *= 4) {
+        std::vector<C> twiddles(nfft);
+        splitradixfft::populateCfftTwiddleFactorsBackward<double>(
+            nfft, twiddles.data(), nfft);
+        const auto in = reference::randomSequence<double>(nfft);
+        std::vector<C> unscaled(nfft);
+        splitradixfft::performCfftBackward<double>(
+            nfft, twiddles.data(), nfft, in.data(), nfft, unscaled.data(),
+            nfft);
+
+        for (auto normalization : normalizations) {
+            const double scale = expectedScale<double>(normalization, nfft);
+            const double maxError = tolerance<double>(nfft, scale);
+            const auto ref = scaled(unscaled, scale);
+
+            std::vector<C> data = in;
+            REQUIRE(splitradixfft::performCfftBackwardInPlace<double>(
+                        nfft, twiddles.data(), nfft, data.data(), nfft,
+                        normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            REQUIRE(reference::maxError(data.data(), ref.data(), nfft) <=
+                    maxError);
+
+            // Two interleaved output sequences go through scratch.
+            std::vector<C> batch(2 * nfft);
+            std::vector<C> scratch(nfft);
+            REQUIRE(splitradixfft::performCfftBackwardBatch<double>(
+                        nfft, twiddles.data(), nfft, 2, in.data(), 1, 0,
+                        batch.data(), 2, 1, scratch.data(), nfft,
+                        normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            for (std::size_t i = 0; i < nfft; i++) {
+                REQUIRE(std::abs(batch[2 * i] - ref[i]) <= maxError);
+                REQUIRE(batch[2 * i + 1] == batch[2 * i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("performRfftDouble::NormalizedBatch", "[normalization]")
+{
+    using C = std::complex<double>;
+    for (std::size_t nfft = 8; nfft <= 2048; nfft *= 4) {
+        std::vector<C> forwardTwiddles(nfft);
+        std::vector<C> backwardTwiddles(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<double>(
+            nfft, forwardTwiddles.data(), nfft);
+        splitradixfft::populateRfftTwiddleFactorsBackward<double>(
+            nfft, backwardTwiddles.data(), nfft);
+        const auto in = reference::randomReal<double>(nfft);
+        std::vector<C> spectrum(nfft / 2 + 1);
+        splitradixfft::performRfftForward<double>(
+            nfft, forwardTwiddles.data(), nfft, in.data(), nfft,
+            spectrum.data(), nfft / 2 + 1);
+        std::vector<C> scratch0(nfft / 2 + 1);
+        std::vector<C> scratch1(nfft / 2 + 1);
+        std::vector<double> backward(nfft);
+        splitradixfft::performRfftBackward<double>(
+            nfft, backwardTwiddles.data(), nfft, spectrum.data(),
+            nfft / 2 + 1, backward.data(), nfft, scratch0.data(),
+            scratch1.data(), nfft / 2 + 1);
+
+        for (auto normalization : normalizations) {
+            const double scale = expectedScale<double>(normalization, nfft);
+            const double maxError = tolerance<double>(nfft, scale);
+            const auto ref = scaled(spectrum, scale);
+            std::vector<C> out(nfft / 2 + 1);
+            REQUIRE(splitradixfft::performRfftForwardBatch<double>(
+                        nfft, forwardTwiddles.data(), nfft, 1, in.data(), 1, 0,
+                        out.data(), 1, 0, nullptr, 0, normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            REQUIRE(reference::maxError(out.data(), ref.data(),
+                                        nfft / 2 + 1) <= maxError);
+
+            std::vector<double> real(nfft);
+            REQUIRE(splitradixfft::performRfftBackwardBatch<double>(
+                        nfft, backwardTwiddles.data(), nfft, 1,
+                        spectrum.data(), 1, 0, real.data(), 1, 0,
+                        scratch0.data(), scratch1.data(), nfft / 2 + 1,
+                        normalization,
+                        0.25) == splitradixfft::FFTSTATUS::OK);
+            for (std::size_t i = 0; i < nfft; i++) {
+                REQUIRE(std::fabs(real[i] - scale * backward[i]) <=
+                        maxError);
+            }
+        }
+    }
+}
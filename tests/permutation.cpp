@@ -0,0 +1,73 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+struct PermutedSchedule {
+    std::vector<splitradixfft::internal::ScheduleStep> schedule;
+    std::vector<std::uint32_t> permutation;
+
+    explicit PermutedSchedule(std::size_t nfft)
+        : schedule(splitradixfft::internal::scheduleLength(nfft)),
+          permutation(nfft)
+    {
+        splitradixfft::internal::buildSchedule(schedule.data(), 0, 1, nfft, 0);
+        splitradixfft::internal::buildPermutation(
+            schedule.data(), schedule.size(), nfft - 1, permutation.data());
+    }
+};
+
+TEST_CASE("buildPermutation::IsBijection", "[permutation]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 16); nfft *= 2) {
+        PermutedSchedule permuted(nfft);
+        std::vector<bool> seen(nfft, false);
+        for (std::size_t j = 0; j < nfft; j++) {
+            REQUIRE(permuted.permutation[j] < nfft);
+            REQUIRE(!seen[permuted.permutation[j]]);
+            seen[permuted.permutation[j]] = true;
+        }
+    }
+}
+
+TEST_CASE("executePermutedScheduleDouble::MatchesRecursion", "[permutation]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 14); nfft *= 2) {
+        PermutedSchedule permuted(nfft);
+        auto twiddleFactors = std::make_unique<std::complex<double>[]>(nfft);
+        splitradixfft::internal::populateCfftTwiddles<double>(
+            twiddleFactors.get(), nfft, false);
+        auto in = reference::randomSequence<double>(nfft, 3);
+        std::vector<std::complex<double>> recursive(nfft);
+        std::vector<std::complex<double>> out(nfft);
+        splitradixfft::internal::cfftForward<double>(
+            in.data(), recursive.data(), twiddleFactors.get(), nfft);
+        splitradixfft::internal::executePermutedSchedule<double, false>(
+            permuted.schedule.data(), permuted.schedule.size(), in.data(),
+            out.data(), twiddleFactors.get(), permuted.permutation.data(),
+            nfft);
+        REQUIRE(reference::maxError(out.data(), recursive.data(), nfft) <
+                1e-13 * std::sqrt((double)nfft));
+    }
+}
+
+TEST_CASE("permuteInPlaceFloat::MatchesGather", "[permutation]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 16); nfft *= 2) {
+        PermutedSchedule permuted(nfft);
+        auto leaders = splitradixfft::internal::buildPermutationCycles(
+            permuted.permutation.data(), nfft);
+        auto data = reference::randomSequence<float>(nfft, 5);
+        std::vector<std::complex<float>> gathered(nfft);
+        splitradixfft::internal::permuteGather<float>(
+            data.data(), gathered.data(), permuted.permutation.data(), nfft);
+        splitradixfft::internal::permuteInPlace<float>(
+            data.data(), permuted.permutation.data(), leaders.data(),
+            leaders.size());
+        for (std::size_t i = 0; i < nfft; i++) {
+            REQUIRE(data[i] == gathered[i]);
+        }
+    }
+}
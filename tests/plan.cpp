@@ -0,0 +1,187 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
+
+TEST_CASE("createPlanFloat::ComplexForward", "[plan]")
+{
+    for (std::size_t nfft = 1; nfft <= 1024; nfft *= 2) {
+        splitradixfft::Plan<float> plan;
+        auto err = splitradixfft::createPlan<float>(
+            nfft, splitradixfft::TransformType::COMPLEX,
+            splitradixfft::Direction::FORWARD, plan);
+        REQUIRE(err == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(plan.size() == nfft);
+
+        auto in = reference::randomSequence<float>(nfft);
+        std::vector<std::complex<float>> out(nfft);
+        plan.execute(in.data(), out.data());
+        auto ref = reference::dft(in.data(), nfft, false);
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <
+                1e-5f * (float)nfft);
+    }
+}
+
+TEST_CASE("createPlanDouble::ComplexBackward", "[plan]")
+{
+    for (std::size_t nfft = 1; nfft <= 1024; nfft *= 2) {
+        splitradixfft::Plan<double> plan;
+        auto err = splitradixfft::createPlan<double>(
+            nfft, splitradixfft::TransformType::COMPLEX,
+            splitradixfft::Direction::BACKWARD, plan);
+        REQUIRE(err == splitradixfft::FFTSTATUS::OK);
+
+        auto in = reference::randomSequence<double>(nfft);
+        std::vector<std::complex<double>> out(nfft);
+        plan.execute(in.data(), out.data());
+        auto ref = reference::dft(in.data(), nfft, true);
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft) <
+                1e-12 * (double)nfft);
+    }
+}
+
+TEST_CASE("createPlanDouble::RealRoundTrip", "[plan]")
+{
+    for (std::size_t nfft = 8; nfft <= 1024; nfft *= 2) {
+        splitradixfft::Plan<double> forward;
+        splitradixfft::Plan<double> backward;
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::FORWARD,
+                    forward) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::BACKWARD,
+                    backward) == splitradixfft::FFTSTATUS::OK);
+
+        auto sequence = reference::randomSequence<double>(nfft);
+        std::vector<double> in(nfft);
+        std::vector<std::complex<double>> complexIn(nfft);
+        for (std::size_t i = 0; i < nfft; i++) {
+            in[i] = sequence[i].real();
+            complexIn[i] = in[i];
+        }
+
+        std::vector<std::complex<double>> spectrum(nfft / 2 + 1);
+        forward.execute(in.data(), spectrum.data());
+        auto ref = reference::dft(complexIn.data(), nfft, false);
+        REQUIRE(reference::maxError(spectrum.data(), ref.data(),
+                                    nfft / 2 + 1) < 1e-12 * (double)nfft);
+
+        std::vector<double> out(nfft);
+        backward.execute(spectrum.data(), out.data());
+        for (std::size_t i = 0; i < nfft; i++) {
+            REQUIRE(std::fabs(out[i] / (double)nfft - in[i]) < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("createPlanFloat::MatchesRfftForward", "[plan]")
+{
+    const std::size_t nfft = 256;
+    auto twiddleFactors = std::make_unique<std::complex<float>[]>(nfft);
+    splitradixfft::populateRfftTwiddleFactorsForward<float>(
+        nfft, twiddleFactors.get(), nfft);
+    auto scratch = std::make_unique<std::complex<float>[]>(nfft / 2 + 1);
+
+    auto sequence = reference::randomSequence<float>(nfft);
+    std::vector<float> in(nfft);
+    for (std::size_t i = 0; i < nfft; i++) {
+        in[i] = sequence[i].imag();
+    }
+
+    std::vector<std::complex<float>> ref(nfft / 2 + 1);
+    splitradixfft::performRfftForward<float>(
+        nfft, twiddleFactors.get(), nfft, in.data(), nfft, ref.data(),
+        nfft / 2 + 1, scratch.get(), nfft / 2 + 1);
+
+    splitradixfft::Plan<float> plan;
+    splitradixfft::createPlan<float>(nfft, splitradixfft::TransformType::REAL,
+                                     splitradixfft::Direction::FORWARD, plan);
+    std::vector<std::complex<float>> out(nfft / 2 + 1);
+    plan.execute(in.data(), out.data());
+    for (std::size_t i = 0; i < nfft / 2 + 1; i++) {
+        REQUIRE(out[i] == ref[i]);
+    }
+}
+
+TEST_CASE("createPlanFloat::InvalidSize", "[plan]")
+{
+    splitradixfft::Plan<float> plan;
+    REQUIRE(splitradixfft::createPlan<float>(
+                0, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPlan<float>(
+                24, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createPlan<float>(
+                4, splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::BACKWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(plan.size() == 0);
+}
+
+TEST_CASE("createPlanDouble::MatchesCfftForward", "[plan]")
+{
+    // The per level twiddle tables hold the same values as the strided
+    // accesses into the full table, the results are bit-identical.
+    for (std::size_t nfft = 64; nfft <= (1 << 14); nfft *= 4) {
+        auto twiddleFactors = std::make_unique<std::complex<double>[]>(nfft);
+        splitradixfft::populateCfftTwiddleFactorsBackward<double>(
+            nfft, twiddleFactors.get(), nfft);
+        auto in = reference::randomSequence<double>(nfft);
+        std::vector<std::complex<double>> ref(nfft);
+        splitradixfft::internal::cfftInverse<double>(
+            in.data(), ref.data(), twiddleFactors.get(), nfft);
+
+        splitradixfft::Plan<double> plan;
+        splitradixfft::createPlan<double>(
+            nfft, splitradixfft::TransformType::COMPLEX,
+            splitradixfft::Direction::BACKWARD, plan);
+        std::vector<std::complex<double>> out(nfft);
+        plan.execute(in.data(), out.data());
+        for (std::size_t i = 0; i < nfft; i++) {
+            REQUIRE(out[i] == ref[i]);
+        }
+    }
+}
+
+TEST_CASE("createPlanDouble::RealForwardWithoutScratch", "[plan]")
+{
+    using C = std::complex<double>;
+    splitradixfft::ThreadPool pool(3);
+    for (std::size_t nfft = 8; nfft <= (1 << 14); nfft *= 4) {
+        splitradixfft::Plan<double> plan;
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::FORWARD,
+                    plan) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(plan.scratchSize() == 0);
+        auto sequence = reference::randomSequence<double>(nfft);
+        std::vector<double> in(nfft);
+        for (std::size_t i = 0; i < nfft; i++) {
+            in[i] = sequence[i].real();
+        }
+
+        std::vector<C> twiddleFactors(nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<double>(
+            nfft, twiddleFactors.data(), nfft);
+        std::vector<C> ref(nfft / 2 + 1);
+        splitradixfft::performRfftForward<double>(
+            nfft, twiddleFactors.data(), nfft, in.data(), nfft, ref.data(),
+            nfft / 2 + 1);
+
+        const splitradixfft::Plan<double>& shared = plan;
+        std::vector<C> out(nfft / 2 + 1);
+        shared.execute(in.data(), out.data());
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft / 2 + 1) <
+                1e-13 * (double)nfft);
+
+        std::vector<C> parallel(nfft / 2 + 1);
+        shared.execute(in.data(), parallel.data(), pool, 1);
+        REQUIRE(parallel == out);
+    }
+}
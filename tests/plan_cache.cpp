@@ -0,0 +1,238 @@
+#include "reference.hpp"
+#include "splitradixfft_plan_cache.hpp"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+TEST_CASE("acquirePlanFloat::SharedPerKey", "[plancache]")
+{
+    std::shared_ptr<const splitradixfft::Plan<float>> first;
+    std::shared_ptr<const splitradixfft::Plan<float>> second;
+    std::shared_ptr<const splitradixfft::Plan<float>> backward;
+    REQUIRE(splitradixfft::acquirePlan<float>(
+                512, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                first) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(splitradixfft::acquirePlan<float>(
+                512, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD,
+                second) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(splitradixfft::acquirePlan<float>(
+                512, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::BACKWARD,
+                backward) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(first == second);
+    REQUIRE(first != backward);
+    REQUIRE(backward->direction() == splitradixfft::Direction::BACKWARD);
+}
+
+TEST_CASE("acquirePlanDouble::InvalidSize", "[plancache]")
+{
+    std::shared_ptr<const splitradixfft::Plan<double>> plan;
+    REQUIRE(splitradixfft::acquirePlan<double>(
+                100, splitradixfft::TransformType::REAL,
+                splitradixfft::Direction::FORWARD,
+                plan) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(plan == nullptr);
+}
+
+TEST_CASE("planCacheDouble::RealWithScratch", "[plancache]")
+{
+    splitradixfft::PlanCache cache;
+    const std::size_t nfft = 64;
+    std::shared_ptr<const splitradixfft::Plan<double>> forward;
+    std::shared_ptr<const splitradixfft::Plan<double>> backward;
+    REQUIRE(cache.acquire<double>(nfft, splitradixfft::TransformType::REAL,
+                                  splitradixfft::Direction::FORWARD,
+                                  forward) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(cache.acquire<double>(nfft, splitradixfft::TransformType::REAL,
+                                  splitradixfft::Direction::BACKWARD,
+                                  backward) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(cache.size() == 2);
+
+    auto sequence = reference::randomSequence<double>(nfft);
+    std::vector<double> in(nfft);
+    for (std::size_t i = 0; i < nfft; i++) {
+        in[i] = sequence[i].real();
+    }
+    std::vector<std::complex<double>> scratch(
+        std::max(forward->scratchSize(), backward->scratchSize()));
+    std::vector<std::complex<double>> spectrum(nfft / 2 + 1);
+    std::vector<double> out(nfft);
+    forward->execute(in.data(), spectrum.data(), scratch.data());
+    backward->execute(spectrum.data(), out.data(), scratch.data());
+    for (std::size_t i = 0; i < nfft; i++) {
+        REQUIRE(std::fabs(out[i] / (double)nfft - in[i]) < 1e-12);
+    }
+}
+
+TEST_CASE("planCacheFloat::EvictsLeastRecentlyUsed", "[plancache]")
+{
+    splitradixfft::PlanCache cache;
+    std::shared_ptr<const splitradixfft::Plan<float>> small;
+    std::shared_ptr<const splitradixfft::Plan<float>> large;
+    cache.acquire<float>(64, splitradixfft::TransformType::COMPLEX,
+                         splitradixfft::Direction::FORWARD, small);
+    cache.acquire<float>(4096, splitradixfft::TransformType::COMPLEX,
+                         splitradixfft::Direction::FORWARD, large);
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.memoryUsage() ==
+            small->memoryFootprint() + large->memoryFootprint());
+
+    cache.setCapacity(large->memoryFootprint());
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.memoryUsage() == large->memoryFootprint());
+
+    // The evicted plan is still valid for its owner and is rebuilt on demand.
+    std::shared_ptr<const splitradixfft::Plan<float>> rebuilt;
+    cache.acquire<float>(64, splitradixfft::TransformType::COMPLEX,
+                         splitradixfft::Direction::FORWARD, rebuilt);
+    REQUIRE(rebuilt != small);
+    REQUIRE(small->size() == 64);
+    REQUIRE(cache.size() == 1);
+
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.memoryUsage() == 0);
+}
+
+TEST_CASE("planCacheFloat::ConcurrentAcquire", "[plancache]")
+{
+    splitradixfft::PlanCache cache;
+    const std::size_t threads = 8;
+    std::vector<std::shared_ptr<const splitradixfft::Plan<float>>> plans(
+        threads);
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&cache, &plans, t]() {
+            for (int repeat = 0; repeat < 100; repeat++) {
+                cache.acquire<float>(1024,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::FORWARD,
+                                     plans[t]);
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    REQUIRE(cache.size() == 1);
+    for (std::size_t t = 1; t < threads; t++) {
+        REQUIRE(plans[t] == plans[0]);
+    }
+}
+
+TEST_CASE("planCacheDouble::ConcurrentMissesBuildOnce", "[plancache]")
+{
+    // Threads missing the same cold key at once wait for one build.
+    splitradixfft::PlanCache cache;
+    const std::size_t threads = 16;
+    std::vector<std::shared_ptr<const splitradixfft::Plan<double>>> plans(
+        threads);
+    std::vector<splitradixfft::FFTSTATUS> status(threads);
+    std::atomic<bool> start{false};
+    std::vector<std::thread> workers;
+    for (std::size_t t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            while (!start.load()) {
+                std::this_thread::yield();
+            }
+            status[t] = cache.acquire<double>(
+                (std::size_t)1 << 18, splitradixfft::TransformType::COMPLEX,
+                splitradixfft::Direction::FORWARD, plans[t]);
+        });
+    }
+    start = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    REQUIRE(cache.builds() == 1);
+    REQUIRE(cache.size() == 1);
+    for (std::size_t t = 0; t < threads; t++) {
+        REQUIRE(status[t] == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(plans[t] == plans[0]);
+    }
+
+    // A failed build is not cached, every miss retries it.
+    std::shared_ptr<const splitradixfft::Plan<double>> invalid;
+    REQUIRE(cache.acquire<double>(100, splitradixfft::TransformType::COMPLEX,
+                                  splitradixfft::Direction::FORWARD,
+                                  invalid) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(cache.acquire<double>(100, splitradixfft::TransformType::COMPLEX,
+                                  splitradixfft::Direction::FORWARD,
+                                  invalid) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(cache.builds() == 3);
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("planCacheFloat::ReleasesDroppedPlans", "[plancache]")
+{
+    // The thread local lookup must not keep plans alive once the cache
+    // dropped them, neither after clear() nor after the cache is destroyed.
+    std::weak_ptr<const splitradixfft::Plan<float>> cleared;
+    std::weak_ptr<const splitradixfft::Plan<float>> destroyed;
+    splitradixfft::PlanCache cache;
+    {
+        std::shared_ptr<const splitradixfft::Plan<float>> plan;
+        REQUIRE(cache.acquire<float>(256,
+                                     splitradixfft::TransformType::COMPLEX,
+                                     splitradixfft::Direction::FORWARD,
+                                     plan) == splitradixfft::FFTSTATUS::OK);
+        cleared = plan;
+    }
+    REQUIRE(!cleared.expired());
+    cache.clear();
+    REQUIRE(cleared.expired());
+
+    {
+        splitradixfft::PlanCache scoped;
+        std::shared_ptr<const splitradixfft::Plan<float>> plan;
+        REQUIRE(scoped.acquire<float>(256,
+                                      splitradixfft::TransformType::COMPLEX,
+                                      splitradixfft::Direction::FORWARD,
+                                      plan) == splitradixfft::FFTSTATUS::OK);
+        destroyed = plan;
+    }
+    REQUIRE(destroyed.expired());
+
+    // A miss after the clear rebuilds the plan.
+    std::shared_ptr<const splitradixfft::Plan<float>> rebuilt;
+    REQUIRE(cache.acquire<float>(256, splitradixfft::TransformType::COMPLEX,
+                                 splitradixfft::Direction::FORWARD,
+                                 rebuilt) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(rebuilt->size() == 256);
+    REQUIRE(cache.size() == 1);
+}
+
+TEST_CASE("planCacheFloat::NormalizedPlans", "[plancache]")
+{
+    splitradixfft::PlanCache cache;
+    std::shared_ptr<const splitradixfft::Plan<float>> plain;
+    std::shared_ptr<const splitradixfft::Plan<float>> bySize;
+    std::shared_ptr<const splitradixfft::Plan<float>> custom;
+    std::shared_ptr<const splitradixfft::Plan<float>> again;
+    REQUIRE(cache.acquire<float>(256, splitradixfft::TransformType::COMPLEX,
+                                 splitradixfft::Direction::FORWARD,
+                                 plain) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(cache.acquire<float>(256, splitradixfft::TransformType::COMPLEX,
+                                 splitradixfft::Direction::FORWARD,
+                                 splitradixfft::Normalization::BY_SIZE,
+                                 bySize) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(cache.acquire<float>(256, splitradixfft::TransformType::COMPLEX,
+                                 splitradixfft::Direction::FORWARD,
+                                 splitradixfft::Normalization::CUSTOM, 0.25f,
+                                 custom) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(cache.acquire<float>(256, splitradixfft::TransformType::COMPLEX,
+                                 splitradixfft::Direction::FORWARD,
+                                 splitradixfft::Normalization::NONE, 0.25f,
+                                 again) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(plain->scale() == 1.0f);
+    REQUIRE(bySize->scale() == 1.0f / 256.0f);
+    REQUIRE(custom->scale() == 0.25f);
+    // The custom scale only distinguishes CUSTOM plans.
+    REQUIRE(again == plain);
+    REQUIRE(cache.size() == 3);
+}
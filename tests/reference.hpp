@@ -0,0 +1,74 @@
+#pragma once
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// Reference implementations used to validate the transforms for sizes that
+// are too large to list the expected values in the test source.
+namespace reference {
+
+template <typename T>
+std::vector<std::complex<T>> dft(const std::complex<T>* in, std::size_t nfft,
+                                 bool inverseTransform)
+{
+    using L = long double;
+    const L pi{std::acos((L)-1)};
+    const L sign{inverseTransform ? (L)1 : (L)-1};
+    std::vector<std::complex<T>> out(nfft);
+    for (std::size_t k = 0; k < nfft; k++) {
+        std::complex<L> acc{0, 0};
+        for (std::size_t n = 0; n < nfft; n++) {
+            // Reduce the product first to keep the angle accurate.
+            L angle = sign * (L)2 * pi * (L)((k * n) % nfft) / (L)nfft;
+            acc += std::complex<L>(in[n].real(), in[n].imag()) *
+                   std::complex<L>(std::cos(angle), std::sin(angle));
+        }
+        out[k] = std::complex<T>((T)acc.real(), (T)acc.imag());
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<std::complex<T>> randomSequence(std::size_t size,
+                                            unsigned int seed = 1)
+{
+    // Small deterministic generator, the tests do not need std::random.
+    std::vector<std::complex<T>> out(size);
+    unsigned long state = seed;
+    auto next = [&state]() {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        return (T)((state >> 33) % 20001) / (T)10000 - (T)1;
+    };
+    for (std::size_t i = 0; i < size; i++) {
+        T re = next();
+        out[i] = std::complex<T>(re, next());
+    }
+    return out;
+}
+
+template <typename T>
+std::vector<T> randomReal(std::size_t size, unsigned int seed = 1)
+{
+    // The real parts of randomSequence.
+    auto sequence = randomSequence<T>(size, seed);
+    std::vector<T> out(size);
+    for (std::size_t i = 0; i < size; i++) {
+        out[i] = sequence[i].real();
+    }
+    return out;
+}
+
+template <typename T>
+T maxError(const std::complex<T>* a, const std::complex<T>* b,
+           std::size_t size)
+{
+    T err{0};
+    for (std::size_t i = 0; i < size; i++) {
+        err = std::max(err, std::abs(a[i] - b[i]));
+    }
+    return err;
+}
+
+} // namespace reference
@@ -1,6 +1,7 @@
 #include "splitradixfft.hpp"
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
+#include <vector>
 
 TEST_CASE("performRfftBackwardFloat::Valid", "[forward]")
 {
@@ -134,6 +135,29 @@ TEST_CASE("performRfftBackwardFloat::InvalidOutputSize", "[forward]")
     REQUIRE(err == splitradixfft::FFTSTATUS::INVALID_SIZE);
 }
 
+TEST_CASE("performRfftBackwardFloat::InvalidSize", "[forward]")
+{
+    // The unscramble step needs nfft / 8 >= 1.
+    const std::size_t nfft = 4;
+    std::vector<std::complex<float>> twiddleFactors(nfft);
+    std::vector<std::complex<float>> in(nfft / 2 + 1);
+    std::vector<float> out(nfft);
+    std::vector<std::complex<float>> scratch0(nfft / 2 + 1);
+    std::vector<std::complex<float>> scratch1(nfft / 2 + 1);
+    REQUIRE(splitradixfft::performRfftBackward<float>(
+                nfft, twiddleFactors.data(), nfft, in.data(), nfft / 2 + 1,
+                out.data(), nfft, scratch0.data(), scratch1.data(),
+                nfft / 2 + 1) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftBackwardWithInputAsScratch<float>(
+                nfft, twiddleFactors.data(), nfft, in.data(), nfft / 2 + 1,
+                out.data(), nfft, scratch0.data(),
+                nfft / 2 + 1) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftBackward<float>(
+                12, twiddleFactors.data(), 12, in.data(), 7, out.data(), 12,
+                scratch0.data(), scratch1.data(),
+                7) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+}
+
 TEST_CASE("performRfftBackwardFloat::NullTwiddle", "[forward]")
 {
     splitradixfft::FFTSTATUS err;
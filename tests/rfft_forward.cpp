@@ -1,6 +1,8 @@
+#include "reference.hpp"
 #include "splitradixfft.hpp"
 #include <catch2/catch_test_macros.hpp>
 #include <memory>
+#include <vector>
 
 TEST_CASE("performRfftForwardFloat::Valid", "[forward]")
 {
@@ -408,3 +410,75 @@ TEST_CASE("performRfftForwardDouble::NullOutput", "[forward]")
                                           scratch.get(), scratchSize);
     REQUIRE(err == splitradixfft::FFTSTATUS::NULL_POINTER);
 }
+
+TEST_CASE("performRfftForwardDouble::WithoutScratch", "[forward]")
+{
+    using C = std::complex<double>;
+    for (std::size_t nfft = 8; nfft <= 4096; nfft *= 2) {
+        std::vector<C> twiddleFactors(nfft);
+        REQUIRE(splitradixfft::populateRfftTwiddleFactorsForward<double>(
+                    nfft, twiddleFactors.data(), nfft) ==
+                splitradixfft::FFTSTATUS::OK);
+        auto sequence = reference::randomSequence<double>(nfft);
+        std::vector<double> in(nfft);
+        std::vector<C> complexIn(nfft);
+        for (std::size_t i = 0; i < nfft; i++) {
+            in[i] = sequence[i].real();
+            complexIn[i] = in[i];
+        }
+        const auto unmodified = in;
+
+        std::vector<C> out(nfft / 2 + 1);
+        REQUIRE(splitradixfft::performRfftForward<double>(
+                    nfft, twiddleFactors.data(), nfft, in.data(), nfft,
+                    out.data(), nfft / 2 + 1) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(in == unmodified);
+        auto ref = reference::dft(complexIn.data(), nfft, false);
+        REQUIRE(reference::maxError(out.data(), ref.data(), nfft / 2 + 1) <
+                1e-13 * (double)nfft);
+
+        std::vector<C> scratch(nfft / 2 + 1);
+        std::vector<C> withScratch(nfft / 2 + 1);
+        REQUIRE(splitradixfft::performRfftForward<double>(
+                    nfft, twiddleFactors.data(), nfft, in.data(), nfft,
+                    withScratch.data(), nfft / 2 + 1, scratch.data(),
+                    nfft / 2 + 1) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(withScratch == out);
+    }
+}
+
+TEST_CASE("performRfftForwardFloat::WithoutScratchInvalidArguments",
+          "[forward]")
+{
+    const std::size_t nfft = 16;
+    std::vector<std::complex<float>> twiddleFactors(nfft);
+    std::vector<float> in(nfft);
+    std::vector<std::complex<float>> out(nfft / 2 + 1);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft - 1, twiddleFactors.data(), nfft - 1, in.data(), nfft - 1,
+                out.data(), nfft / 2) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft, twiddleFactors.data(), nfft - 1, in.data(), nfft,
+                out.data(), nfft / 2 + 1) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft, twiddleFactors.data(), nfft, in.data(), nfft - 1,
+                out.data(), nfft / 2 + 1) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft, twiddleFactors.data(), nfft, in.data(), nfft, out.data(),
+                nfft / 2) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                4, twiddleFactors.data(), 4, in.data(), 4, out.data(), 3) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft, (const std::complex<float>*)nullptr, nfft, in.data(),
+                nfft, out.data(), nfft / 2 + 1) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft, twiddleFactors.data(), nfft, nullptr, nfft, out.data(),
+                nfft / 2 + 1) == splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::performRfftForward<float>(
+                nfft, twiddleFactors.data(), nfft, in.data(), nfft, nullptr,
+                nfft / 2 + 1) == splitradixfft::FFTSTATUS::NULL_POINTER);
+}
@@ -0,0 +1,111 @@
+#include "reference.hpp"
+#include "splitradixfft.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+template <typename T>
+static void checkPair(T tolerance)
+{
+    using C = std::complex<T>;
+    for (std::size_t nfft = 8; nfft <= 4096; nfft *= 2) {
+        std::vector<C> cfftForward(nfft);
+        std::vector<C> cfftBackward(nfft);
+        std::vector<C> rfftTwiddles(nfft);
+        splitradixfft::populateCfftTwiddleFactorsForward<T>(
+            nfft, cfftForward.data(), nfft);
+        splitradixfft::populateCfftTwiddleFactorsBackward<T>(
+            nfft, cfftBackward.data(), nfft);
+        splitradixfft::populateRfftTwiddleFactorsForward<T>(
+            nfft, rfftTwiddles.data(), nfft);
+        auto sequence = reference::randomSequence<T>(nfft);
+        std::vector<T> a(nfft);
+        std::vector<T> b(nfft);
+        for (std::size_t i = 0; i < nfft; i++) {
+            a[i] = sequence[i].real();
+            b[i] = sequence[i].imag();
+        }
+
+        std::vector<C> refA(nfft / 2 + 1);
+        std::vector<C> refB(nfft / 2 + 1);
+        splitradixfft::performRfftForward<T>(nfft, rfftTwiddles.data(), nfft,
+                                             a.data(), nfft, refA.data(),
+                                             nfft / 2 + 1);
+        splitradixfft::performRfftForward<T>(nfft, rfftTwiddles.data(), nfft,
+                                             b.data(), nfft, refB.data(),
+                                             nfft / 2 + 1);
+
+        std::vector<C> spectrumA(nfft / 2 + 1);
+        std::vector<C> spectrumB(nfft / 2 + 1);
+        std::vector<C> scratch(nfft);
+        REQUIRE(splitradixfft::performRfftPairForward<T>(
+                    nfft, cfftForward.data(), nfft, a.data(), b.data(), nfft,
+                    spectrumA.data(), spectrumB.data(), nfft / 2 + 1,
+                    scratch.data(), nfft) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(reference::maxError(spectrumA.data(), refA.data(),
+                                    nfft / 2 + 1) < tolerance * (T)nfft);
+        REQUIRE(reference::maxError(spectrumB.data(), refB.data(),
+                                    nfft / 2 + 1) < tolerance * (T)nfft);
+        REQUIRE(spectrumA[0].imag() == 0);
+        REQUIRE(spectrumB[nfft / 2].imag() == 0);
+
+        std::vector<T> outA(nfft);
+        std::vector<T> outB(nfft);
+        REQUIRE(splitradixfft::performRfftPairBackward<T>(
+                    nfft, cfftBackward.data(), nfft, spectrumA.data(),
+                    spectrumB.data(), nfft / 2 + 1, outA.data(), outB.data(),
+                    nfft, scratch.data(), nfft,
+                    splitradixfft::Normalization::BY_SIZE) ==
+                splitradixfft::FFTSTATUS::OK);
+        for (std::size_t i = 0; i < nfft; i++) {
+            REQUIRE(std::fabs(outA[i] - a[i]) < tolerance * (T)nfft);
+            REQUIRE(std::fabs(outB[i] - b[i]) < tolerance * (T)nfft);
+        }
+    }
+}
+
+TEST_CASE("performRfftPairFloat::MatchesRfft", "[rfft_pair]")
+{
+    checkPair<float>(1e-6f);
+}
+
+TEST_CASE("performRfftPairDouble::MatchesRfft", "[rfft_pair]")
+{
+    checkPair<double>(1e-14);
+}
+
+TEST_CASE("performRfftPairFloat::InvalidArguments", "[rfft_pair]")
+{
+    using C = std::complex<float>;
+    const std::size_t nfft = 16;
+    std::vector<C> twiddleFactors(nfft);
+    std::vector<float> a(nfft);
+    std::vector<float> b(nfft);
+    std::vector<C> outA(nfft / 2 + 1);
+    std::vector<C> outB(nfft / 2 + 1);
+    std::vector<C> scratch(nfft);
+    REQUIRE(splitradixfft::performRfftPairForward<float>(
+                12, twiddleFactors.data(), 12, a.data(), b.data(), 12,
+                outA.data(), outB.data(), 7, scratch.data(), 12) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftPairForward<float>(
+                nfft, twiddleFactors.data(), nfft, a.data(), b.data(), nfft,
+                outA.data(), outB.data(), nfft / 2, scratch.data(), nfft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftPairForward<float>(
+                nfft, twiddleFactors.data(), nfft, a.data(), b.data(), nfft,
+                outA.data(), outB.data(), nfft / 2 + 1, scratch.data(),
+                nfft / 2 + 1) == splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftPairForward<float>(
+                nfft, twiddleFactors.data(), nfft, a.data(), nullptr, nfft,
+                outA.data(), outB.data(), nfft / 2 + 1, scratch.data(),
+                nfft) == splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::performRfftPairBackward<float>(
+                nfft, twiddleFactors.data(), nfft, outA.data(), outB.data(),
+                nfft, a.data(), b.data(), nfft, scratch.data(), nfft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::performRfftPairBackward<float>(
+                nfft, twiddleFactors.data(), nfft, outA.data(), outB.data(),
+                nfft / 2 + 1, a.data(), b.data(), nfft, nullptr, nfft) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+}
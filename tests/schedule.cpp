@@ -0,0 +1,55 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <vector>
+
+template <typename T, bool F>
+static void requireBitCompatible(std::size_t nfft)
+{
+    auto twiddleFactors = std::make_unique<std::complex<T>[]>(nfft);
+    splitradixfft::internal::populateCfftTwiddles<T>(twiddleFactors.get(),
+                                                     nfft, F);
+    std::vector<splitradixfft::internal::ScheduleStep> schedule(
+        splitradixfft::internal::scheduleLength(nfft));
+    REQUIRE(splitradixfft::internal::buildSchedule(schedule.data(), 0, 1,
+                                                   nfft, 0) == schedule.size());
+
+    auto in = reference::randomSequence<T>(nfft, 7);
+    std::vector<std::complex<T>> recursive(nfft);
+    std::vector<std::complex<T>> scheduled(nfft);
+    splitradixfft::internal::transformRecursion<T, F>(
+        in.data(), recursive.data(), twiddleFactors.get(), 0, 1, nfft,
+        nfft - 1);
+    splitradixfft::internal::executeSchedule<T, F>(
+        schedule.data(), schedule.size(), in.data(), scheduled.data(),
+        twiddleFactors.get(), nfft - 1);
+    for (std::size_t i = 0; i < nfft; i++) {
+        REQUIRE(recursive[i] == scheduled[i]);
+    }
+}
+
+TEST_CASE("executeScheduleFloat::BitCompatible", "[schedule]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 14); nfft *= 2) {
+        requireBitCompatible<float, false>(nfft);
+        requireBitCompatible<float, true>(nfft);
+    }
+}
+
+TEST_CASE("executeScheduleDouble::BitCompatible", "[schedule]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 14); nfft *= 2) {
+        requireBitCompatible<double, false>(nfft);
+        requireBitCompatible<double, true>(nfft);
+    }
+}
+
+TEST_CASE("scheduleLength::CountsNodes", "[schedule]")
+{
+    REQUIRE(splitradixfft::internal::scheduleLength(32) == 1);
+    // 64 = 32 + 16 + 16 and one combine.
+    REQUIRE(splitradixfft::internal::scheduleLength(64) == 4);
+    // 128 = (32 + 16 + 16 + combine) + 32 + 32 and one combine.
+    REQUIRE(splitradixfft::internal::scheduleLength(128) == 7);
+}
@@ -0,0 +1,200 @@
+#include "reference.hpp"
+#include "splitradixfft_spectral.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+// Sizes around the vector widths, with and without scalar tails, and the
+// half-spectrum of a 64-point transform.
+static const std::size_t spectralSizes[] = {1, 2, 3, 7, 8, 16, 31, 33};
+
+template <typename T>
+static void checkProducts(T tolerance)
+{
+    using C = std::complex<T>;
+    for (std::size_t size : spectralSizes) {
+        const auto a = reference::randomSequence<T>(size, 3);
+        const auto b = reference::randomSequence<T>(size, 5);
+        const auto start = reference::randomSequence<T>(size, 7);
+        std::vector<C> product(size);
+        std::vector<C> conjugate(size);
+        std::vector<C> accumulated = start;
+        std::vector<C> conjugateAccumulated = start;
+        REQUIRE(splitradixfft::multiplySpectra<T>(a.data(), b.data(),
+                                                  product.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::multiplyConjugateSpectra<T>(
+                    a.data(), b.data(), conjugate.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::multiplyAccumulateSpectra<T>(
+                    a.data(), b.data(), accumulated.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::multiplyConjugateAccumulateSpectra<T>(
+                    a.data(), b.data(), conjugateAccumulated.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        for (std::size_t i = 0; i < size; i++) {
+            REQUIRE(std::abs(product[i] - a[i] * b[i]) < tolerance);
+            REQUIRE(std::abs(conjugate[i] - std::conj(a[i]) * b[i]) <
+                    tolerance);
+            REQUIRE(std::abs(accumulated[i] - (start[i] + a[i] * b[i])) <
+                    tolerance);
+            REQUIRE(std::abs(conjugateAccumulated[i] -
+                             (start[i] + std::conj(a[i]) * b[i])) <
+                    tolerance);
+        }
+
+        // In place.
+        std::vector<C> inPlace = a;
+        REQUIRE(splitradixfft::multiplySpectra<T>(
+                    inPlace.data(), b.data(), inPlace.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(inPlace == product);
+        inPlace = b;
+        REQUIRE(splitradixfft::multiplyConjugateSpectra<T>(
+                    a.data(), inPlace.data(), inPlace.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(inPlace == conjugate);
+    }
+}
+
+TEST_CASE("SpectralDouble::Products", "[spectral]")
+{
+    checkProducts<double>(1e-15);
+}
+
+TEST_CASE("SpectralFloat::Products", "[spectral]")
+{
+    checkProducts<float>(1e-6f);
+}
+
+template <typename T>
+static void checkRealOutputs(T tolerance)
+{
+    for (std::size_t size : spectralSizes) {
+        auto in = reference::randomSequence<T>(size, 11);
+        if (size > 2) {
+            in[2] = std::complex<T>(0, 0);
+        }
+        std::vector<T> magnitude(size);
+        std::vector<T> power(size);
+        std::vector<T> decibels(size);
+        std::vector<T> phase(size);
+        REQUIRE(splitradixfft::spectrumMagnitude<T>(in.data(),
+                                                    magnitude.data(), size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::spectrumPower<T>(in.data(), power.data(),
+                                                size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::spectrumDecibels<T>(in.data(), decibels.data(),
+                                                   size) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::spectrumPhase<T>(in.data(), phase.data(),
+                                                size) ==
+                splitradixfft::FFTSTATUS::OK);
+        for (std::size_t i = 0; i < size; i++) {
+            REQUIRE(std::fabs(magnitude[i] - std::abs(in[i])) < tolerance);
+            REQUIRE(std::fabs(power[i] - std::norm(in[i])) < tolerance);
+            REQUIRE(std::fabs(phase[i] - std::arg(in[i])) < tolerance);
+            if (in[i] == std::complex<T>(0, 0)) {
+                REQUIRE(std::isinf(decibels[i]));
+                REQUIRE(decibels[i] < T(0));
+            } else {
+                const T expected = T(10) * std::log10(std::norm(in[i]));
+                REQUIRE(std::fabs(decibels[i] - expected) <
+                        T(1000) * tolerance);
+            }
+        }
+    }
+}
+
+TEST_CASE("SpectralDouble::MagnitudePowerPhase", "[spectral]")
+{
+    checkRealOutputs<double>(1e-15);
+}
+
+TEST_CASE("SpectralFloat::MagnitudePowerPhase", "[spectral]")
+{
+    checkRealOutputs<float>(1e-6f);
+}
+
+TEST_CASE("SpectralDouble::DcAndNyquistBins", "[spectral]")
+{
+    // Half-spectrum of a real sequence: the first and last bins are real.
+    using C = std::complex<double>;
+    const std::size_t nfft = 32;
+    const std::size_t bins = nfft / 2 + 1;
+    std::vector<double> x(nfft);
+    for (std::size_t n = 0; n < nfft; n++) {
+        // Negative mean and alternating part, DC and Nyquist are negative.
+        x[n] = -1.0 - (n % 2 == 0 ? 0.5 : -0.5) * 0.25 +
+               0.1 * std::sin(0.3 * (double)n);
+    }
+    std::vector<C> twiddles(nfft);
+    splitradixfft::populateRfftTwiddleFactorsForward<double>(
+        nfft, twiddles.data(), nfft);
+    std::vector<C> spectrum(bins);
+    splitradixfft::performRfftForward<double>(nfft, twiddles.data(), nfft,
+                                              x.data(), nfft, spectrum.data(),
+                                              bins);
+    REQUIRE(spectrum[0].imag() == 0.0);
+    REQUIRE(spectrum[bins - 1].imag() == 0.0);
+
+    std::vector<C> product(bins);
+    std::vector<C> conjugate(bins);
+    std::vector<C> accumulated(bins);
+    splitradixfft::multiplySpectra<double>(spectrum.data(), spectrum.data(),
+                                           product.data(), bins);
+    splitradixfft::multiplyConjugateSpectra<double>(
+        spectrum.data(), spectrum.data(), conjugate.data(), bins);
+    splitradixfft::multiplyConjugateAccumulateSpectra<double>(
+        spectrum.data(), spectrum.data(), accumulated.data(), bins);
+    for (std::size_t k : {(std::size_t)0, bins - 1}) {
+        REQUIRE(product[k].imag() == 0.0);
+        REQUIRE(conjugate[k].imag() == 0.0);
+        REQUIRE(accumulated[k].imag() == 0.0);
+        REQUIRE(product[k].real() == spectrum[k].real() * spectrum[k].real());
+    }
+
+    // A negative real bin has a phase of pi, also with a negative zero
+    // imaginary part.
+    std::vector<C> real = {C(-2.0, 0.0), C(-2.0, -0.0), C(3.0, -0.0)};
+    std::vector<double> phase(real.size());
+    splitradixfft::spectrumPhase<double>(real.data(), phase.data(),
+                                         real.size());
+    const double pi = std::acos(-1.0);
+    REQUIRE(phase[0] == pi);
+    REQUIRE(phase[1] == pi);
+    REQUIRE(phase[2] == 0.0);
+    std::vector<double> dcPhase(bins);
+    splitradixfft::spectrumPhase<double>(spectrum.data(), dcPhase.data(),
+                                         bins);
+    REQUIRE(dcPhase[0] == pi);
+    REQUIRE(dcPhase[bins - 1] == pi);
+}
+
+TEST_CASE("Spectral::NullPointers", "[spectral]")
+{
+    using C = std::complex<double>;
+    std::vector<C> a(4);
+    std::vector<double> out(4);
+    REQUIRE(splitradixfft::multiplySpectra<double>(a.data(), nullptr,
+                                                   a.data(), 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::multiplyConjugateSpectra<double>(
+                nullptr, a.data(), a.data(), 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::multiplyAccumulateSpectra<double>(
+                a.data(), a.data(), nullptr, 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::multiplyConjugateAccumulateSpectra<double>(
+                a.data(), a.data(), nullptr, 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::spectrumMagnitude<double>(nullptr, out.data(), 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::spectrumPower<double>(a.data(), nullptr, 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::spectrumDecibels<double>(nullptr, out.data(), 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(splitradixfft::spectrumPhase<double>(a.data(), nullptr, 4) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+}
@@ -0,0 +1,129 @@
+#include "reference.hpp"
+#include "splitradixfft_stft.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+template <typename T>
+static void checkRoundTrip(std::size_t fftSize, std::size_t hopSize,
+                           const T* window, std::size_t chunk, T tolerance)
+{
+    const auto input = reference::randomReal<T>(3000, 5);
+    splitradixfft::Stft<T> stft;
+    REQUIRE(splitradixfft::createStft<T>(fftSize, hopSize, window, stft) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(stft.binCount() == fftSize / 2 + 1);
+
+    // In place, in chunks that do not line up with the hops.
+    std::vector<T> output = input;
+    std::size_t frames = 0;
+    for (std::size_t begin = 0; begin < output.size(); begin += chunk) {
+        const std::size_t count = std::min(chunk, output.size() - begin);
+        stft.process(output.data() + begin, output.data() + begin, count,
+                     [&frames](std::complex<T>*) { frames++; });
+    }
+    REQUIRE(frames == output.size() / hopSize);
+
+    const std::size_t latency = stft.latency();
+    for (std::size_t n = 0; n < output.size(); n++) {
+        const T expected = n < latency ? T(0) : input[n - latency];
+        REQUIRE(std::fabs(output[n] - expected) < tolerance);
+    }
+}
+
+TEST_CASE("StftDouble::RoundTrip", "[stft]")
+{
+    checkRoundTrip<double>(64, 16, nullptr, 1, 1e-12);
+    checkRoundTrip<double>(64, 32, nullptr, 100, 1e-12);
+    checkRoundTrip<double>(256, 64, nullptr, 77, 1e-12);
+    // Hops that do not divide the frame.
+    checkRoundTrip<double>(64, 24, nullptr, 13, 1e-12);
+    checkRoundTrip<double>(1024, 300, nullptr, 512, 1e-12);
+
+    const std::vector<double> rectangular(128, 1.0);
+    checkRoundTrip<double>(128, 128, rectangular.data(), 50, 1e-12);
+    checkRoundTrip<double>(128, 40, rectangular.data(), 50, 1e-12);
+}
+
+TEST_CASE("StftFloat::RoundTrip", "[stft]")
+{
+    checkRoundTrip<float>(64, 16, nullptr, 1, 1e-5f);
+    checkRoundTrip<float>(512, 128, nullptr, 200, 1e-5f);
+    checkRoundTrip<float>(64, 24, nullptr, 13, 1e-5f);
+}
+
+TEST_CASE("StftDouble::FramesMatchWindowedTransforms", "[stft]")
+{
+    using C = std::complex<double>;
+    const std::size_t fftSize = 128;
+    const std::size_t hopSize = 48;
+    const auto input = reference::randomReal<double>(1000, 9);
+    const auto window = reference::randomReal<double>(fftSize, 11);
+    splitradixfft::Stft<double> stft;
+    REQUIRE(splitradixfft::createStft<double>(fftSize, hopSize, window.data(),
+                                              stft) ==
+            splitradixfft::FFTSTATUS::OK);
+
+    std::vector<C> twiddles(fftSize);
+    splitradixfft::populateRfftTwiddleFactorsForward<double>(
+        fftSize, twiddles.data(), fftSize);
+    std::size_t frames = 0;
+    stft.analyze(input.data(), input.size(), [&](C* spectrum) {
+        // Frame k ends with input[(k + 1) * hopSize - 1], values before the
+        // first input are zero.
+        const std::size_t end = (frames + 1) * hopSize;
+        std::vector<double> frame(fftSize);
+        for (std::size_t n = 0; n < fftSize; n++) {
+            const std::size_t index = end + n;
+            frame[n] = index < fftSize ? 0.0
+                                       : window[n] * input[index - fftSize];
+        }
+        std::vector<C> expected(fftSize / 2 + 1);
+        splitradixfft::performRfftForward<double>(
+            fftSize, twiddles.data(), fftSize, frame.data(), fftSize,
+            expected.data(), fftSize / 2 + 1);
+        for (std::size_t k = 0; k < fftSize / 2 + 1; k++) {
+            REQUIRE(std::abs(spectrum[k] - expected[k]) < 1e-12);
+        }
+        frames++;
+    });
+    REQUIRE(frames == input.size() / hopSize);
+}
+
+TEST_CASE("StftDouble::ResetClearsHistory", "[stft]")
+{
+    const auto input = reference::randomReal<double>(500, 13);
+    splitradixfft::Stft<double> stft;
+    REQUIRE(splitradixfft::createStft<double>(64, 16, stft) ==
+            splitradixfft::FFTSTATUS::OK);
+    auto noChange = [](std::complex<double>*) {};
+    std::vector<double> first(input.size());
+    std::vector<double> second(input.size());
+    stft.process(input.data(), first.data(), input.size(), noChange);
+    stft.reset();
+    stft.process(input.data(), second.data(), input.size(), noChange);
+    for (std::size_t n = 0; n < input.size(); n++) {
+        REQUIRE(first[n] == second[n]);
+    }
+}
+
+TEST_CASE("Stft::InvalidArguments", "[stft]")
+{
+    splitradixfft::Stft<double> stft;
+    REQUIRE(splitradixfft::createStft<double>(48, 12, stft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createStft<double>(4, 2, stft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createStft<double>(64, 0, stft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createStft<double>(64, 65, stft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    // The periodic Hann window is zero at n = 0, with a hop of the frame size
+    // that value is never covered.
+    REQUIRE(splitradixfft::createStft<double>(64, 64, stft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    std::vector<double> gapped(64, 1.0);
+    gapped[5] = 0.0;
+    REQUIRE(splitradixfft::createStft<double>(64, 64, gapped.data(), stft) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+}
@@ -0,0 +1,267 @@
+#include "reference.hpp"
+#include "splitradixfft_plan.hpp"
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+#include <vector>
+
+TEST_CASE("ThreadPool::RunsEveryTask", "[threads]")
+{
+    for (std::size_t threads : {1, 2, 4, 9}) {
+        splitradixfft::ThreadPool pool(threads);
+        REQUIRE(pool.size() == threads);
+
+        // Nested groups, the waiting threads have to help with the inner
+        // tasks for this to finish.
+        std::vector<std::atomic<int>> counts(64);
+        {
+            splitradixfft::TaskGroup outer(pool);
+            for (std::size_t i = 0; i < 8; i++) {
+                outer.run([&pool, &counts, i]() {
+                    splitradixfft::TaskGroup inner(pool);
+                    for (std::size_t j = 0; j < 8; j++) {
+                        inner.run([&counts, i, j]() { counts[i * 8 + j]++; });
+                    }
+                    inner.wait();
+                });
+            }
+            outer.wait();
+        }
+        for (const auto& count : counts) {
+            REQUIRE(count.load() == 1);
+        }
+    }
+}
+
+TEST_CASE("ThreadPool::DefaultSize", "[threads]")
+{
+    splitradixfft::ThreadPool pool;
+    REQUIRE(pool.size() >= 1);
+}
+
+template <typename T>
+static void checkComplex(splitradixfft::Direction direction)
+{
+    splitradixfft::ThreadPool pool(4);
+    for (std::size_t nfft = 1; nfft <= ((std::size_t)1 << 16); nfft *= 2) {
+        splitradixfft::Plan<T> plan;
+        REQUIRE(splitradixfft::createPlan<T>(
+                    nfft, splitradixfft::TransformType::COMPLEX, direction,
+                    plan) == splitradixfft::FFTSTATUS::OK);
+        auto in = reference::randomSequence<T>(nfft);
+        std::vector<std::complex<T>> serial(nfft);
+        plan.execute(in.data(), serial.data());
+        // The smallest cutoff splits every node that has a combine step.
+        for (std::size_t cutoff : {(std::size_t)1, (std::size_t)256,
+                                   splitradixfft::internal::
+                                       parallelSerialCutoff}) {
+            std::vector<std::complex<T>> parallel(nfft);
+            plan.execute(in.data(), parallel.data(), pool, cutoff);
+            REQUIRE(parallel == serial);
+        }
+    }
+}
+
+TEST_CASE("PlanExecuteParallelFloat::MatchesSerial", "[threads]")
+{
+    checkComplex<float>(splitradixfft::Direction::FORWARD);
+    checkComplex<float>(splitradixfft::Direction::BACKWARD);
+}
+
+TEST_CASE("PlanExecuteParallelDouble::MatchesSerial", "[threads]")
+{
+    checkComplex<double>(splitradixfft::Direction::FORWARD);
+    checkComplex<double>(splitradixfft::Direction::BACKWARD);
+}
+
+TEST_CASE("PlanExecuteParallelDouble::Real", "[threads]")
+{
+    using C = std::complex<double>;
+    splitradixfft::ThreadPool pool(3);
+    for (std::size_t nfft = 8; nfft <= 8192; nfft *= 4) {
+        splitradixfft::Plan<double> forward;
+        splitradixfft::Plan<double> backward;
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::FORWARD,
+                    forward) == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(splitradixfft::createPlan<double>(
+                    nfft, splitradixfft::TransformType::REAL,
+                    splitradixfft::Direction::BACKWARD,
+                    backward) == splitradixfft::FFTSTATUS::OK);
+        auto values = reference::randomSequence<double>(nfft / 2);
+        std::vector<double> in(nfft);
+        for (std::size_t i = 0; i < nfft / 2; i++) {
+            in[2 * i] = values[i].real();
+            in[2 * i + 1] = values[i].imag();
+        }
+
+        std::vector<C> scratch(nfft);
+        std::vector<C> serial(nfft / 2 + 1);
+        std::vector<C> parallel(nfft / 2 + 1);
+        forward.execute(in.data(), serial.data(), scratch.data());
+        forward.execute(in.data(), parallel.data(), scratch.data(), pool, 1);
+        REQUIRE(parallel == serial);
+
+        std::vector<double> serialOut(nfft);
+        std::vector<double> parallelOut(nfft);
+        backward.execute(serial.data(), serialOut.data(), scratch.data());
+        backward.execute(serial.data(), parallelOut.data(), scratch.data(),
+                         pool, 1);
+        REQUIRE(parallelOut == serialOut);
+    }
+}
+
+TEST_CASE("BatchExecutorFloat::MatchesSerialBatch", "[threads]")
+{
+    using C = std::complex<float>;
+    const std::size_t howMany = 37;
+    for (std::size_t threads : {1, 4}) {
+        splitradixfft::ThreadPool pool(threads);
+        splitradixfft::BatchExecutor<float> executor(pool);
+        for (std::size_t nfft = 8; nfft <= 4096; nfft *= 8) {
+            std::vector<C> cfftTwiddles(nfft);
+            std::vector<C> rfftTwiddles(nfft);
+            splitradixfft::populateCfftTwiddleFactorsForward<float>(
+                nfft, cfftTwiddles.data(), nfft);
+            splitradixfft::populateRfftTwiddleFactorsForward<float>(
+                nfft, rfftTwiddles.data(), nfft);
+            // Contiguous rows and interleaved channels.
+            for (bool channels : {false, true}) {
+                const std::size_t stride = channels ? howMany : 1;
+                const std::size_t distance = channels ? 1 : nfft;
+                auto in = reference::randomSequence<float>(nfft * howMany);
+                std::vector<C> scratch(nfft);
+                std::vector<C> serial(nfft * howMany);
+                std::vector<C> parallel(nfft * howMany);
+                REQUIRE(splitradixfft::performCfftForwardBatch<float>(
+                            nfft, cfftTwiddles.data(), nfft, howMany,
+                            in.data(), stride, distance, serial.data(),
+                            stride, distance, scratch.data(),
+                            nfft) == splitradixfft::FFTSTATUS::OK);
+                REQUIRE(executor.cfftForward(nfft, cfftTwiddles.data(), nfft,
+                                             howMany, in.data(), stride,
+                                             distance, parallel.data(), stride,
+                                             distance) ==
+                        splitradixfft::FFTSTATUS::OK);
+                REQUIRE(parallel == serial);
+
+                // Real rows, the spectra are stored with the same layout.
+                std::vector<float> real(nfft * howMany);
+                for (std::size_t i = 0; i < real.size(); i++) {
+                    real[i] = in[i].real();
+                }
+                const std::size_t bins = nfft / 2 + 1;
+                const std::size_t binDistance = channels ? 1 : bins;
+                std::vector<C> spectrumScratch(bins);
+                std::vector<C> serialSpectra(bins * howMany);
+                std::vector<C> parallelSpectra(bins * howMany);
+                REQUIRE(splitradixfft::performRfftForwardBatch<float>(
+                            nfft, rfftTwiddles.data(), nfft, howMany,
+                            real.data(), stride, distance,
+                            serialSpectra.data(), stride, binDistance,
+                            spectrumScratch.data(),
+                            bins) == splitradixfft::FFTSTATUS::OK);
+                REQUIRE(executor.rfftForward(
+                            nfft, rfftTwiddles.data(), nfft, howMany,
+                            real.data(), stride, distance,
+                            parallelSpectra.data(), stride, binDistance) ==
+                        splitradixfft::FFTSTATUS::OK);
+                REQUIRE(parallelSpectra == serialSpectra);
+            }
+        }
+    }
+}
+
+TEST_CASE("BatchExecutorDouble::Backward", "[threads]")
+{
+    using C = std::complex<double>;
+    const std::size_t nfft = 256;
+    const std::size_t howMany = 50;
+    splitradixfft::ThreadPool pool(3);
+    splitradixfft::BatchExecutor<double> executor(pool);
+    std::vector<C> cfftTwiddles(nfft);
+    std::vector<C> rfftTwiddles(nfft);
+    splitradixfft::populateCfftTwiddleFactorsBackward<double>(
+        nfft, cfftTwiddles.data(), nfft);
+    splitradixfft::populateRfftTwiddleFactorsBackward<double>(
+        nfft, rfftTwiddles.data(), nfft);
+    auto in = reference::randomSequence<double>(nfft * howMany);
+
+    std::vector<C> scratch(nfft);
+    std::vector<C> serial(nfft * howMany);
+    std::vector<C> parallel(nfft * howMany);
+    REQUIRE(splitradixfft::performCfftBackwardBatch<double>(
+                nfft, cfftTwiddles.data(), nfft, howMany, in.data(), 1, nfft,
+                serial.data(), 1, nfft, scratch.data(),
+                nfft) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(executor.cfftBackward(nfft, cfftTwiddles.data(), nfft, howMany,
+                                  in.data(), 1, nfft, parallel.data(), 1,
+                                  nfft) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(parallel == serial);
+
+    const std::size_t bins = nfft / 2 + 1;
+    std::vector<C> scratch0(bins);
+    std::vector<C> scratch1(bins);
+    std::vector<double> serialReal(nfft * howMany);
+    std::vector<double> parallelReal(nfft * howMany);
+    REQUIRE(splitradixfft::performRfftBackwardBatch<double>(
+                nfft, rfftTwiddles.data(), nfft, howMany, in.data(), 1, bins,
+                serialReal.data(), 1, nfft, scratch0.data(), scratch1.data(),
+                bins) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(executor.rfftBackward(nfft, rfftTwiddles.data(), nfft, howMany,
+                                  in.data(), 1, bins, parallelReal.data(), 1,
+                                  nfft) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(parallelReal == serialReal);
+}
+
+TEST_CASE("BatchExecutorDouble::Callback", "[threads]")
+{
+    using C = std::complex<double>;
+    const std::size_t nfft = 1024;
+    const std::size_t howMany = 64;
+    std::vector<C> twiddles(nfft);
+    splitradixfft::populateCfftTwiddleFactorsForward<double>(
+        nfft, twiddles.data(), nfft);
+    auto in = reference::randomSequence<double>(nfft * howMany);
+    std::vector<C> serial(nfft * howMany);
+    splitradixfft::ThreadPool serialPool(1);
+    splitradixfft::BatchExecutor<double>(serialPool)
+        .cfftForward(nfft, twiddles.data(), nfft, howMany, in.data(), 1, nfft,
+                     serial.data(), 1, nfft);
+
+    for (std::size_t threads : {1, 4}) {
+        splitradixfft::ThreadPool pool(threads);
+        splitradixfft::BatchExecutor<double> executor(pool);
+        std::vector<C> out(nfft * howMany);
+        std::atomic<int> calls{0};
+        std::atomic<splitradixfft::FFTSTATUS> result{
+            splitradixfft::FFTSTATUS::NULL_POINTER};
+        REQUIRE(executor.cfftForward(
+                    nfft, twiddles.data(), nfft, howMany, in.data(), 1, nfft,
+                    out.data(), 1, nfft,
+                    [&calls, &result](splitradixfft::FFTSTATUS status) {
+                        result.store(status);
+                        calls++;
+                    }) == splitradixfft::FFTSTATUS::OK);
+        while (calls.load() == 0) {
+            std::this_thread::yield();
+        }
+        REQUIRE(calls.load() == 1);
+        REQUIRE(result.load() == splitradixfft::FFTSTATUS::OK);
+        REQUIRE(out == serial);
+
+        // Invalid arguments are reported without calling back.
+        REQUIRE(executor.cfftForward(nfft, twiddles.data(), nfft - 1, howMany,
+                                     in.data(), 1, nfft, out.data(), 1, nfft,
+                                     [&calls](splitradixfft::FFTSTATUS) {
+                                         calls++;
+                                     }) ==
+                splitradixfft::FFTSTATUS::INVALID_SIZE);
+        REQUIRE(executor.cfftForward(nfft, twiddles.data(), nfft, howMany,
+                                     nullptr, 1, nfft, out.data(), 1,
+                                     nfft) ==
+                splitradixfft::FFTSTATUS::NULL_POINTER);
+        REQUIRE(calls.load() == 1);
+    }
+}
@@ -1,5 +1,7 @@
 #include "splitradixfft.hpp"
+#include <algorithm>
 #include <catch2/catch_test_macros.hpp>
+#include <cmath>
 #include <memory>
 
 TEST_CASE("populateCfftTwiddleFactorsForwardFloat::Valid", "[twiddles]")
@@ -113,3 +115,103 @@ TEST_CASE("populateRfftTwiddleFactorsForwardDouble::ErrorOnNull", "[twiddles]")
     auto err = splitradixfft::populateRfftTwiddleFactorsForward<double>(nfft, twiddleFactors, nfft); 
     REQUIRE(err == splitradixfft::FFTSTATUS::NULL_POINTER);
 }
+
+TEST_CASE("populateLevelTwiddlesDouble::MatchStridedTable", "[twiddles]")
+{
+    for (std::size_t nfft = 64; nfft <= 4096; nfft *= 2) {
+        auto table = std::make_unique<std::complex<double>[]>(nfft);
+        splitradixfft::internal::populateCfftTwiddles<double>(table.get(),
+                                                              nfft, false);
+        auto levels = std::make_unique<std::complex<double>[]>(
+            splitradixfft::internal::levelTwiddleCount(nfft));
+        splitradixfft::internal::populateLevelTwiddles<double>(
+            levels.get(), nfft, false);
+        for (std::size_t N = 64; N <= nfft; N *= 2) {
+            const std::size_t offset =
+                splitradixfft::internal::levelTwiddleOffset(N);
+            REQUIRE(offset + N / 4 <=
+                    splitradixfft::internal::levelTwiddleCount(nfft));
+            for (std::size_t i = 0; i < N / 4; i++) {
+                REQUIRE(levels[offset + i] == table[i * (nfft / N)]);
+            }
+        }
+    }
+}
+
+TEST_CASE("levelTwiddleCount::BelowHalfSize", "[twiddles]")
+{
+    REQUIRE(splitradixfft::internal::levelTwiddleCount(32) == 0);
+    REQUIRE(splitradixfft::internal::levelTwiddleCount(64) == 16);
+    REQUIRE(splitradixfft::internal::levelTwiddleCount(128) == 48);
+    REQUIRE(splitradixfft::internal::levelTwiddleCount(1 << 20) <
+            (1 << 19));
+}
+
+template <typename T>
+static T maxUnitRootError(const std::complex<T>* table, std::size_t nfft,
+                          std::size_t first, std::size_t step,
+                          std::size_t count, bool inverseTransform)
+{
+    using L = long double;
+    const L pi{std::acos((L)-1)};
+    const L sign{inverseTransform ? (L)1 : (L)-1};
+    T err{0};
+    for (std::size_t i = 0; i < count; i++) {
+        const std::size_t k{(first + i * step) % nfft};
+        const L angle{sign * (L)2 * pi * (L)k / (L)nfft};
+        err = std::max(err, (T)std::abs(std::complex<L>(table[i].real(),
+                                                        table[i].imag()) -
+                                        std::complex<L>(std::cos(angle),
+                                                        std::sin(angle))));
+    }
+    return err;
+}
+
+template <typename T>
+static void requireAccurateTwiddles(std::size_t nfft, T tolerance)
+{
+    auto table = std::make_unique<std::complex<T>[]>(nfft);
+    splitradixfft::internal::populateCfftTwiddles<T>(table.get(), nfft, false);
+    REQUIRE(maxUnitRootError<T>(table.get(), nfft, 0, 1, nfft, false) <=
+            tolerance);
+    splitradixfft::internal::populateCfftTwiddles<T>(table.get(), nfft, true);
+    REQUIRE(maxUnitRootError<T>(table.get(), nfft, 0, 1, nfft, true) <=
+            tolerance);
+    if (nfft >= 2) {
+        splitradixfft::internal::populateRfftTwiddles<T>(table.get(), nfft,
+                                                         false);
+        REQUIRE(maxUnitRootError<T>(table.get(), nfft, 0, 2, nfft / 2,
+                                    false) <= tolerance);
+        REQUIRE(maxUnitRootError<T>(table.get() + nfft / 2, nfft, 1, 2,
+                                    nfft / 2, false) <= tolerance);
+    }
+}
+
+TEST_CASE("populateTwiddlesFloat::Accurate", "[twiddles]")
+{
+    // Within one rounding of the exact values, std::exp with a float angle
+    // was off by up to 4e-7 (7e-16 in double).
+    for (std::size_t nfft = 1; nfft <= (1 << 22); nfft *= 2) {
+        requireAccurateTwiddles<float>(nfft, 1.2e-7f);
+    }
+}
+
+TEST_CASE("populateTwiddlesDouble::Accurate", "[twiddles]")
+{
+    for (std::size_t nfft = 1; nfft <= (1 << 22); nfft *= 2) {
+        requireAccurateTwiddles<double>(nfft, 2.3e-16);
+    }
+}
+
+TEST_CASE("populateTwiddles::Symmetric", "[twiddles]")
+{
+    // The octant symmetry makes w^k and w^(N/4 - k) exact mirror images.
+    const std::size_t nfft = 1 << 12;
+    auto table = std::make_unique<std::complex<double>[]>(nfft);
+    splitradixfft::internal::populateCfftTwiddles<double>(table.get(), nfft,
+                                                          false);
+    for (std::size_t k = 1; k <= nfft / 4; k++) {
+        REQUIRE(table[k].real() == -table[nfft / 4 - k].imag());
+        REQUIRE(table[nfft - k] == std::conj(table[k]));
+    }
+}
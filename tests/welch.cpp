@@ -0,0 +1,198 @@
+#include "reference.hpp"
+#include "splitradixfft_welch.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <cmath>
+#include <vector>
+
+// Averaged periodograms with a DFT of every windowed segment, without the
+// one-sided folding and scaling.
+static std::vector<std::complex<long double>>
+referenceCrossSpectrum(const std::vector<double>& x,
+                       const std::vector<double>& y,
+                       const std::vector<double>& window, std::size_t hopSize)
+{
+    const std::size_t nfft = window.size();
+    std::vector<std::complex<long double>> sum(nfft / 2 + 1);
+    std::size_t count = 0;
+    for (std::size_t begin = 0; begin + nfft <= x.size(); begin += hopSize) {
+        std::vector<std::complex<double>> a(nfft);
+        std::vector<std::complex<double>> b(nfft);
+        for (std::size_t n = 0; n < nfft; n++) {
+            a[n] = window[n] * x[begin + n];
+            b[n] = window[n] * y[begin + n];
+        }
+        auto X = reference::dft<double>(a.data(), nfft, false);
+        auto Y = reference::dft<double>(b.data(), nfft, false);
+        for (std::size_t k = 0; k < nfft / 2 + 1; k++) {
+            sum[k] += std::conj(X[k]) * Y[k];
+        }
+        count++;
+    }
+    for (auto& value : sum) {
+        value /= (long double)count;
+    }
+    return sum;
+}
+
+TEST_CASE("WelchDouble::MatchesAveragedPeriodograms", "[welch]")
+{
+    const std::size_t nfft = 64;
+    const double sampleRate = 1000.0;
+    const auto x = reference::randomReal<double>(1000, 3);
+    const auto y = reference::randomReal<double>(1000, 5);
+    const auto window = reference::randomReal<double>(nfft, 7);
+    long double sumOfSquares = 0;
+    for (double w : window) {
+        sumOfSquares += (long double)w * w;
+    }
+
+    for (std::size_t hopSize : {16, 32, 50, 64, 100}) {
+        splitradixfft::WelchEstimator<double> estimator;
+        REQUIRE(splitradixfft::createWelchEstimator<double>(
+                    nfft, hopSize, 2, window.data(), sampleRate,
+                    splitradixfft::SpectralScaling::DENSITY, estimator) ==
+                splitradixfft::FFTSTATUS::OK);
+        std::vector<double> psdX(estimator.binCount());
+        std::vector<double> psdY(estimator.binCount());
+        std::vector<std::complex<double>> cross(estimator.binCount());
+        const double* in[] = {x.data(), y.data()};
+        double* out[] = {psdX.data(), psdY.data()};
+        REQUIRE(estimator.psd(in, x.size(), out) ==
+                splitradixfft::FFTSTATUS::OK);
+        REQUIRE(estimator.csd(x.data(), y.data(), x.size(), cross.data()) ==
+                splitradixfft::FFTSTATUS::OK);
+
+        const auto xx = referenceCrossSpectrum(x, x, window, hopSize);
+        const auto yy = referenceCrossSpectrum(y, y, window, hopSize);
+        const auto xy = referenceCrossSpectrum(x, y, window, hopSize);
+        for (std::size_t k = 0; k < nfft / 2 + 1; k++) {
+            const long double folded = k == 0 || k == nfft / 2 ? 1 : 2;
+            const long double scale = folded / (sampleRate * sumOfSquares);
+            REQUIRE(std::fabs(psdX[k] - (double)(xx[k].real() * scale)) <
+                    1e-12);
+            REQUIRE(std::fabs(psdY[k] - (double)(yy[k].real() * scale)) <
+                    1e-12);
+            const std::complex<double> expected(
+                (double)(xy[k].real() * scale), (double)(xy[k].imag() * scale));
+            REQUIRE(std::abs(cross[k] - expected) < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("WelchFloat::SineAmplitude", "[welch]")
+{
+    // A sine of amplitude 2 at the centre of bin 16 estimates 2² / 2 there
+    // with the spectrum scaling.
+    const std::size_t nfft = 256;
+    const double pi = std::acos(-1.0);
+    std::vector<float> x(4096);
+    for (std::size_t n = 0; n < x.size(); n++) {
+        x[n] = 2.0f * (float)std::sin(2.0 * pi * 16.0 * (double)n /
+                                      (double)nfft);
+    }
+    splitradixfft::WelchEstimator<float> estimator;
+    REQUIRE(splitradixfft::createWelchEstimator<float>(
+                nfft, nfft / 2, 1, nullptr, 1.0f,
+                splitradixfft::SpectralScaling::SPECTRUM, estimator) ==
+            splitradixfft::FFTSTATUS::OK);
+    std::vector<float> psd(estimator.binCount());
+    const float* in[] = {x.data()};
+    float* out[] = {psd.data()};
+    REQUIRE(estimator.psd(in, x.size(), out) == splitradixfft::FFTSTATUS::OK);
+    REQUIRE(std::fabs(psd[16] - 2.0f) < 1e-4f);
+    // The Hann window leaks half of the amplitude into each neighbour.
+    REQUIRE(std::fabs(psd[15] - 0.5f) < 1e-4f);
+    REQUIRE(std::fabs(psd[17] - 0.5f) < 1e-4f);
+    REQUIRE(psd[40] < 1e-8f);
+}
+
+TEST_CASE("WelchDouble::ThreadedMatchesSerial", "[welch]")
+{
+    const std::size_t channels = 3;
+    std::vector<std::vector<double>> data;
+    std::vector<const double*> in;
+    for (std::size_t c = 0; c < channels; c++) {
+        data.push_back(
+            reference::randomReal<double>(20000, 11 + (unsigned int)c));
+        in.push_back(data.back().data());
+    }
+    splitradixfft::WelchEstimator<double> estimator;
+    REQUIRE(splitradixfft::createWelchEstimator<double>(
+                512, 200, channels, nullptr, 48000.0,
+                splitradixfft::SpectralScaling::DENSITY, estimator, 5) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(estimator.accumulators() == 5);
+    REQUIRE(estimator.segments(20000) == 98);
+
+    const std::size_t bins = estimator.binCount();
+    std::vector<double> serial(channels * bins);
+    std::vector<double> threaded(channels * bins);
+    std::vector<double*> serialOut;
+    std::vector<double*> threadedOut;
+    for (std::size_t c = 0; c < channels; c++) {
+        serialOut.push_back(serial.data() + c * bins);
+        threadedOut.push_back(threaded.data() + c * bins);
+    }
+    splitradixfft::ThreadPool pool(4);
+    REQUIRE(estimator.psd(in.data(), 20000, serialOut.data()) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(estimator.psd(in.data(), 20000, threadedOut.data(), pool) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(serial == threaded);
+
+    std::vector<std::complex<double>> crossSerial(bins);
+    std::vector<std::complex<double>> crossThreaded(bins);
+    REQUIRE(estimator.csd(in[0], in[1], 20000, crossSerial.data()) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(estimator.csd(in[0], in[1], 20000, crossThreaded.data(), pool) ==
+            splitradixfft::FFTSTATUS::OK);
+    REQUIRE(crossSerial == crossThreaded);
+
+    // The cross spectrum of a channel with itself is its power spectrum.
+    REQUIRE(estimator.csd(in[2], in[2], 20000, crossSerial.data()) ==
+            splitradixfft::FFTSTATUS::OK);
+    for (std::size_t k = 0; k < bins; k++) {
+        REQUIRE(std::fabs(crossSerial[k].real() - serial[2 * bins + k]) <
+                1e-12 * serial[2 * bins + k] + 1e-300);
+        // Exactly zero unless fused multiply-adds round the two products
+        // differently.
+        REQUIRE(std::fabs(crossSerial[k].imag()) <=
+                1e-12 * serial[2 * bins + k]);
+    }
+}
+
+TEST_CASE("Welch::InvalidArguments", "[welch]")
+{
+    splitradixfft::WelchEstimator<double> estimator;
+    REQUIRE(splitradixfft::createWelchEstimator<double>(48, 24, 1, estimator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createWelchEstimator<double>(4, 2, 1, estimator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createWelchEstimator<double>(64, 0, 1, estimator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createWelchEstimator<double>(64, 32, 0, estimator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    REQUIRE(splitradixfft::createWelchEstimator<double>(
+                64, 32, 1, nullptr, 0.0,
+                splitradixfft::SpectralScaling::DENSITY, estimator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    const std::vector<double> zeros(64, 0.0);
+    REQUIRE(splitradixfft::createWelchEstimator<double>(
+                64, 32, 1, zeros.data(), 1.0,
+                splitradixfft::SpectralScaling::SPECTRUM, estimator) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+
+    REQUIRE(splitradixfft::createWelchEstimator<double>(64, 32, 1, estimator) ==
+            splitradixfft::FFTSTATUS::OK);
+    std::vector<double> x(63);
+    std::vector<double> psd(estimator.binCount());
+    const double* in[] = {x.data()};
+    double* out[] = {psd.data()};
+    REQUIRE(estimator.psd(in, x.size(), out) ==
+            splitradixfft::FFTSTATUS::INVALID_SIZE);
+    const double* missing[] = {nullptr};
+    REQUIRE(estimator.psd(missing, x.size(), out) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+    REQUIRE(estimator.csd(x.data(), nullptr, x.size(), nullptr) ==
+            splitradixfft::FFTSTATUS::NULL_POINTER);
+}
@@ -0,0 +1,449 @@
+/*
+ * generate_codelets.cpp
+ * Emits include/splitradixfft_codelets.hpp, the straight-line leaf codelets of
+ * size 16 and 32 used by transformRecursion.
+ *
+ * The generator runs the conjugate-pair split-radix recursion of the library on
+ * symbolic real-valued expressions. Multiplications by 0, +-1 and the
+ * (1 -+ j)/sqrt(2) twiddles are folded, negations are pushed into the adjacent
+ * additions and identical expressions are shared, which results in the
+ * well-known split-radix operation counts (e.g. 144 additions and 24
+ * multiplications for 16 points).
+ *
+ * Usage: generate_codelets <output header>
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+enum class Op {
+    ZERO,
+    INPUT, // a = input index, b = 0 real / 1 imag
+    CONST, // value
+    ADD,
+    SUB,
+    MUL, // a = constant node, b = operand
+    NEG,
+};
+
+struct Node {
+    Op op;
+    int a;
+    int b;
+    long double value;
+};
+
+class Graph {
+public:
+    Graph() { nodes_.push_back({Op::ZERO, 0, 0, 0}); }
+
+    static constexpr int zero = 0;
+
+    int input(int index, int part)
+    {
+        return intern({Op::INPUT, index, part, 0});
+    }
+
+    int constant(long double value)
+    {
+        // Constants are kept positive, the sign is moved into a negation.
+        return intern({Op::CONST, 0, 0, value});
+    }
+
+    int neg(int x)
+    {
+        if (x == zero) {
+            return zero;
+        }
+        if (nodes_[x].op == Op::NEG) {
+            return nodes_[x].a;
+        }
+        return intern({Op::NEG, x, 0, 0});
+    }
+
+    int add(int x, int y)
+    {
+        if (x == zero) {
+            return y;
+        }
+        if (y == zero) {
+            return x;
+        }
+        bool negX = nodes_[x].op == Op::NEG;
+        bool negY = nodes_[y].op == Op::NEG;
+        if (negX && negY) {
+            return neg(add(nodes_[x].a, nodes_[y].a));
+        }
+        if (negX) {
+            return sub(y, nodes_[x].a);
+        }
+        if (negY) {
+            return sub(x, nodes_[y].a);
+        }
+        if (x > y) {
+            std::swap(x, y);
+        }
+        return intern({Op::ADD, x, y, 0});
+    }
+
+    int sub(int x, int y)
+    {
+        if (y == zero) {
+            return x;
+        }
+        if (x == zero) {
+            return neg(y);
+        }
+        if (x == y) {
+            return zero;
+        }
+        bool negX = nodes_[x].op == Op::NEG;
+        bool negY = nodes_[y].op == Op::NEG;
+        if (negX && negY) {
+            return sub(nodes_[y].a, nodes_[x].a);
+        }
+        if (negX) {
+            return neg(add(nodes_[x].a, y));
+        }
+        if (negY) {
+            return add(x, nodes_[y].a);
+        }
+        // a - b and b - a are shared as one subtraction and a negation.
+        auto it = memo_.find(std::make_tuple(Op::SUB, y, x, 0.0L));
+        if (it != memo_.end()) {
+            return neg(it->second);
+        }
+        return intern({Op::SUB, x, y, 0});
+    }
+
+    int mul(long double c, int x)
+    {
+        if (x == zero || c == 0) {
+            return zero;
+        }
+        if (c < 0) {
+            return neg(mul(-c, x));
+        }
+        if (nodes_[x].op == Op::NEG) {
+            return neg(mul(c, nodes_[x].a));
+        }
+        if (c == 1) {
+            return x;
+        }
+        return intern({Op::MUL, constant(c), x, 0});
+    }
+
+    const Node& operator[](int i) const { return nodes_[i]; }
+
+private:
+    int intern(const Node& node)
+    {
+        auto key = std::make_tuple(node.op, node.a, node.b, node.value);
+        auto it = memo_.find(key);
+        if (it != memo_.end()) {
+            return it->second;
+        }
+        nodes_.push_back(node);
+        int id = (int)nodes_.size() - 1;
+        memo_[key] = id;
+        return id;
+    }
+
+    std::vector<Node> nodes_;
+    std::map<std::tuple<Op, int, int, long double>, int> memo_;
+};
+
+int gcd(int a, int b) { return b == 0 ? a : gcd(b, a % b); }
+
+struct Cplx {
+    int re;
+    int im;
+};
+
+// Twiddle factor exp(-+j 2 pi k / N) as an exact rational angle so the special
+// values are recognized without comparing floating point numbers.
+Cplx twiddleMul(Graph& g, Cplx x, int k, int N, bool backward, bool conjugate)
+{
+    // Reduce to w = exp(j * sign * 2 pi k / N).
+    const long double pi = std::acos((long double)-1);
+    int sign = backward ? 1 : -1;
+    if (conjugate) {
+        sign = -sign;
+    }
+    if (k == 0) {
+        return x;
+    }
+    if (8 * k == N) {
+        // (1 + sign * j) / sqrt(2)
+        long double h = std::sqrt((long double)0.5);
+        if (sign > 0) {
+            return {g.mul(h, g.sub(x.re, x.im)), g.mul(h, g.add(x.re, x.im))};
+        }
+        return {g.mul(h, g.add(x.re, x.im)), g.mul(h, g.sub(x.im, x.re))};
+    }
+    // Evaluate the angle in the first octant so that equal constants of
+    // different k and N are bit-identical and shared by the emitter.
+    int g0 = gcd(k, N);
+    k /= g0;
+    N /= g0;
+    long double c;
+    long double s;
+    if (8 * k < N) {
+        long double angle = 2 * pi * (long double)k / (long double)N;
+        c = std::cos(angle);
+        s = std::sin(angle);
+    } else {
+        long double angle = 2 * pi * (long double)(N - 4 * k) /
+                            (long double)(4 * N);
+        c = std::sin(angle);
+        s = std::cos(angle);
+    }
+    s *= sign;
+    // (xr + j xi)(c + j s)
+    return {g.sub(g.mul(c, x.re), g.mul(s, x.im)),
+            g.add(g.mul(s, x.re), g.mul(c, x.im))};
+}
+
+Cplx rot90(Graph& g, Cplx x, bool backward)
+{
+    // Same convention as rot90<C, F> in the library.
+    return backward ? Cplx{g.neg(x.im), x.re} : Cplx{x.im, g.neg(x.re)};
+}
+
+std::vector<Cplx> splitRadix(Graph& g, const std::vector<Cplx>& x,
+                             bool backward)
+{
+    const int N = (int)x.size();
+    if (N == 1) {
+        return x;
+    }
+    if (N == 2) {
+        return {{g.add(x[0].re, x[1].re), g.add(x[0].im, x[1].im)},
+                {g.sub(x[0].re, x[1].re), g.sub(x[0].im, x[1].im)}};
+    }
+    std::vector<Cplx> even, odd1, odd3;
+    for (int n = 0; n < N / 2; n++) {
+        even.push_back(x[2 * n]);
+    }
+    for (int n = 0; n < N / 4; n++) {
+        odd1.push_back(x[4 * n + 1]);
+        odd3.push_back(x[(4 * n - 1 + N) % N]);
+    }
+    auto u = splitRadix(g, even, backward);
+    auto z1 = splitRadix(g, odd1, backward);
+    auto z3 = splitRadix(g, odd3, backward);
+
+    std::vector<Cplx> out(N);
+    for (int k = 0; k < N / 4; k++) {
+        Cplx a = twiddleMul(g, z1[k], k, N, backward, false);
+        Cplx b = twiddleMul(g, z3[k], k, N, backward, true);
+        Cplx sum{g.add(a.re, b.re), g.add(a.im, b.im)};
+        Cplx diff = rot90(g, {g.sub(a.re, b.re), g.sub(a.im, b.im)}, backward);
+        out[k] = {g.add(u[k].re, sum.re), g.add(u[k].im, sum.im)};
+        out[k + N / 2] = {g.sub(u[k].re, sum.re), g.sub(u[k].im, sum.im)};
+        out[k + N / 4] = {g.add(u[k + N / 4].re, diff.re),
+                          g.add(u[k + N / 4].im, diff.im)};
+        out[k + 3 * N / 4] = {g.sub(u[k + N / 4].re, diff.re),
+                              g.sub(u[k + N / 4].im, diff.im)};
+    }
+    return out;
+}
+
+class Emitter {
+public:
+    explicit Emitter(const Graph& g) : g_(g) {}
+
+    // Emit the statements computing node x, returns the expression naming it.
+    std::string expression(int x)
+    {
+        const Node& node = g_[x];
+        switch (node.op) {
+        case Op::ZERO:
+            return "T(0)";
+        case Op::INPUT:
+            return "x" + std::to_string(node.a) +
+                   (node.b == 0 ? ".real()" : ".imag()");
+        case Op::CONST:
+            return constantName(node.value);
+        case Op::NEG:
+            return "-" + expression(node.a);
+        default:
+            break;
+        }
+        auto it = names_.find(x);
+        if (it != names_.end()) {
+            return it->second;
+        }
+        std::string lhs = expression(node.a);
+        std::string rhs = expression(node.b);
+        std::string op = node.op == Op::ADD ? " + "
+                         : node.op == Op::SUB ? " - "
+                                              : " * ";
+        if (node.op == Op::ADD || node.op == Op::SUB) {
+            additions++;
+        } else {
+            multiplications++;
+        }
+        std::string name = "t" + std::to_string(names_.size());
+        body += "    const T " + name + "{" + lhs + op + rhs + "};\n";
+        names_[x] = name;
+        return name;
+    }
+
+    std::string constantName(long double value)
+    {
+        auto it = constants_.find(value);
+        if (it != constants_.end()) {
+            return it->second;
+        }
+        std::string name = "k" + std::to_string(constants_.size());
+        char literal[64];
+        std::snprintf(literal, sizeof(literal), "%.21Lg", value);
+        constantDeclarations +=
+            "    constexpr T " + name + "{T(" + literal + "L)};\n";
+        constants_[value] = name;
+        return name;
+    }
+
+    std::string body;
+    std::string constantDeclarations;
+    int additions{0};
+    int multiplications{0};
+
+private:
+    const Graph& g_;
+    std::map<int, std::string> names_;
+    std::map<long double, std::string> constants_;
+};
+
+std::string generateCodelet(int N, bool backward, int& additions,
+                            int& multiplications)
+{
+    Graph g;
+    std::vector<Cplx> x(N);
+    for (int n = 0; n < N; n++) {
+        x[n] = {g.input(n, 0), g.input(n, 1)};
+    }
+    auto y = splitRadix(g, x, backward);
+
+    Emitter e(g);
+    std::string stores;
+    for (int k = 0; k < N; k++) {
+        std::string re = e.expression(y[k].re);
+        std::string im = e.expression(y[k].im);
+        stores += "    out[" + std::to_string(k) + "] = C(" + re + ", " + im +
+                  ");\n";
+    }
+    additions = e.additions;
+    multiplications = e.multiplications;
+
+    std::string loads;
+    for (int n = 0; n < N; n++) {
+        loads += "    const C x" + std::to_string(n) + "{load(" +
+                 std::to_string(n) + ")};\n";
+    }
+
+    std::string name = "leaf" + std::to_string(N) +
+                       (backward ? "Backward" : "Forward");
+    std::string text;
+    text += "// " + std::to_string(additions) + " additions, " +
+            std::to_string(multiplications) + " multiplications\n";
+    text += "template <typename T, typename Load>\n";
+    text += "inline void " + name + "(std::complex<T>* out, Load load)\n{\n";
+    text += "    using C = std::complex<T>;\n";
+    text += e.constantDeclarations;
+    text += loads;
+    text += e.body;
+    text += stores;
+    text += "}\n\n";
+    return text;
+}
+
+const char* const fileHeader = R"(/*
+ * MIT License
+ *
+ * Copyright (c) 2023 [Your Name]
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ * ==============================================================================
+ *
+ * splitradixfft_codelets.hpp
+ * Generated by tools/generate_codelets.cpp, do not edit. Regenerate with
+ * cmake --build <build dir> --target codelets
+ *
+ * Straight-line conjugate-pair split-radix leaves. load(k) returns the k-th
+ * input value, all inputs are read before the first output is written.
+ *
+ * ==============================================================================
+ */
+
+)";
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        std::fprintf(stderr, "Usage: %s <output header>\n", argv[0]);
+        return 1;
+    }
+
+    std::string text = fileHeader;
+    text += "#pragma once\n#include <complex>\n\n";
+    text += "namespace splitradixfft {\nnamespace internal {\n\n";
+
+    for (int N : {16, 32}) {
+        for (bool backward : {false, true}) {
+            int additions = 0;
+            int multiplications = 0;
+            text += generateCodelet(N, backward, additions, multiplications);
+            std::printf("leaf%d%s: %d additions, %d multiplications\n", N,
+                        backward ? "Backward" : "Forward", additions,
+                        multiplications);
+        }
+        std::string n = std::to_string(N);
+        text += "template <typename T, bool F, typename Load>\n";
+        text += "inline void leaf" + n + "(std::complex<T>* out, Load load)\n";
+        text += "{\n";
+        text += "    if constexpr (F) {\n";
+        text += "        leaf" + n + "Backward<T>(out, load);\n";
+        text += "    } else {\n";
+        text += "        leaf" + n + "Forward<T>(out, load);\n";
+        text += "    }\n";
+        text += "}\n\n";
+    }
+
+    text += "} // namespace internal\n} // namespace splitradixfft\n";
+
+    std::FILE* file = std::fopen(argv[1], "w");
+    if (file == nullptr) {
+        std::fprintf(stderr, "Cannot open %s\n", argv[1]);
+        return 1;
+    }
+    std::fputs(text.c_str(), file);
+    std::fclose(file);
+    return 0;
+}